@@ -24,6 +24,7 @@
 
 #include "imgui/imgui_impl_glfw.h"
 #include "imgui/imgui_impl_opengl3.h"
+#include "OcctInfiniteGrid.h"
 
 #include <AIS_Shape.hxx>
 #include <AIS_ViewCube.hxx>
@@ -34,8 +35,15 @@
 #include <Message.hxx>
 #include <Message_Messenger.hxx>
 #include <OpenGl_GraphicDriver.hxx>
+#include <OSD_Timer.hxx>
+#include <TDataStd_Name.hxx>
 #include <TopAbs_ShapeEnum.hxx>
+#include <XCAFApp_Application.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
 
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 
 #include <GLFW/glfw3.h>
@@ -118,6 +126,7 @@ void GlfwOcctView::errorCallback(int theError, const char* theDescription)
 // ================================================================
 void GlfwOcctView::run()
 {
+    myShaderCache.Init();
     initWindow(800, 600, "OCCT IMGUI");
     initViewer();
     initDemoScene();
@@ -129,10 +138,47 @@ void GlfwOcctView::run()
     myView->MustBeResized();
     myOcctWindow->Map();
     initGui();
+
+    // the first redraw compiles OCCT programs of the initial shading modes, unless the driver cache has them
+    OSD_Timer aFirstFrameTimer;
+    aFirstFrameTimer.Start();
+    renderView();
+    myShaderCache.SetFirstFrameTime(aFirstFrameTimer.ElapsedTime() * 1000.0);
     mainloop();
     cleanup();
 }
 
+// ================================================================
+// Function : RunThumbnails
+// Purpose  :
+// ================================================================
+bool GlfwOcctView::RunThumbnails(const TCollection_AsciiString& theOutDir, int theSize)
+{
+    myIsHeadless = true;
+    myShaderCache.Init();
+    initWindow(800, 600, "OCCT IMGUI");
+    initViewer();
+    initDemoScene();
+    if (myView.IsNull())
+    {
+        return false;
+    }
+
+    myThumbnails.SetSize(theSize);
+    if (!myThumbnails.Start(theOutDir))
+    {
+        cleanup();
+        return false;
+    }
+    myThumbnails.Finish(glContext());
+
+    char aStats[128];
+    std::snprintf(aStats, sizeof(aStats), "Thumbnails: %.1f per second", myThumbnails.ThumbnailsPerSecond());
+    Message::DefaultMessenger()->Send(aStats, Message_Info);
+    cleanup();
+    return true;
+}
+
 // ================================================================
 // Function : initWindow
 // Purpose  :
@@ -153,6 +199,10 @@ void GlfwOcctView::initWindow(int theWidth, int theHeight, const char* theTitle)
         //glfwWindowHint(GLFW_TRANSPARENT_FRAMEBUFFER, true);
         //glfwWindowHint(GLFW_DECORATED, GL_FALSE);
     }
+    if (myIsHeadless)
+    {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    }
     myOcctWindow = new GlfwOcctWindow(theWidth, theHeight, theTitle);
     glfwSetWindowUserPointer(myOcctWindow->getGlfwWindow(), this);
 
@@ -164,6 +214,15 @@ void GlfwOcctView::initWindow(int theWidth, int theHeight, const char* theTitle)
     glfwSetScrollCallback(myOcctWindow->getGlfwWindow(), GlfwOcctView::onMouseScrollCallback);
     glfwSetMouseButtonCallback(myOcctWindow->getGlfwWindow(), GlfwOcctView::onMouseButtonCallback);
     glfwSetCursorPosCallback(myOcctWindow->getGlfwWindow(), GlfwOcctView::onMouseMoveCallback);
+
+    // animation frames are paced to the display refresh rate
+    if (GLFWmonitor* aMonitor = glfwGetPrimaryMonitor())
+    {
+        if (const GLFWvidmode* aMode = glfwGetVideoMode(aMonitor))
+        {
+            myAnimationClock.SetDisplayRate(aMode->refreshRate);
+        }
+    }
 }
 
 // ================================================================
@@ -186,10 +245,20 @@ void GlfwOcctView::initViewer()
     aViewer->SetDefaultLights();
     aViewer->SetLightOn();
     aViewer->SetDefaultTypeOfView(V3d_PERSPECTIVE);
+    // the viewer grid stays active for snapping, while it is drawn by the shader grid
     aViewer->ActivateGrid(Aspect_GT_Rectangular, Aspect_GDM_Lines);
+    aViewer->Grid()->Erase();
     myView = aViewer->CreateView();
     //myView->SetImmediateUpdate(Standard_False);
-    myView->SetWindow(myOcctWindow, myOcctWindow->NativeGlContext());
+    // the view renders into an offscreen FBO shown by ImGui, its window only follows the viewport image size
+    int aWidth = 0, aHeight = 0;
+    myOcctWindow->Size(aWidth, aHeight);
+    myViewportSize.SetValues(aWidth, aHeight);
+    myViewWindow = new Aspect_NeutralWindow();
+    myViewWindow->SetVirtual(Standard_True);
+    myViewWindow->SetNativeHandle(myOcctWindow->NativeHandle());
+    myViewWindow->SetSize(aWidth, aHeight);
+    myView->SetWindow(myViewWindow, myOcctWindow->NativeGlContext());
     myView->ChangeRenderingParams().ToShowStats = Standard_True;
 
     myContext = new AIS_InteractiveContext(aViewer);
@@ -202,6 +271,29 @@ void GlfwOcctView::initViewer()
     aCube->SetViewAnimation(this->ViewAnimation());
     aCube->SetFixedAnimationLoop(false);
     myContext->Display(aCube, false);
+    myAnimationClock.AddAnimation(ViewAnimation());
+    myAnimationClock.AddAnimation(ObjectsAnimation());
+
+    Handle(OcctInfiniteGrid) aGrid = new OcctInfiniteGrid(aViewer);
+    myContext->Display(aGrid, 0, -1, false);
+
+    myOutliner.Init(myContext, myView);
+    myMeasureTool.Init(myContext, myView);
+    mySectionTool.Init(myContext, myView);
+    myClashDetector.Init(myContext, myView);
+    myAnalysis.Init(myContext, myView);
+    myHlr.Init(myContext, myView);
+    myBatchDisplay.Init(myContext, myView);
+    myNavigation.Init(myView);
+    myQualityProfile.Init(myView);
+    myResolutionScaler.Init(myView);
+    myProgressive.Init(myView);
+    myRefinement.Init(myContext, myView);
+    myResults.Init(myContext, myView);
+    myMotion.Init(myContext, myView);
+    myViewSet.Init(myContext, myView, myOcctWindow->NativeGlContext());
+    myThumbnails.Init(myContext, myView, myOcctWindow->NativeGlContext());
+    myGuiLayer.Init(myContext, myView, myOcctWindow->NativeGlContext());
 }
 
 void GlfwOcctView::initGui()
@@ -211,9 +303,16 @@ void GlfwOcctView::initGui()
 
     ImGuiIO& aIO = ImGui::GetIO();
     aIO.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+    // tighter font atlas for large glyph ranges, uploaded as a single channel texture by the backend
+    aIO.Fonts->Flags |= ImFontAtlasFlags_PackBestFit | ImFontAtlasFlags_NoPowerOfTwoHeight;
 
     ImGui_ImplGlfw_InitForOpenGL(myOcctWindow->getGlfwWindow(), Standard_True);
     ImGui_ImplOpenGL3_Init("#version 330");
+    myShaderCache.InitGui();
+
+    // ImGui is drawn within the OCCT frame, which resets OCCT state caches after it,
+    // so that the backend may skip the backup and restore of GL state (OCCT default VAO is bound at this point)
+    ImGui_ImplOpenGL3_SetSharedContext(true);
 
     // Setup Dear ImGui style.
     //ImGui::StyleColorsClassic();
@@ -228,6 +327,9 @@ void GlfwOcctView::renderGui()
 
     ImGui::NewFrame();
 
+    ImGui::DockSpaceOverViewport();
+    renderViewport();
+
     ImGui::ShowDemoWindow();
 
     // Hello IMGUI.
@@ -239,13 +341,126 @@ void GlfwOcctView::renderGui()
     ImGui::Button("Cancel");
     ImGui::End();
 
+    myOutliner.RenderGui();
+    mySearchIndex.RenderGui(myOutliner);
+    myMeasureTool.RenderGui();
+    mySectionTool.RenderGui(glContext(), myViewFbo);
+    myClashDetector.RenderGui(myOutliner);
+    myAnalysis.RenderGui();
+    myHlr.RenderGui();
+    myBatchDisplay.RenderGui(glContext(), myViewFbo);
+    myAnimationClock.RenderGui();
+    myQualityProfile.RenderGui(myNavigation);
+    myResolutionScaler.RenderGui();
+    myProgressive.RenderGui();
+    myRefinement.RenderGui();
+    myResults.RenderGui();
+    myMotion.RenderGui();
+    myViewSet.RenderGui();
+    myThumbnails.RenderGui(glContext());
+    myGuiProfiler.RenderGui();
+    myShaderCache.RenderGui();
+    myGuiProfiler.RenderStressUi();
+
     ImGui::Render();
 
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    // the window is cleared and the draw data submitted by OCCT within the redraw of the UI view
+    int aFbWidth = 0, aFbHeight = 0;
+    glfwGetFramebufferSize(myOcctWindow->getGlfwWindow(), &aFbWidth, &aFbHeight);
+    myGuiLayer.Redraw(Graphic3d_Vec2i(aFbWidth, aFbHeight));
+    myGuiProfiler.EndFrame();
 
     glfwSwapBuffers(myOcctWindow->getGlfwWindow());
 }
 
+// ================================================================
+// Function : glContext
+// Purpose  :
+// ================================================================
+Handle(OpenGl_Context) GlfwOcctView::glContext() const
+{
+    Handle(OpenGl_GraphicDriver) aDriver = Handle(OpenGl_GraphicDriver)::DownCast(myContext->CurrentViewer()->Driver());
+    return aDriver->GetSharedContext();
+}
+
+// ================================================================
+// Function : toViewPosition
+// Purpose  :
+// ================================================================
+Graphic3d_Vec2i GlfwOcctView::toViewPosition(const Graphic3d_Vec2i& theWinPos) const
+{
+    return Graphic3d_Vec2i(int((float(theWinPos.x()) - myViewportOrigin.x()) * myPixelRatio),
+                           int((float(theWinPos.y()) - myViewportOrigin.y()) * myPixelRatio));
+}
+
+// ================================================================
+// Function : renderView
+// Purpose  :
+// ================================================================
+void GlfwOcctView::renderView()
+{
+    const Handle(OpenGl_Context) aGlCtx = glContext();
+    if (myViewFbo.IsNull())
+    {
+        myViewFbo = new OpenGl_FrameBuffer();
+    }
+    if (myViewFbo->GetVPSizeX() != myViewportSize.x()
+     || myViewFbo->GetVPSizeY() != myViewportSize.y())
+    {
+        myViewFbo->Init(aGlCtx, myViewportSize, GL_RGBA8, GL_DEPTH24_STENCIL8);
+        myViewWindow->SetSize(myViewportSize.x(), myViewportSize.y());
+        myView->MustBeResized();
+        myView->Invalidate();
+    }
+
+    // OCCT blits its final frame into the default FBO, which is redirected to the viewport texture
+    aGlCtx->SetDefaultFrameBuffer(myViewFbo);
+    FlushViewEvents(myContext, myView, Standard_True);
+    aGlCtx->SetDefaultFrameBuffer(Handle(OpenGl_FrameBuffer)());
+    myViewFbo->UnbindBuffer(aGlCtx);
+}
+
+// ================================================================
+// Function : renderViewport
+// Purpose  :
+// ================================================================
+void GlfwOcctView::renderViewport()
+{
+    ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0.0f, 0.0f));
+    ImGui::Begin("Viewport");
+    ImGui::PopStyleVar();
+
+    const ImVec2 aSize(std::max(ImGui::GetContentRegionAvail().x, 1.0f), std::max(ImGui::GetContentRegionAvail().y, 1.0f));
+    const ImVec2 anOrigin = ImGui::GetCursorScreenPos();
+    myPixelRatio = ImGui::GetIO().DisplayFramebufferScale.x;
+    myViewportOrigin.SetValues(anOrigin.x, anOrigin.y);
+    myViewportSize.SetValues(std::max(int(aSize.x * myPixelRatio), 1), std::max(int(aSize.y * myPixelRatio), 1));
+
+    // the invisible button keeps dragging over the image from moving the window
+    ImGui::InvisibleButton("##view", aSize, ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonRight | ImGuiButtonFlags_MouseButtonMiddle);
+    myIsViewportHovered = ImGui::IsItemHovered();
+
+    ImDrawList* aDrawList = ImGui::GetWindowDrawList();
+    if (!myViewFbo.IsNull()
+      && myViewFbo->ColorTexture()->IsValid())
+    {
+        // FBO rows go bottom-up
+        aDrawList->AddImage((ImTextureID)(intptr_t)myViewFbo->ColorTexture()->TextureId(),
+                            anOrigin, ImVec2(anOrigin.x + aSize.x, anOrigin.y + aSize.y),
+                            ImVec2(0.0f, 1.0f), ImVec2(1.0f, 0.0f));
+    }
+    myMeasureTool.RenderOverlay(aDrawList, myViewportOrigin, myPixelRatio);
+
+    // section handles take the mouse over from the view controller
+    mySectionTool.RenderOverlay(aDrawList, myViewportOrigin, myPixelRatio, myIsViewportHovered);
+    myIsViewportHovered = myIsViewportHovered && !mySectionTool.IsHandleActive();
+
+    char aStats[64];
+    std::snprintf(aStats, sizeof(aStats), "3D frames: %d  UI frames: %d", myNbSceneFrames, myNbUiFrames);
+    aDrawList->AddText(ImVec2(anOrigin.x + 8.0f, anOrigin.y + aSize.y - ImGui::GetTextLineHeight() - 8.0f), IM_COL32(255, 255, 255, 200), aStats);
+    ImGui::End();
+}
+
 // ================================================================
 // Function : initDemoScene
 // Purpose  :
@@ -259,13 +474,27 @@ void GlfwOcctView::initDemoScene()
 
     myView->TriedronDisplay(Aspect_TOTP_LEFT_LOWER, Quantity_NOC_GOLD, 0.08, V3d_WIREFRAME);
 
-    gp_Ax2 anAxis;
-    anAxis.SetLocation(gp_Pnt(0.0, 0.0, 0.0));
-    Handle(AIS_Shape) aBox = new AIS_Shape(BRepPrimAPI_MakeBox(anAxis, 50, 50, 50).Shape());
-    myContext->Display(aBox, AIS_Shaded, 0, false);
-    anAxis.SetLocation(gp_Pnt(25.0, 125.0, 0.0));
-    Handle(AIS_Shape) aCone = new AIS_Shape(BRepPrimAPI_MakeCone(anAxis, 25, 0, 50).Shape());
-    myContext->Display(aCone, AIS_Shaded, 0, false);
+    // demo assembly of two parts
+    XCAFApp_Application::GetApplication()->NewDocument("MDTV-XCAF", myDoc);
+    Handle(XCAFDoc_ShapeTool) aShapeTool = XCAFDoc_DocumentTool::ShapeTool(myDoc->Main());
+    const TDF_Label anAssembly = aShapeTool->NewShape();
+    TDataStd_Name::Set(anAssembly, "Demo");
+
+    const TDF_Label aBox = aShapeTool->AddShape(BRepPrimAPI_MakeBox(gp_Ax2(), 50, 50, 50).Shape(), Standard_False);
+    TDataStd_Name::Set(aBox, "Box");
+    aShapeTool->AddComponent(anAssembly, aBox, TopLoc_Location());
+
+    const TDF_Label aCone = aShapeTool->AddShape(BRepPrimAPI_MakeCone(gp_Ax2(), 25, 0, 50).Shape(), Standard_False);
+    TDataStd_Name::Set(aCone, "Cone");
+    gp_Trsf aConeTrsf;
+    aConeTrsf.SetTranslation(gp_Vec(25.0, 125.0, 0.0));
+    aShapeTool->AddComponent(anAssembly, aCone, TopLoc_Location(aConeTrsf));
+    aShapeTool->UpdateAssemblies();
+
+    myOutliner.SetDocument(myDoc);
+    mySearchIndex.Build(myOutliner);
+    myThumbnails.SetAssembly(myOutliner);
+    myMotion.SetAssembly(myOutliner);
 
     TCollection_AsciiString aGlInfo;
     {
@@ -287,10 +516,86 @@ void GlfwOcctView::initDemoScene()
 void GlfwOcctView::handleViewRedraw(const Handle(AIS_InteractiveContext)& theCtx,
                                     const Handle(V3d_View)& theView)
 {
+  // animations are advanced first, so that animated camera counts as navigation
+  myAnimationClock.Update(myResults.IsAnimating() || myMotion.IsPlaying());
+
+  // camera actions are already applied here, so navigation is detected within the same frame
+  const bool isNavigating = myNavigation.Update();
+  myQualityProfile.Update(isNavigating);
+  myResolutionScaler.BeginFrame(isNavigating);
+  myRefinement.Update(isNavigating, myClashDetector.IsRunning() || myHlr.IsRunning());
+  myResults.Update();
+  myMotion.Update();
+
+  // the view is redrawn only when the scene, camera or highlighting changes,
+  // other frames recomposite the cached FBO texture
+  if (isNavigating)
+  {
+    theView->InvalidateImmediate();
+  }
+  const bool isHiliteChanged = theCtx->DetectedOwner() != myLastDetected;
+  if (isHiliteChanged)
+  {
+    myLastDetected = theCtx->DetectedOwner();
+    theView->InvalidateImmediate();
+  }
+  if (theView->IsInvalidated()
+   || theView->IsInvalidatedImmediate()
+   || myToAskNextFrame)
+  {
+    ++myNbSceneFrames;
+  }
+  else
+  {
+    ++myNbUiFrames;
+  }
+
+  // secondary views are redrawn first into their own FBOs, so that the base implementation skips them;
+  // invalidation of the main view without camera movement means that the shared scene has been modified
+  myViewSet.Redraw(glContext(), theView->IsInvalidated() && !isNavigating, isHiliteChanged);
+
+  // accumulation frames are requested through continuous redraw, so that events are polled between them;
+  // animation and playback frames are paced by the animation clock instead
+  myProgressive.Update(isNavigating);
+  SetContinuousRedraw(myProgressive.IsAccumulating());
+
+  // only the redraw of the main view drives the resolution scale
+  myResolutionScaler.BeginRedraw(glContext());
   AIS_ViewController::handleViewRedraw(theCtx, theView);
+  myResolutionScaler.EndRedraw(glContext());
+  myProgressive.Accumulate(glContext());
   myToWaitEvents = !myToAskNextFrame;
 }
 
+// ================================================================
+// Function : handleMoveTo
+// Purpose  :
+// ================================================================
+void GlfwOcctView::handleMoveTo(const Handle(AIS_InteractiveContext)& theCtx,
+                                const Handle(V3d_View)& theView)
+{
+  AIS_ViewController::handleMoveTo(theCtx, theView);
+
+  // measurement feedback reuses detection results instead of picking once more
+  if (myMeasureTool.IsActive()
+   && PressedMouseButtons() == Aspect_VKeyMouse_NONE)
+  {
+    myMeasureTool.UpdateHover();
+  }
+}
+
+// ================================================================
+// Function : OnSelectionChanged
+// Purpose  :
+// ================================================================
+void GlfwOcctView::OnSelectionChanged(const Handle(AIS_InteractiveContext)& theCtx,
+                                      const Handle(V3d_View)& theView)
+{
+    AIS_ViewController::OnSelectionChanged(theCtx, theView);
+    myOutliner.SyncSelection();
+    theView->Invalidate();
+}
+
 // ================================================================
 // Function : mainloop
 // Purpose  :
@@ -301,9 +606,27 @@ void GlfwOcctView::mainloop()
     {
         // glfwPollEvents() for continuous rendering (immediate return if there are no new events)
         // and glfwWaitEvents() for rendering on demand (something actually happened in the viewer)
-        if (myToWaitEvents)
+        if (myToWaitEvents
+        && !myViewSet.IsRedrawPending()
+        && !myGuiProfiler.IsRunning())
         {
-          glfwWaitEvents();
+          // wake up for the next animation frame, or earlier on input
+          if (myAnimationClock.IsAnimating())
+          {
+            glfwWaitEventsTimeout(myAnimationClock.TimeToNextFrame());
+          }
+          // wake up without input to restore full quality after navigation
+          // or to show progress of background jobs
+          else if (myNavigation.IsNavigating()
+                || myResolutionScaler.IsRefreshPending()
+                || myHlr.IsRunning())
+          {
+            glfwWaitEventsTimeout(myNavigation.IdleDelay());
+          }
+          else
+          {
+            glfwWaitEvents();
+          }
         }
         else
         {
@@ -311,9 +634,7 @@ void GlfwOcctView::mainloop()
         }
         if (!myView.IsNull())
         {
-            myView->InvalidateImmediate(); // redraw view even if it wasn't modified
-            FlushViewEvents(myContext, myView, Standard_True);
-
+            renderView();
             renderGui();
         }
     }
@@ -325,11 +646,34 @@ void GlfwOcctView::mainloop()
 // ================================================================
 void GlfwOcctView::cleanup()
 {
+    myClashDetector.Cancel();
+    myHlr.Cancel();
+    myRefinement.Cancel();
+    myClashDetector.Wait();
+    myHlr.Wait();
+    myResults.Close();
+
     // Cleanup IMGUI.
-    ImGui_ImplOpenGL3_Shutdown();
-    ImGui_ImplGlfw_Shutdown();
-    ImGui::DestroyContext();
+    if (ImGui::GetCurrentContext() != NULL)
+    {
+        ImGui_ImplOpenGL3_Shutdown();
+        ImGui_ImplGlfw_Shutdown();
+        ImGui::DestroyContext();
+    }
 
+    if (!myDoc.IsNull())
+    {
+        XCAFApp_Application::GetApplication()->Close(myDoc);
+    }
+    myViewSet.Release(glContext());
+    myThumbnails.Release(glContext());
+    myResolutionScaler.Release(glContext());
+    myGuiLayer.Release();
+    if (!myViewFbo.IsNull())
+    {
+        myViewFbo->Release(glContext().get());
+        myViewFbo.Nullify();
+    }
     if (!myView.IsNull())
     {
         myView->Remove();
@@ -352,10 +696,8 @@ void GlfwOcctView::onResize(int theWidth, int theHeight)
         && theHeight != 0
         && !myView.IsNull())
     {
-        myView->Window()->DoResize();
-        myView->MustBeResized();
-        myView->Invalidate();
-        FlushViewEvents(myContext, myView, true);
+        myOcctWindow->DoResize();
+        renderView();
         renderGui();
     }
 }
@@ -366,10 +708,10 @@ void GlfwOcctView::onResize(int theWidth, int theHeight)
 // ================================================================
 void GlfwOcctView::onMouseScroll(double theOffsetX, double theOffsetY)
 {
-    ImGuiIO& aIO = ImGui::GetIO();
-    if (!myView.IsNull() && !aIO.WantCaptureMouse)
+    if (!myView.IsNull() && myIsViewportHovered)
     {
-        UpdateZoom(Aspect_ScrollDelta(myOcctWindow->CursorPosition(), int(theOffsetY * 8.0)));
+        myAnimationClock.Abort(ViewAnimation());
+        UpdateZoom(Aspect_ScrollDelta(toViewPosition(myOcctWindow->CursorPosition()), int(theOffsetY * 8.0)));
     }
 }
 
@@ -379,20 +721,38 @@ void GlfwOcctView::onMouseScroll(double theOffsetX, double theOffsetY)
 // ================================================================
 void GlfwOcctView::onMouseButton(int theButton, int theAction, int theMods)
 {
-    ImGuiIO& aIO = ImGui::GetIO();
-    if (myView.IsNull() || aIO.WantCaptureMouse)
+    if (myView.IsNull())
+    {
+        return;
+    }
+
+    // presses start only over the viewport image, releases are delivered for buttons pressed there
+    const Aspect_VKeyMouse aButton = mouseButtonFromGlfw(theButton);
+    if (theAction == GLFW_PRESS
+      ? !myIsViewportHovered
+      : (PressedMouseButtons() & aButton) == 0)
     {
         return;
     }
 
-    const Graphic3d_Vec2i aPos = myOcctWindow->CursorPosition();
+    const Graphic3d_Vec2i aPos = toViewPosition(myOcctWindow->CursorPosition());
     if (theAction == GLFW_PRESS)
     {
-        PressMouseButton(aPos, mouseButtonFromGlfw(theButton), keyFlagsFromGlfw(theMods), false);
+        myPressPos = aPos;
+        myAnimationClock.Abort(ViewAnimation());
+        PressMouseButton(aPos, aButton, keyFlagsFromGlfw(theMods), false);
     }
     else
     {
-        ReleaseMouseButton(aPos, mouseButtonFromGlfw(theButton), keyFlagsFromGlfw(theMods), false);
+        // a click without dragging is a measurement pick
+        const Graphic3d_Vec2i aDelta = aPos - myPressPos;
+        if (theButton == GLFW_MOUSE_BUTTON_LEFT
+         && myMeasureTool.IsActive()
+         && aDelta.x() * aDelta.x() + aDelta.y() * aDelta.y() <= 4)
+        {
+            myMeasureTool.Pick();
+        }
+        ReleaseMouseButton(aPos, aButton, keyFlagsFromGlfw(theMods), false);
     }
 }
 
@@ -407,14 +767,10 @@ void GlfwOcctView::onMouseMove(int thePosX, int thePosY)
         return;
     }
 
-    ImGuiIO& aIO = ImGui::GetIO();
-    if (aIO.WantCaptureMouse)
-    {
-        //myView->Redraw();
-    }
-    else
+    if (myIsViewportHovered
+     || PressedMouseButtons() != Aspect_VKeyMouse_NONE)
     {
-        const Graphic3d_Vec2i aNewPos(thePosX, thePosY);
+        const Graphic3d_Vec2i aNewPos = toViewPosition(Graphic3d_Vec2i(thePosX, thePosY));
         UpdateMousePosition(aNewPos, PressedMouseButtons(), LastMouseFlags(), Standard_False);
     }
 }
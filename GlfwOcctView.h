@@ -24,9 +24,34 @@
 #define _GlfwOcctView_Header
 
 #include "GlfwOcctWindow.h"
+#include "OcctAnalysisEngine.h"
+#include "OcctAnimationClock.h"
+#include "OcctBatchDisplay.h"
+#include "OcctClashDetector.h"
+#include "OcctGuiProfiler.h"
+#include "OcctHlrExtractor.h"
+#include "OcctImGuiLayer.h"
+#include "OcctMeasureTool.h"
+#include "OcctMotionPlayer.h"
+#include "OcctNavigationTracker.h"
+#include "OcctOutliner.h"
+#include "OcctProgressiveRenderer.h"
+#include "OcctQualityProfile.h"
+#include "OcctRefinementService.h"
+#include "OcctResolutionScaler.h"
+#include "OcctResultViewer.h"
+#include "OcctSearchIndex.h"
+#include "OcctSectionTool.h"
+#include "OcctShaderCache.h"
+#include "OcctThumbnailRenderer.h"
+#include "OcctViewSet.h"
 
 #include <AIS_InteractiveContext.hxx>
 #include <AIS_ViewController.hxx>
+#include <Aspect_NeutralWindow.hxx>
+#include <OpenGl_Context.hxx>
+#include <OpenGl_FrameBuffer.hxx>
+#include <TDocStd_Document.hxx>
 #include <V3d_View.hxx>
 
 //! Sample class creating 3D Viewer within GLFW window.
@@ -42,6 +67,10 @@ public:
     //! Main application entry point.
     void run();
 
+    //! Render thumbnails of the loaded assembly parts into the folder within a hidden window and exit.
+    //! Return FALSE if the viewer cannot be created or the folder cannot be written to.
+    bool RunThumbnails(const TCollection_AsciiString& theOutDir, int theSize);
+
 private:
 
     //! Create GLFW window.
@@ -56,6 +85,18 @@ private:
     //! Render ImGUI.
     void renderGui();
 
+    //! Process view events and redraw the 3D scene into the offscreen FBO if it is dirty.
+    void renderView();
+
+    //! Show the view FBO texture within the dockable viewport window.
+    void renderViewport();
+
+    //! Return OpenGL context of the viewer.
+    Handle(OpenGl_Context) glContext() const;
+
+    //! Convert GLFW window coordinates into view coordinates.
+    Graphic3d_Vec2i toViewPosition(const Graphic3d_Vec2i& theWinPos) const;
+
     //! Fill 3D Viewer with a DEMO items.
     void initDemoScene();
 
@@ -69,6 +110,14 @@ private:
     void handleViewRedraw(const Handle(AIS_InteractiveContext)& theCtx,
                           const Handle(V3d_View)& theView) override;
 
+    //! Handle dynamic highlighting; updates measurement feedback from detection results.
+    void handleMoveTo(const Handle(AIS_InteractiveContext)& theCtx,
+                      const Handle(V3d_View)& theView) override;
+
+    //! Handle selection change.
+    void OnSelectionChanged(const Handle(AIS_InteractiveContext)& theCtx,
+                            const Handle(V3d_View)& theView) override;
+
     //! @name GLWF callbacks
 private:
     //! Window resize event.
@@ -126,8 +175,41 @@ private:
 
     Handle(GlfwOcctWindow) myOcctWindow;
     Handle(V3d_View) myView;
+    Handle(Aspect_NeutralWindow) myViewWindow; //!< view window sized to the viewport image
+    Handle(OpenGl_FrameBuffer) myViewFbo;      //!< offscreen FBO keeping the last rendered 3D frame
     Handle(AIS_InteractiveContext) myContext;
+    Handle(TDocStd_Document) myDoc;
+    OcctOutliner myOutliner;
+    OcctSearchIndex mySearchIndex;
+    OcctMeasureTool myMeasureTool;
+    OcctSectionTool mySectionTool;
+    OcctClashDetector myClashDetector;
+    OcctAnalysisEngine myAnalysis;
+    OcctHlrExtractor myHlr;
+    OcctBatchDisplay myBatchDisplay;
+    OcctNavigationTracker myNavigation;
+    OcctAnimationClock myAnimationClock;
+    OcctQualityProfile myQualityProfile;
+    OcctResolutionScaler myResolutionScaler;
+    OcctProgressiveRenderer myProgressive;
+    OcctRefinementService myRefinement;
+    OcctResultViewer myResults;
+    OcctMotionPlayer myMotion;
+    OcctViewSet myViewSet;
+    OcctThumbnailRenderer myThumbnails;
+    OcctGuiProfiler myGuiProfiler;
+    OcctImGuiLayer myGuiLayer;                 //!< ImGui drawn by OCCT into the window
+    OcctShaderCache myShaderCache;
+    Graphic3d_Vec2i myPressPos;
+    Graphic3d_Vec2 myViewportOrigin;           //!< screen position of the viewport image
+    Graphic3d_Vec2i myViewportSize;            //!< viewport image size in pixels
+    float myPixelRatio = 1.0f;
+    bool myIsViewportHovered = false;
+    Handle(SelectMgr_EntityOwner) myLastDetected;
+    int myNbSceneFrames = 0;                   //!< frames with 3D redraw
+    int myNbUiFrames = 0;                      //!< frames recompositing the cached texture
     bool myToWaitEvents = true;
+    bool myIsHeadless = false;                 //!< hidden window for batch jobs
 
 };
 
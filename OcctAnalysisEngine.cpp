@@ -0,0 +1,665 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctAnalysisEngine.h"
+
+#include "imgui/imgui.h"
+
+#include <AIS_InteractiveObject.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepAdaptor_Surface.hxx>
+#include <BRepLProp_SLProps.hxx>
+#include <Graphic3d_AttribBuffer.hxx>
+#include <OSD_Parallel.hxx>
+#include <OSD_Timer.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Prs3d_ShadingAspect.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+    //! Number of vertices processed by one parallel task.
+    const int THE_CHUNK_SIZE = 16384;
+
+    //! Number of histogram bins.
+    const int THE_NB_BINS = 32;
+
+    const char* THE_MODE_NAMES[OcctAnalysisEngine::AnalysisMode_NB] =
+    {
+        "Mean curvature", "Gaussian curvature", "Draft angle", "Deviation"
+    };
+
+    //! Run theFunctor(theBegin, theEnd) over vertex chunks in parallel.
+    template<typename Functor>
+    void forEachChunk(int theNbItems, const Functor& theFunctor)
+    {
+        const int aNbChunks = (theNbItems + THE_CHUNK_SIZE - 1) / THE_CHUNK_SIZE;
+        OSD_Parallel::For(0, aNbChunks, [&](int theChunk)
+        {
+            const int aBegin = theChunk * THE_CHUNK_SIZE;
+            theFunctor(aBegin, std::min(aBegin + THE_CHUNK_SIZE, theNbItems));
+        });
+    }
+
+    //! Normalize value within the range, quantized to bands if requested.
+    float legendPosition(float theValue, const float theRange[2], int theNbBands)
+    {
+        const float aSpan = theRange[1] - theRange[0];
+        float aT = aSpan > FLT_EPSILON ? (theValue - theRange[0]) / aSpan : 0.5f;
+        aT = std::min(std::max(aT, 0.0f), 1.0f);
+        if (theNbBands > 1)
+        {
+            const float aBand = std::min(std::floor(aT * theNbBands), (float)(theNbBands - 1));
+            aT = aBand / (float)(theNbBands - 1);
+        }
+        return aT;
+    }
+
+    //! Presentation holding a single triangle array with per-vertex colors.
+    class OcctAnalysisPrs : public AIS_InteractiveObject
+    {
+        DEFINE_STANDARD_RTTI_INLINE(OcctAnalysisPrs, AIS_InteractiveObject)
+    public:
+        OcctAnalysisPrs(const Handle(Graphic3d_ArrayOfTriangles)& theTriangles)
+            : myTriangles(theTriangles)
+        {
+            SetInfiniteState(false);
+        }
+
+        virtual Standard_Boolean AcceptDisplayMode(const Standard_Integer theMode) const Standard_OVERRIDE { return theMode == 0; }
+
+    protected:
+        virtual void Compute(const Handle(PrsMgr_PresentationManager)& ,
+                             const Handle(Prs3d_Presentation)& thePrs,
+                             const Standard_Integer ) Standard_OVERRIDE
+        {
+            Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
+            aGroup->SetGroupPrimitivesAspect(myDrawer->ShadingAspect()->Aspect());
+            aGroup->AddPrimitiveArray(myTriangles);
+        }
+
+        virtual void ComputeSelection(const Handle(SelectMgr_Selection)& ,
+                                      const Standard_Integer ) Standard_OVERRIDE {}
+
+    private:
+        Handle(Graphic3d_ArrayOfTriangles) myTriangles;
+    };
+
+    //! Triangulated face with the offset of its first vertex in the part arrays.
+    struct FaceSpan
+    {
+        TopoDS_Face                Face;
+        Handle(Poly_Triangulation) Triangulation;
+        gp_Trsf                    Location;
+        int                        VertexOffset;
+    };
+}
+
+// ================================================================
+// Function : OcctAnalysisEngine
+// Purpose  :
+// ================================================================
+OcctAnalysisEngine::OcctAnalysisEngine()
+    : myMode(AnalysisMode_MeanCurvature),
+    myNbBands(0),
+    myToFitRange(true),
+    myBuildMs(0.0),
+    myEvalMs(0.0),
+    myColorMs(0.0)
+{
+    myPullDir[0] = 0.0f;
+    myPullDir[1] = 0.0f;
+    myPullDir[2] = 1.0f;
+    myRange[0] = 0.0f;
+    myRange[1] = 1.0f;
+    std::fill(myHistogram, myHistogram + THE_NB_BINS, 0.0f);
+}
+
+// ================================================================
+// Function : PaletteColor
+// Purpose  :
+// ================================================================
+Graphic3d_Vec4ub OcctAnalysisEngine::PaletteColor(float theT)
+{
+    static const float THE_STOPS[5][3] =
+    {
+        { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 1.0f }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }
+    };
+    const float aPos = std::min(std::max(theT, 0.0f), 1.0f) * 4.0f;
+    const int aLower = std::min((int)aPos, 3);
+    const float aFrac = aPos - (float)aLower;
+    Graphic3d_Vec4ub aColor(0, 0, 0, 255);
+    for (int aComp = 0; aComp < 3; ++aComp)
+    {
+        const float aValue = THE_STOPS[aLower][aComp] + (THE_STOPS[aLower + 1][aComp] - THE_STOPS[aLower][aComp]) * aFrac;
+        aColor[aComp] = (Standard_Byte)(aValue * 255.0f + 0.5f);
+    }
+    return aColor;
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctAnalysisEngine::Init(const Handle(AIS_InteractiveContext)& theCtx,
+                              const Handle(V3d_View)& theView)
+{
+    myContext = theCtx;
+    myView = theView;
+}
+
+// ================================================================
+// Function : Start
+// Purpose  :
+// ================================================================
+void OcctAnalysisEngine::Start()
+{
+    Stop();
+
+    OSD_Timer aTimer;
+    aTimer.Start();
+    AIS_ListOfInteractive anObjects;
+    myContext->DisplayedObjects(anObjects);
+    for (AIS_ListOfInteractive::Iterator anObjIter(anObjects); anObjIter.More(); anObjIter.Next())
+    {
+        Handle(AIS_Shape) aShapePrs = Handle(AIS_Shape)::DownCast(anObjIter.Value());
+        if (aShapePrs.IsNull()
+         || aShapePrs->Shape().IsNull())
+        {
+            continue;
+        }
+
+        PartData aPart;
+        aPart.Source = aShapePrs;
+        buildPart(aPart);
+        if (!aPart.Triangles.IsNull())
+        {
+            myParts.push_back(aPart);
+        }
+    }
+    aTimer.Stop();
+    myBuildMs = aTimer.ElapsedTime() * 1000.0;
+
+    // keep the reference among analyzed parts
+    if (std::find_if(myParts.begin(), myParts.end(),
+                     [this](const PartData& thePart) { return thePart.Source == myReference; }) == myParts.end())
+    {
+        myReference = myParts.empty() ? Handle(AIS_Shape)() : myParts.front().Source;
+    }
+
+    evaluate();
+    colorize();
+    for (PartData& aPart : myParts)
+    {
+        myContext->Erase(aPart.Source, false);
+        myContext->Display(aPart.Prs, 0, -1, false);
+    }
+    myView->Invalidate();
+}
+
+// ================================================================
+// Function : Stop
+// Purpose  :
+// ================================================================
+void OcctAnalysisEngine::Stop()
+{
+    for (PartData& aPart : myParts)
+    {
+        myContext->Remove(aPart.Prs, false);
+        myContext->Display(aPart.Source, false);
+    }
+    if (!myParts.empty())
+    {
+        myView->Invalidate();
+    }
+    myParts.clear();
+    myBvhCache.Clear();
+}
+
+// ================================================================
+// Function : buildPart
+// Purpose  :
+// ================================================================
+void OcctAnalysisEngine::buildPart(PartData& thePart)
+{
+    // assign vertex ranges sequentially, so that faces can be processed independently
+    std::vector<FaceSpan> aFaces;
+    int aNbVerts = 0, aNbTris = 0;
+    for (TopExp_Explorer anExp(thePart.Source->Shape(), TopAbs_FACE); anExp.More(); anExp.Next())
+    {
+        FaceSpan aSpan;
+        aSpan.Face = TopoDS::Face(anExp.Current());
+        TopLoc_Location aLoc;
+        aSpan.Triangulation = BRep_Tool::Triangulation(aSpan.Face, aLoc);
+        if (aSpan.Triangulation.IsNull()
+         || aSpan.Triangulation->NbTriangles() == 0)
+        {
+            continue;
+        }
+
+        aSpan.Location = aLoc.Transformation();
+        aSpan.VertexOffset = aNbVerts;
+        aNbVerts += aSpan.Triangulation->NbNodes();
+        aNbTris  += aSpan.Triangulation->NbTriangles();
+        aFaces.push_back(aSpan);
+    }
+    if (aNbTris == 0)
+    {
+        return;
+    }
+
+    thePart.PosX.resize(aNbVerts); thePart.PosY.resize(aNbVerts); thePart.PosZ.resize(aNbVerts);
+    thePart.NrmX.resize(aNbVerts); thePart.NrmY.resize(aNbVerts); thePart.NrmZ.resize(aNbVerts);
+    thePart.Kmin.resize(aNbVerts); thePart.Kmax.resize(aNbVerts);
+    thePart.Values.resize(aNbVerts);
+
+    // evaluate positions, normals and principal curvatures at the mesh nodes
+    OSD_Parallel::For(0, (int)aFaces.size(), [&](int theIndex)
+    {
+        const FaceSpan& aSpan = aFaces[theIndex];
+        const Handle(Poly_Triangulation)& aTris = aSpan.Triangulation;
+        const bool isReversed = aSpan.Face.Orientation() == TopAbs_REVERSED;
+        const float aSign = isReversed ? -1.0f : 1.0f;
+        BRepAdaptor_Surface aSurf(aSpan.Face);
+        BRepLProp_SLProps aProps(aSurf, 2, Precision::Confusion());
+        for (int aNodeIter = 1; aNodeIter <= aTris->NbNodes(); ++aNodeIter)
+        {
+            const int anIndex = aSpan.VertexOffset + aNodeIter - 1;
+            const gp_Pnt aPnt = aTris->Node(aNodeIter).Transformed(aSpan.Location);
+            thePart.PosX[anIndex] = (float)aPnt.X();
+            thePart.PosY[anIndex] = (float)aPnt.Y();
+            thePart.PosZ[anIndex] = (float)aPnt.Z();
+
+            gp_Vec aNorm(0.0, 0.0, 0.0);
+            float aKmin = 0.0f, aKmax = 0.0f;
+            if (aTris->HasUVNodes())
+            {
+                const gp_Pnt2d aUV = aTris->UVNode(aNodeIter);
+                aProps.SetParameters(aUV.X(), aUV.Y());
+                if (aProps.IsNormalDefined())
+                {
+                    aNorm = aProps.Normal();
+                }
+                if (aProps.IsCurvatureDefined())
+                {
+                    aKmin = (float)aProps.MinCurvature();
+                    aKmax = (float)aProps.MaxCurvature();
+                }
+            }
+            else if (aTris->HasNormals())
+            {
+                aNorm = gp_Vec(aTris->Normal(aNodeIter)).Transformed(aSpan.Location);
+            }
+
+            // reversing the face flips the normal and with it the sign of curvatures
+            thePart.NrmX[anIndex] = aSign * (float)aNorm.X();
+            thePart.NrmY[anIndex] = aSign * (float)aNorm.Y();
+            thePart.NrmZ[anIndex] = aSign * (float)aNorm.Z();
+            thePart.Kmin[anIndex] = isReversed ? -aKmax : aKmin;
+            thePart.Kmax[anIndex] = isReversed ? -aKmin : aKmax;
+        }
+    });
+
+    // colors are rewritten in place, so keep attributes mutable and deinterleaved
+    thePart.Triangles = new Graphic3d_ArrayOfTriangles(aNbVerts, aNbTris * 3,
+                                                       Graphic3d_ArrayFlags_VertexNormal
+                                                     | Graphic3d_ArrayFlags_VertexColor
+                                                     | Graphic3d_ArrayFlags_AttribsMutable
+                                                     | Graphic3d_ArrayFlags_AttribsDeinterleaved);
+    for (int aVertIter = 0; aVertIter < aNbVerts; ++aVertIter)
+    {
+        thePart.Triangles->AddVertex(Graphic3d_Vec3(thePart.PosX[aVertIter], thePart.PosY[aVertIter], thePart.PosZ[aVertIter]),
+                                     Graphic3d_Vec3(thePart.NrmX[aVertIter], thePart.NrmY[aVertIter], thePart.NrmZ[aVertIter]));
+    }
+    for (const FaceSpan& aSpan : aFaces)
+    {
+        const bool isReversed = aSpan.Face.Orientation() == TopAbs_REVERSED;
+        for (int aTriIter = 1; aTriIter <= aSpan.Triangulation->NbTriangles(); ++aTriIter)
+        {
+            int aN1 = 0, aN2 = 0, aN3 = 0;
+            aSpan.Triangulation->Triangle(aTriIter).Get(aN1, aN2, aN3);
+            if (isReversed)
+            {
+                std::swap(aN2, aN3);
+            }
+            thePart.Triangles->AddEdges(aSpan.VertexOffset + aN1, aSpan.VertexOffset + aN2, aSpan.VertexOffset + aN3);
+        }
+    }
+
+    thePart.Prs = new OcctAnalysisPrs(thePart.Triangles);
+    thePart.Prs->SetLocalTransformation(thePart.Source->Transformation());
+}
+
+// ================================================================
+// Function : evaluate
+// Purpose  :
+// ================================================================
+void OcctAnalysisEngine::evaluate()
+{
+    OSD_Timer aTimer;
+    aTimer.Start();
+    if (myMode == AnalysisMode_Deviation
+     && !myReference.IsNull())
+    {
+        // build the reference BVH once on this thread, queries below only read it
+        myBvhCache.Faces(myReference->Shape());
+    }
+
+    for (PartData& aPart : myParts)
+    {
+        const int aNbVerts = (int)aPart.Values.size();
+        switch (myMode)
+        {
+            case AnalysisMode_MeanCurvature:
+            {
+                forEachChunk(aNbVerts, [&](int theBegin, int theEnd)
+                {
+                    for (int anIter = theBegin; anIter < theEnd; ++anIter)
+                    {
+                        aPart.Values[anIter] = 0.5f * (aPart.Kmin[anIter] + aPart.Kmax[anIter]);
+                    }
+                });
+                break;
+            }
+            case AnalysisMode_GaussCurvature:
+            {
+                forEachChunk(aNbVerts, [&](int theBegin, int theEnd)
+                {
+                    for (int anIter = theBegin; anIter < theEnd; ++anIter)
+                    {
+                        aPart.Values[anIter] = aPart.Kmin[anIter] * aPart.Kmax[anIter];
+                    }
+                });
+                break;
+            }
+            case AnalysisMode_Draft:
+            {
+                // bring the pull direction into shape coordinates
+                gp_Vec aPull(myPullDir[0], myPullDir[1], myPullDir[2]);
+                if (aPull.SquareMagnitude() <= gp::Resolution())
+                {
+                    aPull = gp_Vec(0.0, 0.0, 1.0);
+                }
+                aPull.Transform(aPart.Source->Transformation().Inverted());
+                aPull.Normalize();
+                const float aDir[3] = { (float)aPull.X(), (float)aPull.Y(), (float)aPull.Z() };
+                forEachChunk(aNbVerts, [&](int theBegin, int theEnd)
+                {
+                    for (int anIter = theBegin; anIter < theEnd; ++anIter)
+                    {
+                        const float aDot = aPart.NrmX[anIter] * aDir[0] + aPart.NrmY[anIter] * aDir[1] + aPart.NrmZ[anIter] * aDir[2];
+                        aPart.Values[anIter] = (float)(std::asin(std::min(std::max(aDot, -1.0f), 1.0f)) * 180.0 / M_PI);
+                    }
+                });
+                break;
+            }
+            case AnalysisMode_Deviation:
+            {
+                if (myReference.IsNull())
+                {
+                    std::fill(aPart.Values.begin(), aPart.Values.end(), 0.0f);
+                    break;
+                }
+
+                // distances depend only on the reference, so they are computed once per part
+                if (aPart.Deviation.empty())
+                {
+                    aPart.Deviation.resize(aNbVerts);
+                    const TopoDS_Shape& aRefShape = myReference->Shape();
+                    const gp_Trsf aToRef = myReference->Transformation().Inverted() * aPart.Source->Transformation();
+                    forEachChunk(aNbVerts, [&](int theBegin, int theEnd)
+                    {
+                        for (int anIter = theBegin; anIter < theEnd; ++anIter)
+                        {
+                            const gp_Pnt aPnt = gp_Pnt(aPart.PosX[anIter], aPart.PosY[anIter], aPart.PosZ[anIter]).Transformed(aToRef);
+                            gp_Pnt aNearest;
+                            Standard_Real aDist = 0.0;
+                            aPart.Deviation[anIter] = myBvhCache.NearestPoint(aRefShape, aPnt, aNearest, aDist) ? (float)aDist : 0.0f;
+                        }
+                    });
+                }
+                aPart.Values = aPart.Deviation;
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        }
+    }
+    aTimer.Stop();
+    myEvalMs = aTimer.ElapsedTime() * 1000.0;
+
+    if (myToFitRange)
+    {
+        fitRange();
+    }
+}
+
+// ================================================================
+// Function : fitRange
+// Purpose  :
+// ================================================================
+void OcctAnalysisEngine::fitRange()
+{
+    float aMin = FLT_MAX, aMax = -FLT_MAX;
+    for (const PartData& aPart : myParts)
+    {
+        for (float aValue : aPart.Values)
+        {
+            aMin = std::min(aMin, aValue);
+            aMax = std::max(aMax, aValue);
+        }
+    }
+    if (aMin > aMax)
+    {
+        aMin = 0.0f;
+        aMax = 1.0f;
+    }
+    myRange[0] = aMin;
+    myRange[1] = aMax;
+}
+
+// ================================================================
+// Function : colorize
+// Purpose  :
+// ================================================================
+void OcctAnalysisEngine::colorize()
+{
+    OSD_Timer aTimer;
+    aTimer.Start();
+    int aTotalBins[THE_NB_BINS] = {};
+    for (PartData& aPart : myParts)
+    {
+        const Handle(Graphic3d_Buffer)& anAttribs = aPart.Triangles->Attributes();
+        Standard_Integer aColorAttrib = -1;
+        Standard_Size aStride = 0;
+        Standard_Byte* aColorData = anAttribs->ChangeAttributeData(Graphic3d_TOA_COLOR, aColorAttrib, aStride);
+        if (aColorData == NULL)
+        {
+            continue;
+        }
+
+        const int aNbVerts = (int)aPart.Values.size();
+        const int aNbChunks = (aNbVerts + THE_CHUNK_SIZE - 1) / THE_CHUNK_SIZE;
+        std::vector<int> aChunkBins((size_t)aNbChunks * THE_NB_BINS, 0);
+        forEachChunk(aNbVerts, [&](int theBegin, int theEnd)
+        {
+            int* aBins = aChunkBins.data() + (size_t)(theBegin / THE_CHUNK_SIZE) * THE_NB_BINS;
+            for (int anIter = theBegin; anIter < theEnd; ++anIter)
+            {
+                const float aValue = aPart.Values[anIter];
+                *reinterpret_cast<Graphic3d_Vec4ub*>(aColorData + aStride * anIter) = PaletteColor(legendPosition(aValue, myRange, myNbBands));
+                ++aBins[(int)(legendPosition(aValue, myRange, 0) * (THE_NB_BINS - 1) + 0.5f)];
+            }
+        });
+        for (size_t aBinIter = 0; aBinIter < aChunkBins.size(); ++aBinIter)
+        {
+            aTotalBins[aBinIter % THE_NB_BINS] += aChunkBins[aBinIter];
+        }
+
+        // re-upload only the color attribute range on the next redraw
+        if (Handle(Graphic3d_AttribBuffer) aMutable = Handle(Graphic3d_AttribBuffer)::DownCast(anAttribs))
+        {
+            aMutable->Invalidate(aColorAttrib);
+        }
+    }
+    for (int aBinIter = 0; aBinIter < THE_NB_BINS; ++aBinIter)
+    {
+        myHistogram[aBinIter] = (float)aTotalBins[aBinIter];
+    }
+    aTimer.Stop();
+    myColorMs = aTimer.ElapsedTime() * 1000.0;
+
+    if (!myView.IsNull())
+    {
+        myView->Invalidate();
+    }
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctAnalysisEngine::RenderGui()
+{
+    ImGui::Begin("Analysis");
+    if (!IsActive())
+    {
+        if (ImGui::Button("Analyze displayed shapes"))
+        {
+            Start();
+        }
+    }
+    else if (ImGui::Button("Stop analysis"))
+    {
+        Stop();
+    }
+
+    bool toEvaluate = false, toColorize = false;
+    int aMode = myMode;
+    if (ImGui::Combo("Mode", &aMode, THE_MODE_NAMES, AnalysisMode_NB))
+    {
+        myMode = (AnalysisMode)aMode;
+        toEvaluate = true;
+    }
+
+    if (myMode == AnalysisMode_Draft)
+    {
+        toEvaluate |= ImGui::DragFloat3("Pull direction", myPullDir, 0.01f, -1.0f, 1.0f, "%.2f");
+    }
+    else if (myMode == AnalysisMode_Deviation)
+    {
+        char aLabel[64] = "<none>";
+        for (size_t aPartIter = 0; aPartIter < myParts.size(); ++aPartIter)
+        {
+            if (myParts[aPartIter].Source == myReference)
+            {
+                snprintf(aLabel, sizeof(aLabel), "Part %d", (int)aPartIter + 1);
+            }
+        }
+        if (ImGui::BeginCombo("Reference", aLabel))
+        {
+            for (size_t aPartIter = 0; aPartIter < myParts.size(); ++aPartIter)
+            {
+                const PartData& aPart = myParts[aPartIter];
+                snprintf(aLabel, sizeof(aLabel), "Part %d", (int)aPartIter + 1);
+                if (ImGui::Selectable(aLabel, aPart.Source == myReference))
+                {
+                    myReference = aPart.Source;
+                    for (PartData& anOther : myParts)
+                    {
+                        anOther.Deviation.clear();
+                    }
+                    toEvaluate = true;
+                }
+            }
+            ImGui::EndCombo();
+        }
+    }
+
+    ImGui::SeparatorText("Legend");
+    if (ImGui::Checkbox("Auto range", &myToFitRange) && myToFitRange)
+    {
+        fitRange();
+        toColorize = true;
+    }
+    ImGui::BeginDisabled(myToFitRange);
+    toColorize |= ImGui::DragFloat2("Range", myRange, 0.001f * std::max(std::abs(myRange[1] - myRange[0]), 1.0f), 0.0f, 0.0f, "%.4g");
+    ImGui::EndDisabled();
+    toColorize |= ImGui::SliderInt("Bands", &myNbBands, 0, 16, myNbBands == 0 ? "continuous" : "%d");
+
+    // color bar with range labels
+    {
+        const float aWidth = ImGui::GetContentRegionAvail().x;
+        const float aHeight = ImGui::GetFrameHeight();
+        const ImVec2 aMin = ImGui::GetCursorScreenPos();
+        ImDrawList* aDrawList = ImGui::GetWindowDrawList();
+        const int aNbSteps = myNbBands > 1 ? myNbBands : 64;
+        for (int aStepIter = 0; aStepIter < aNbSteps; ++aStepIter)
+        {
+            const float aT = myNbBands > 1 ? (float)aStepIter / (float)(aNbSteps - 1) : ((float)aStepIter + 0.5f) / (float)aNbSteps;
+            const Graphic3d_Vec4ub aColor = PaletteColor(aT);
+            aDrawList->AddRectFilled(ImVec2(aMin.x + aWidth * aStepIter / aNbSteps, aMin.y),
+                                     ImVec2(aMin.x + aWidth * (aStepIter + 1) / aNbSteps, aMin.y + aHeight),
+                                     IM_COL32(aColor.r(), aColor.g(), aColor.b(), 255));
+        }
+        ImGui::Dummy(ImVec2(aWidth, aHeight));
+        ImGui::Text("%.4g", myRange[0]);
+        char aMaxLabel[32];
+        snprintf(aMaxLabel, sizeof(aMaxLabel), "%.4g", myRange[1]);
+        ImGui::SameLine(std::max(aWidth - ImGui::CalcTextSize(aMaxLabel).x, 0.0f));
+        ImGui::TextUnformatted(aMaxLabel);
+    }
+    ImGui::PlotHistogram("##histogram", myHistogram, THE_NB_BINS, 0, NULL, 0.0f, FLT_MAX,
+                         ImVec2(ImGui::GetContentRegionAvail().x, 48.0f));
+
+    if (IsActive())
+    {
+        if (toEvaluate)
+        {
+            evaluate();
+            toColorize = true;
+        }
+        if (toColorize)
+        {
+            colorize();
+        }
+    }
+
+    ImGui::SeparatorText("Statistics");
+    size_t aNbVerts = 0;
+    for (const PartData& aPart : myParts)
+    {
+        aNbVerts += aPart.Values.size();
+    }
+    ImGui::Text("Parts: %d  vertices: %zu", (int)myParts.size(), aNbVerts);
+    ImGui::Text("Build: %.1f ms  evaluate: %.2f ms  colors: %.2f ms", myBuildMs, myEvalMs, myColorMs);
+    ImGui::End();
+}
@@ -0,0 +1,121 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctAnalysisEngine_Header
+#define _OcctAnalysisEngine_Header
+
+#include "OcctShapeBvhCache.h"
+
+#include <AIS_InteractiveContext.hxx>
+#include <AIS_Shape.hxx>
+#include <Graphic3d_ArrayOfTriangles.hxx>
+#include <V3d_View.hxx>
+
+#include <vector>
+
+//! Per-vertex analysis color maps over triangulations of displayed shapes.
+//! Vertex data is kept as struct-of-arrays (positions, normals, principal curvatures), filled in parallel per face;
+//! scalars are evaluated in parallel over vertex chunks and mapped to colors through the legend.
+//! Colors are written straight into the mutable attribute buffer of the analysis presentation
+//! and only the color attribute is invalidated, so parameter changes never rebuild presentations.
+class OcctAnalysisEngine
+{
+public:
+    //! Analysis kind.
+    enum AnalysisMode
+    {
+        AnalysisMode_MeanCurvature,
+        AnalysisMode_GaussCurvature,
+        AnalysisMode_Draft,
+        AnalysisMode_Deviation,
+        AnalysisMode_NB
+    };
+
+public:
+    //! Default constructor.
+    OcctAnalysisEngine();
+
+    //! Attach the engine to the interactive context and view.
+    void Init(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theView);
+
+    //! Replace displayed shapes by analysis presentations.
+    void Start();
+
+    //! Remove analysis presentations and show the original shapes.
+    void Stop();
+
+    //! Return true if the analysis is shown.
+    bool IsActive() const { return !myParts.empty(); }
+
+    //! Render the analysis panel with the legend.
+    void RenderGui();
+
+    //! Map normalized value to the blue-cyan-green-yellow-red legend palette.
+    static Graphic3d_Vec4ub PaletteColor(float theT);
+
+private:
+    //! Analyzed part in struct-of-arrays layout, in shape coordinates.
+    struct PartData
+    {
+        Handle(AIS_Shape)                  Source;
+        Handle(AIS_InteractiveObject)      Prs;
+        Handle(Graphic3d_ArrayOfTriangles) Triangles;
+        std::vector<float>                 PosX, PosY, PosZ;
+        std::vector<float>                 NrmX, NrmY, NrmZ;
+        std::vector<float>                 Kmin, Kmax;  //!< principal curvatures
+        std::vector<float>                 Deviation;   //!< distance to the reference, empty if not computed
+        std::vector<float>                 Values;      //!< scalars of the current mode
+    };
+
+private:
+    //! Build vertex data and presentation of the shape.
+    void buildPart(PartData& thePart);
+
+    //! Evaluate scalars of the current mode.
+    void evaluate();
+
+    //! Map scalars to vertex colors and update the histogram.
+    void colorize();
+
+    //! Set legend range from the current values.
+    void fitRange();
+
+private:
+    Handle(AIS_InteractiveContext) myContext;
+    Handle(V3d_View)               myView;
+    std::vector<PartData>          myParts;
+    OcctShapeBvhCache              myBvhCache;      //!< reference shape BVH for deviation
+    Handle(AIS_Shape)              myReference;
+    AnalysisMode                   myMode;
+    float                          myPullDir[3];    //!< draft pull direction
+    float                          myRange[2];      //!< legend range
+    int                            myNbBands;       //!< 0 for continuous legend
+    bool                           myToFitRange;
+    float                          myHistogram[32];
+    double                         myBuildMs;
+    double                         myEvalMs;
+    double                         myColorMs;
+};
+
+#endif // _OcctAnalysisEngine_Header
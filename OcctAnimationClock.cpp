@@ -0,0 +1,207 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctAnimationClock.h"
+
+#include "imgui/imgui.h"
+
+#include <OSD_Chronometer.hxx>
+
+#include <algorithm>
+
+namespace
+{
+    //! Return user and system CPU time of the process in seconds.
+    double processCpuSeconds()
+    {
+        Standard_Real aUser = 0.0, aSystem = 0.0;
+        OSD_Chronometer::GetProcessCPU(aUser, aSystem);
+        return aUser + aSystem;
+    }
+}
+
+// ================================================================
+// Function : OcctAnimationClock
+// Purpose  :
+// ================================================================
+OcctAnimationClock::OcctAnimationClock()
+    : myDisplayRate(0.0),
+    myFrameCap(0.0f),
+    myNextFrameTime(0.0),
+    myIsAnimating(false),
+    myStartTime(0.0),
+    myStartCpu(0.0),
+    myNbFrames(0),
+    myNbTotalFrames(0),
+    myLastFrames(0),
+    myLastSeconds(0.0),
+    myLastCpu(0.0)
+{
+    myClock.Start();
+}
+
+// ================================================================
+// Function : AddAnimation
+// Purpose  :
+// ================================================================
+void OcctAnimationClock::AddAnimation(const Handle(AIS_Animation)& theAnimation)
+{
+    if (theAnimation.IsNull())
+    {
+        return;
+    }
+
+    Entry anEntry;
+    anEntry.Animation = theAnimation;
+    anEntry.StartPts  = 0.0;
+    anEntry.StartTime = 0.0;
+    anEntry.IsDriven  = false;
+    myAnimations.push_back(anEntry);
+}
+
+// ================================================================
+// Function : Abort
+// Purpose  :
+// ================================================================
+void OcctAnimationClock::Abort(const Handle(AIS_Animation)& theAnimation)
+{
+    for (Entry& anEntry : myAnimations)
+    {
+        if (anEntry.Animation == theAnimation
+         && anEntry.IsDriven)
+        {
+            anEntry.Animation->Stop();
+            anEntry.IsDriven = false;
+        }
+    }
+}
+
+// ================================================================
+// Function : framePeriod
+// Purpose  :
+// ================================================================
+double OcctAnimationClock::framePeriod() const
+{
+    if (myFrameCap > 0.0f)
+    {
+        return 1.0 / myFrameCap;
+    }
+    return myDisplayRate > 0.0 ? 1.0 / myDisplayRate : 1.0 / 60.0;
+}
+
+// ================================================================
+// Function : TimeToNextFrame
+// Purpose  :
+// ================================================================
+double OcctAnimationClock::TimeToNextFrame() const
+{
+    return std::max(myNextFrameTime - myClock.ElapsedTime(), 0.0);
+}
+
+// ================================================================
+// Function : Update
+// Purpose  :
+// ================================================================
+bool OcctAnimationClock::Update(bool theHasPlayback)
+{
+    const double aNow = myClock.ElapsedTime();
+    bool isRunning = theHasPlayback;
+    for (Entry& anEntry : myAnimations)
+    {
+        // a (re)started animation runs its own timer, take it over from the current position;
+        // paused animations are skipped by AIS_ViewController, so only the clock advances them
+        if (!anEntry.Animation->IsStopped())
+        {
+            anEntry.StartPts  = anEntry.Animation->ElapsedTime();
+            anEntry.StartTime = aNow;
+            anEntry.IsDriven  = true;
+            anEntry.Animation->Pause();
+        }
+        if (!anEntry.IsDriven)
+        {
+            continue;
+        }
+
+        if (anEntry.Animation->Update(anEntry.StartPts + aNow - anEntry.StartTime))
+        {
+            isRunning = true;
+        }
+        else
+        {
+            anEntry.Animation->Stop();
+            anEntry.IsDriven = false;
+        }
+    }
+
+    if (isRunning)
+    {
+        if (!myIsAnimating)
+        {
+            myStartTime = aNow;
+            myStartCpu = processCpuSeconds();
+            myNbFrames = 0;
+            myNextFrameTime = aNow;
+        }
+        ++myNbFrames;
+        ++myNbTotalFrames;
+
+        // keep a steady cadence, but do not try to catch up with missed frames
+        myNextFrameTime += framePeriod();
+        if (myNextFrameTime <= aNow)
+        {
+            myNextFrameTime = aNow + framePeriod();
+        }
+    }
+    else if (myIsAnimating)
+    {
+        myLastFrames = myNbFrames;
+        myLastSeconds = aNow - myStartTime;
+        myLastCpu = processCpuSeconds() - myStartCpu;
+    }
+    myIsAnimating = isRunning;
+    return isRunning;
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctAnimationClock::RenderGui()
+{
+    ImGui::Begin("Animation Clock");
+    ImGui::Text("Display: %.0f Hz", myDisplayRate);
+    ImGui::SliderFloat("Frame cap, Hz", &myFrameCap, 0.0f, 240.0f, myFrameCap > 0.0f ? "%.0f" : "display rate");
+    ImGui::Text("State: %s", myIsAnimating ? "animating" : "waiting for events");
+
+    ImGui::SeparatorText("Statistics");
+    ImGui::Text("Animation frames since start: %d", myNbTotalFrames);
+    if (myIsAnimating)
+    {
+        ImGui::Text("Current: %d frames", myNbFrames);
+    }
+    ImGui::Text("Last: %d frames in %.2f s (%.0f fps)", myLastFrames, myLastSeconds,
+                myLastSeconds > 0.0 ? myLastFrames / myLastSeconds : 0.0);
+    ImGui::Text("Last CPU: %.0f ms (%.0f%% of one core)", myLastCpu * 1000.0,
+                myLastSeconds > 0.0 ? 100.0 * myLastCpu / myLastSeconds : 0.0);
+    ImGui::End();
+}
@@ -0,0 +1,98 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctAnimationClock_Header
+#define _OcctAnimationClock_Header
+
+#include <AIS_Animation.hxx>
+#include <OSD_Timer.hxx>
+
+#include <vector>
+
+//! Single clock driving AIS animations and playback at a paced frame rate.
+//! Registered animations are taken over once started: their own timers are paused,
+//! and all of them are advanced from the same frame timestamp, so the view animation,
+//! object animations and playback stay in sync regardless of how often frames are rendered.
+//! The next frame is scheduled for the display refresh rate or a configurable cap,
+//! and the clock reports idle as soon as the last animation finishes.
+class OcctAnimationClock
+{
+public:
+    //! Default constructor.
+    OcctAnimationClock();
+
+    //! Register an animation to be driven by the clock.
+    void AddAnimation(const Handle(AIS_Animation)& theAnimation);
+
+    //! Stop the animation driven by the clock, e.g. when the user takes over the camera.
+    //! AIS_ViewController::AbortViewAnimation() skips it, as driven animations are paused.
+    void Abort(const Handle(AIS_Animation)& theAnimation);
+
+    //! Set refresh rate of the display in Hz.
+    void SetDisplayRate(double theRate) { myDisplayRate = theRate; }
+
+    //! Sample the frame timestamp and advance running animations.
+    //! @param theHasPlayback [in] other time-based content (playback) needs paced frames
+    //! @return true if the next frame should be scheduled
+    bool Update(bool theHasPlayback);
+
+    //! Return true if animations or playback are running.
+    bool IsAnimating() const { return myIsAnimating; }
+
+    //! Return seconds until the next scheduled frame, 0 if it is already due.
+    double TimeToNextFrame() const;
+
+    //! Render the clock panel.
+    void RenderGui();
+
+private:
+    //! Animation driven by the clock.
+    struct Entry
+    {
+        Handle(AIS_Animation) Animation;
+        double                StartPts;   //!< animation time when taken over
+        double                StartTime;  //!< clock time when taken over
+        bool                  IsDriven;
+    };
+
+private:
+    //! Return the frame period in seconds.
+    double framePeriod() const;
+
+private:
+    std::vector<Entry> myAnimations;
+    OSD_Timer          myClock;
+    double             myDisplayRate;    //!< display refresh rate in Hz, 0 if unknown
+    float              myFrameCap;       //!< frame rate cap in Hz, 0 to follow the display
+    double             myNextFrameTime;  //!< clock time of the next scheduled frame
+    bool               myIsAnimating;
+    double             myStartTime;      //!< clock time of the current animation start
+    double             myStartCpu;       //!< process CPU time of the current animation start
+    int                myNbFrames;       //!< frames of the current animation
+    int                myNbTotalFrames;  //!< frames spent on animations since start
+    int                myLastFrames;     //!< frames of the last finished animation
+    double             myLastSeconds;    //!< duration of the last finished animation
+    double             myLastCpu;        //!< process CPU seconds used by the last finished animation
+};
+
+#endif // _OcctAnimationClock_Header
@@ -0,0 +1,263 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctBatchDisplay.h"
+
+#include "imgui/imgui.h"
+
+#include <AIS_Shape.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <NCollection_Map.hxx>
+#include <OSD_Parallel.hxx>
+#include <OSD_Timer.hxx>
+#include <StdPrs_ToolTriangulatedShape.hxx>
+#include <TopTools_ShapeMapHasher.hxx>
+
+#include <cmath>
+
+// ================================================================
+// Function : Display
+// Purpose  :
+// ================================================================
+OcctBatchDisplay::Timings OcctBatchDisplay::Display(const Handle(AIS_InteractiveContext)& theCtx,
+                                                    const NCollection_Vector<Handle(AIS_InteractiveObject)>& theObjects,
+                                                    int theDispMode,
+                                                    int theSelMode)
+{
+    Timings aTimings;
+    OSD_Timer aTotalTimer, aTimer;
+    aTotalTimer.Start();
+    aTimer.Start();
+
+    // tessellate every distinct shape once, instances share triangulation
+    NCollection_Vector<Handle(AIS_Shape)> aShapePrsList;
+    NCollection_Vector<TopoDS_Shape> aShapes;
+    NCollection_Vector<Handle(Prs3d_Drawer)> aShapeDrawers;
+    {
+        NCollection_Map<TopoDS_Shape, TopTools_ShapeMapHasher> aUniqueShapes;
+        for (NCollection_Vector<Handle(AIS_InteractiveObject)>::Iterator anObjIter(theObjects); anObjIter.More(); anObjIter.Next())
+        {
+            Handle(AIS_Shape) aShapePrs = Handle(AIS_Shape)::DownCast(anObjIter.Value());
+            if (aShapePrs.IsNull() || aShapePrs->Shape().IsNull())
+            {
+                continue;
+            }
+
+            // the same deflection as used by the context is required to avoid re-meshing in Display()
+            if (!aShapePrs->Attributes()->HasLink())
+            {
+                aShapePrs->Attributes()->SetLink(theCtx->DefaultDrawer());
+            }
+            aShapePrsList.Append(aShapePrs);
+            if (aUniqueShapes.Add(aShapePrs->Shape().Located(TopLoc_Location())))
+            {
+                aShapes.Append(aShapePrs->Shape());
+                aShapeDrawers.Append(aShapePrs->Attributes());
+            }
+        }
+    }
+    // Tessellate() stores the computed deflection into the drawer,
+    // so that each task gets its own drawer instead of sharing the object or default one
+    OSD_Parallel::For(0, aShapes.Length(), [&](int theIndex)
+    {
+        Handle(Prs3d_Drawer) aDrawer = new Prs3d_Drawer();
+        aDrawer->SetLink(aShapeDrawers.Value(theIndex));
+        StdPrs_ToolTriangulatedShape::Tessellate(aShapes.Value(theIndex), aDrawer);
+    });
+    aTimings.MeshMs = aTimer.ElapsedTime() * 1000.0;
+
+    // selection primitives are independent per object
+    aTimer.Reset();
+    aTimer.Start();
+    if (theSelMode >= 0)
+    {
+        OSD_Parallel::For(0, aShapePrsList.Length(), [&](int theIndex)
+        {
+            aShapePrsList.Value(theIndex)->RecomputePrimitives(theSelMode);
+        });
+    }
+    aTimings.SelectionMs = aTimer.ElapsedTime() * 1000.0;
+
+    // presentations and structures are registered by a sequential per-object loop without intermediate redraws,
+    // there is no bulk registration in AIS_InteractiveContext
+    aTimer.Reset();
+    aTimer.Start();
+    for (NCollection_Vector<Handle(AIS_InteractiveObject)>::Iterator anObjIter(theObjects); anObjIter.More(); anObjIter.Next())
+    {
+        theCtx->Display(anObjIter.Value(), theDispMode, theSelMode, Standard_False);
+    }
+    aTimings.DisplayMs = aTimer.ElapsedTime() * 1000.0;
+    aTimings.TotalMs = aTotalTimer.ElapsedTime() * 1000.0;
+    return aTimings;
+}
+
+// ================================================================
+// Function : OcctBatchDisplay
+// Purpose  :
+// ================================================================
+OcctBatchDisplay::OcctBatchDisplay()
+    : myNbObjects(10000),
+    myLastNbObjects(0)
+{
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctBatchDisplay::Init(const Handle(AIS_InteractiveContext)& theCtx,
+                            const Handle(V3d_View)& theView)
+{
+    myContext = theCtx;
+    myView = theView;
+}
+
+// ================================================================
+// Function : createBoxes
+// Purpose  :
+// ================================================================
+NCollection_Vector<Handle(AIS_InteractiveObject)> OcctBatchDisplay::createBoxes(int theNbObjects)
+{
+    NCollection_Vector<Handle(AIS_InteractiveObject)> anObjects;
+    const int aNbCols = (int)std::ceil(std::sqrt((double)theNbObjects));
+    for (int anIter = 0; anIter < theNbObjects; ++anIter)
+    {
+        const gp_Pnt aCorner(200.0 + (anIter % aNbCols) * 15.0, (anIter / aNbCols) * 15.0, 0.0);
+        anObjects.Append(new AIS_Shape(BRepPrimAPI_MakeBox(aCorner, 10.0, 10.0, 10.0).Shape()));
+    }
+    return anObjects;
+}
+
+// ================================================================
+// Function : measureRedraw
+// Purpose  :
+// ================================================================
+double OcctBatchDisplay::measureRedraw(const Handle(OpenGl_Context)& theGlCtx,
+                                       const Handle(OpenGl_FrameBuffer)& theViewFbo)
+{
+    // the view is redrawn into its FBO as within GlfwOcctView::renderView(), not into the window back buffer
+    theGlCtx->SetDefaultFrameBuffer(theViewFbo);
+    theGlCtx->core11fwd->glFinish();
+    OSD_Timer aTimer;
+    aTimer.Start();
+    myView->Redraw();
+    theGlCtx->core11fwd->glFinish();
+    aTimer.Stop();
+    theGlCtx->SetDefaultFrameBuffer(Handle(OpenGl_FrameBuffer)());
+    theViewFbo->UnbindBuffer(theGlCtx);
+    return aTimer.ElapsedTime() * 1000.0;
+}
+
+// ================================================================
+// Function : runBenchmark
+// Purpose  :
+// ================================================================
+void OcctBatchDisplay::runBenchmark(int theNbObjects,
+                                    const Handle(OpenGl_Context)& theGlCtx,
+                                    const Handle(OpenGl_FrameBuffer)& theViewFbo)
+{
+    // each method gets its own shapes, so that neither reuses triangulation of the other
+    {
+        const NCollection_Vector<Handle(AIS_InteractiveObject)> anObjects = createBoxes(theNbObjects);
+        OSD_Timer aTimer;
+        aTimer.Start();
+        for (NCollection_Vector<Handle(AIS_InteractiveObject)>::Iterator anObjIter(anObjects); anObjIter.More(); anObjIter.Next())
+        {
+            myContext->Display(anObjIter.Value(), AIS_Shaded, 0, Standard_False);
+        }
+        myLoopTimings = Timings();
+        myLoopTimings.DisplayMs = aTimer.ElapsedTime() * 1000.0;
+        myLoopTimings.RedrawMs = measureRedraw(theGlCtx, theViewFbo);
+        myLoopTimings.TotalMs = myLoopTimings.DisplayMs + myLoopTimings.RedrawMs;
+        for (NCollection_Vector<Handle(AIS_InteractiveObject)>::Iterator anObjIter(anObjects); anObjIter.More(); anObjIter.Next())
+        {
+            myContext->Remove(anObjIter.Value(), Standard_False);
+        }
+    }
+    {
+        const NCollection_Vector<Handle(AIS_InteractiveObject)> anObjects = createBoxes(theNbObjects);
+        myBatchTimings = Display(myContext, anObjects, AIS_Shaded, 0);
+        myBatchTimings.RedrawMs = measureRedraw(theGlCtx, theViewFbo);
+        myBatchTimings.TotalMs += myBatchTimings.RedrawMs;
+        for (NCollection_Vector<Handle(AIS_InteractiveObject)>::Iterator anObjIter(anObjects); anObjIter.More(); anObjIter.Next())
+        {
+            myContext->Remove(anObjIter.Value(), Standard_False);
+        }
+    }
+    myLastNbObjects = theNbObjects;
+    myView->Invalidate();
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctBatchDisplay::RenderGui(const Handle(OpenGl_Context)& theGlCtx,
+                                 const Handle(OpenGl_FrameBuffer)& theViewFbo)
+{
+    ImGui::Begin("Display Benchmark");
+    ImGui::RadioButton("1k", &myNbObjects, 1000);
+    ImGui::SameLine();
+    ImGui::RadioButton("10k", &myNbObjects, 10000);
+    ImGui::SameLine();
+    ImGui::RadioButton("100k", &myNbObjects, 100000);
+    ImGui::SameLine();
+    ImGui::BeginDisabled(theViewFbo.IsNull());
+    if (ImGui::Button("Run"))
+    {
+        runBenchmark(myNbObjects, theGlCtx, theViewFbo);
+    }
+    ImGui::EndDisabled();
+
+    if (myLastNbObjects > 0
+     && ImGui::BeginTable("##timings", 3, ImGuiTableFlags_Borders))
+    {
+        ImGui::TableSetupColumn("ms");
+        ImGui::TableSetupColumn("Per-object");
+        ImGui::TableSetupColumn("Batch");
+        ImGui::TableHeadersRow();
+        const struct { const char* Name; double Timings::* Field; } aRows[] =
+        {
+            { "Mesh",      &Timings::MeshMs },
+            { "Selection", &Timings::SelectionMs },
+            { "Display",   &Timings::DisplayMs },
+            { "Redraw",    &Timings::RedrawMs },
+            { "Total",     &Timings::TotalMs }
+        };
+        for (const auto& aRow : aRows)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(aRow.Name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", myLoopTimings.*aRow.Field);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", myBatchTimings.*aRow.Field);
+        }
+        ImGui::EndTable();
+        ImGui::Text("%d objects", myLastNbObjects);
+        ImGui::TextDisabled("Per-object loop meshes and computes selection inside Display.");
+        ImGui::TextDisabled("Batch runs only meshing and selection in parallel, Display stays a per-object loop.");
+    }
+    ImGui::End();
+}
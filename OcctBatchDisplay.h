@@ -0,0 +1,98 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctBatchDisplay_Header
+#define _OcctBatchDisplay_Header
+
+#include <AIS_InteractiveContext.hxx>
+#include <NCollection_Vector.hxx>
+#include <OpenGl_Context.hxx>
+#include <OpenGl_FrameBuffer.hxx>
+#include <V3d_View.hxx>
+
+//! Bulk display of interactive objects.
+//! Only triangulation and selection primitives are computed in parallel ahead of time;
+//! objects are then displayed by a sequential per-object loop, as AIS_InteractiveContext
+//! has no bulk registration, without intermediate redraws; the caller redraws the view once afterwards.
+class OcctBatchDisplay
+{
+public:
+    //! Time spent in the stages of a batch display, in milliseconds.
+    struct Timings
+    {
+        double MeshMs;
+        double SelectionMs;
+        double DisplayMs;
+        double RedrawMs;
+        double TotalMs;
+
+        Timings() : MeshMs(0.0), SelectionMs(0.0), DisplayMs(0.0), RedrawMs(0.0), TotalMs(0.0) {}
+    };
+
+public:
+    //! Display the objects at once.
+    //! @param theCtx      [in] interactive context
+    //! @param theObjects  [in] objects to display
+    //! @param theDispMode [in] display mode
+    //! @param theSelMode  [in] selection mode to activate, -1 to skip selection
+    static Timings Display(const Handle(AIS_InteractiveContext)& theCtx,
+                           const NCollection_Vector<Handle(AIS_InteractiveObject)>& theObjects,
+                           int theDispMode,
+                           int theSelMode);
+
+public:
+    //! Default constructor.
+    OcctBatchDisplay();
+
+    //! Attach the benchmark panel to the interactive context and view.
+    void Init(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theView);
+
+    //! Render the benchmark panel comparing batch display with per-object loop.
+    //! The view is redrawn into the given FBO, as it is not bound while rendering the GUI.
+    void RenderGui(const Handle(OpenGl_Context)& theGlCtx,
+                   const Handle(OpenGl_FrameBuffer)& theViewFbo);
+
+private:
+    //! Run the benchmark for the given number of objects.
+    void runBenchmark(int theNbObjects,
+                      const Handle(OpenGl_Context)& theGlCtx,
+                      const Handle(OpenGl_FrameBuffer)& theViewFbo);
+
+    //! Redraw the view into its FBO and wait for the GPU; return elapsed time in milliseconds.
+    double measureRedraw(const Handle(OpenGl_Context)& theGlCtx,
+                         const Handle(OpenGl_FrameBuffer)& theViewFbo);
+
+    //! Create theNbObjects new boxes laid out on a grid.
+    static NCollection_Vector<Handle(AIS_InteractiveObject)> createBoxes(int theNbObjects);
+
+private:
+    Handle(AIS_InteractiveContext) myContext;
+    Handle(V3d_View)               myView;
+    int                            myNbObjects;
+    int                            myLastNbObjects;
+    Timings                        myLoopTimings;
+    Timings                        myBatchTimings;
+};
+
+#endif // _OcctBatchDisplay_Header
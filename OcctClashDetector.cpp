@@ -0,0 +1,383 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctClashDetector.h"
+
+#include "imgui/imgui.h"
+
+#include <AIS_Shape.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepExtrema_OverlapTool.hxx>
+#include <OSD_Parallel.hxx>
+#include <OSD_Timer.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+
+#include <algorithm>
+
+// ================================================================
+// Function : OcctClashDetector
+// Purpose  :
+// ================================================================
+OcctClashDetector::OcctClashDetector()
+    : myIsRunning(false),
+    myToCancel(false),
+    myNbCandidates(0),
+    myNbTested(0),
+    myNbUnmeshed(0),
+    myBroadPhaseMs(0.0),
+    myNarrowPhaseMs(0.0),
+    myTolerance(0.0),
+    mySelected(-1)
+{
+}
+
+// ================================================================
+// Function : ~OcctClashDetector
+// Purpose  :
+// ================================================================
+OcctClashDetector::~OcctClashDetector()
+{
+    Cancel();
+    Wait();
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctClashDetector::Init(const Handle(AIS_InteractiveContext)& theCtx,
+                             const Handle(V3d_View)& theView)
+{
+    myContext = theCtx;
+    myView = theView;
+}
+
+// ================================================================
+// Function : Wait
+// Purpose  :
+// ================================================================
+void OcctClashDetector::Wait()
+{
+    if (myThread.joinable())
+    {
+        myThread.join();
+    }
+    myToCancel = false;
+}
+
+// ================================================================
+// Function : Start
+// Purpose  :
+// ================================================================
+void OcctClashDetector::Start(const OcctOutliner& theOutliner)
+{
+    if (myIsRunning || myContext.IsNull())
+    {
+        return;
+    }
+    Wait();
+
+    // shapes are collected on the GUI thread, the job only reads them
+    myParts.Clear();
+    AIS_ListOfInteractive anObjects;
+    myContext->DisplayedObjects(anObjects);
+    for (AIS_ListOfInteractive::Iterator anObjIter(anObjects); anObjIter.More(); anObjIter.Next())
+    {
+        Handle(AIS_Shape) aShapePrs = Handle(AIS_Shape)::DownCast(anObjIter.Value());
+        if (aShapePrs.IsNull() || aShapePrs->Shape().IsNull())
+        {
+            continue;
+        }
+
+        Part aPart;
+        aPart.Object = aShapePrs;
+        aPart.Shape = aShapePrs->HasTransformation()
+                    ? aShapePrs->Shape().Moved(TopLoc_Location(aShapePrs->Transformation()))
+                    : aShapePrs->Shape();
+        const int aNode = theOutliner.FindNode(aShapePrs);
+        aPart.Name = aNode != -1 && !theOutliner.Nodes()[aNode].Name.IsEmpty()
+                   ? theOutliner.Nodes()[aNode].Name
+                   : TCollection_AsciiString("Part ") + myParts.Length();
+        myParts.Append(aPart);
+    }
+
+    {
+        std::lock_guard<std::mutex> aLock(myMutex);
+        myClashes.clear();
+    }
+    mySelected = -1;
+    myNbCandidates = 0;
+    myNbTested = 0;
+    myNbUnmeshed = 0;
+    myIsRunning = true;
+    myThread = std::thread([this]() { perform(); });
+}
+
+// ================================================================
+// Function : findCandidates
+// Purpose  :
+// ================================================================
+void OcctClashDetector::findCandidates(NCollection_Vector<std::pair<int, int> >& thePairs) const
+{
+    std::vector<int> anOrder;
+    anOrder.reserve(myParts.Length());
+    for (int aPartIter = 0; aPartIter < myParts.Length(); ++aPartIter)
+    {
+        if (!myParts.Value(aPartIter).Box.IsVoid())
+        {
+            anOrder.push_back(aPartIter);
+        }
+    }
+    std::sort(anOrder.begin(), anOrder.end(), [this](int theLeft, int theRight)
+    {
+        return myParts.Value(theLeft).Box.CornerMin().X() < myParts.Value(theRight).Box.CornerMin().X();
+    });
+
+    for (size_t anIter = 0; anIter < anOrder.size(); ++anIter)
+    {
+        const Bnd_Box& aBox = myParts.Value(anOrder[anIter]).Box;
+        const Standard_Real aMaxX = aBox.CornerMax().X();
+        for (size_t aNextIter = anIter + 1; aNextIter < anOrder.size(); ++aNextIter)
+        {
+            const Bnd_Box& aNextBox = myParts.Value(anOrder[aNextIter]).Box;
+            if (aNextBox.CornerMin().X() > aMaxX)
+            {
+                break;
+            }
+            if (!aBox.IsOut(aNextBox))
+            {
+                thePairs.Append(std::make_pair(anOrder[anIter], anOrder[aNextIter]));
+            }
+        }
+    }
+}
+
+// ================================================================
+// Function : perform
+// Purpose  :
+// ================================================================
+void OcctClashDetector::perform()
+{
+    OSD_Timer aTimer;
+    aTimer.Start();
+
+    // broad phase
+    OSD_Parallel::For(0, myParts.Length(), [this](int theIndex)
+    {
+        Part& aPart = myParts.ChangeValue(theIndex);
+        BRepBndLib::Add(aPart.Shape, aPart.Box);
+        aPart.Box.Enlarge(0.5 * myTolerance);
+    });
+
+    NCollection_Vector<std::pair<int, int> > aPairs;
+    findCandidates(aPairs);
+    myNbCandidates = aPairs.Length();
+    myBroadPhaseMs = aTimer.ElapsedTime() * 1000.0;
+    aTimer.Reset();
+    aTimer.Start();
+
+    // per-part BVHs are built only for parts having candidates
+    NCollection_Vector<int> aUsedParts;
+    {
+        std::vector<bool> isUsed(myParts.Length(), false);
+        for (NCollection_Vector<std::pair<int, int> >::Iterator aPairIter(aPairs); aPairIter.More(); aPairIter.Next())
+        {
+            isUsed[aPairIter.Value().first] = true;
+            isUsed[aPairIter.Value().second] = true;
+        }
+        for (int aPartIter = 0; aPartIter < myParts.Length(); ++aPartIter)
+        {
+            if (isUsed[aPartIter])
+            {
+                aUsedParts.Append(aPartIter);
+            }
+        }
+    }
+    OSD_Parallel::For(0, aUsedParts.Length(), [&](int theIndex)
+    {
+        if (myToCancel)
+        {
+            return;
+        }
+
+        // faces without triangulation are skipped by the triangle set, such parts are reported
+        Part& aPart = myParts.ChangeValue(aUsedParts.Value(theIndex));
+        BRepExtrema_ShapeList aFaces;
+        bool isUnmeshed = false;
+        for (TopExp_Explorer anExp(aPart.Shape, TopAbs_FACE); anExp.More(); anExp.Next())
+        {
+            TopLoc_Location aLoc;
+            isUnmeshed |= BRep_Tool::Triangulation(TopoDS::Face(anExp.Current()), aLoc).IsNull();
+            aFaces.Append(anExp.Current());
+        }
+        if (isUnmeshed)
+        {
+            ++myNbUnmeshed;
+        }
+        aPart.Triangles = new BRepExtrema_TriangleSet(aFaces);
+        aPart.Triangles->BVH();
+    });
+
+    // narrow phase, clashes are published as soon as they are found
+    OSD_Parallel::For(0, aPairs.Length(), [&](int theIndex)
+    {
+        if (myToCancel)
+        {
+            return;
+        }
+
+        const std::pair<int, int>& aPair = aPairs.Value(theIndex);
+        const Handle(BRepExtrema_TriangleSet)& aSet1 = myParts.Value(aPair.first).Triangles;
+        const Handle(BRepExtrema_TriangleSet)& aSet2 = myParts.Value(aPair.second).Triangles;
+        if (!aSet1.IsNull() && aSet1->Size() != 0
+         && !aSet2.IsNull() && aSet2->Size() != 0)
+        {
+            BRepExtrema_OverlapTool anOverlap(aSet1, aSet2);
+            anOverlap.Perform(myTolerance);
+            if (anOverlap.IsDone()
+            && !anOverlap.OverlapSubShapes1().IsEmpty())
+            {
+                Clash aClash;
+                aClash.Part1 = aPair.first;
+                aClash.Part2 = aPair.second;
+                aClash.NbFaces1 = anOverlap.OverlapSubShapes1().Extent();
+                aClash.NbFaces2 = anOverlap.OverlapSubShapes2().Extent();
+
+                std::lock_guard<std::mutex> aLock(myMutex);
+                myClashes.push_back(aClash);
+            }
+        }
+        ++myNbTested;
+    });
+
+    // only boxes and results are needed afterwards, release triangle sets with their BVHs
+    for (NCollection_Vector<Part>::Iterator aPartIter(myParts); aPartIter.More(); aPartIter.Next())
+    {
+        aPartIter.ChangeValue().Triangles.Nullify();
+    }
+
+    myNarrowPhaseMs = aTimer.ElapsedTime() * 1000.0;
+    myIsRunning = false;
+}
+
+// ================================================================
+// Function : showClash
+// Purpose  :
+// ================================================================
+void OcctClashDetector::showClash(const Clash& theClash)
+{
+    const Part& aPart1 = myParts.Value(theClash.Part1);
+    const Part& aPart2 = myParts.Value(theClash.Part2);
+
+    myContext->ClearSelected(false);
+    myContext->AddOrRemoveSelected(aPart1.Object, false);
+    myContext->AddOrRemoveSelected(aPart2.Object, false);
+
+    Bnd_Box aBox = aPart1.Box;
+    aBox.Add(aPart2.Box);
+    myView->FitAll(aBox, 0.1, false);
+    myView->Invalidate();
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctClashDetector::RenderGui(const OcctOutliner& theOutliner)
+{
+    // join the finished or cancelled job on the GUI thread
+    if (!myIsRunning
+     && myThread.joinable())
+    {
+        Wait();
+    }
+
+    ImGui::Begin("Clash Detection");
+
+    ImGui::BeginDisabled(myIsRunning);
+    ImGui::InputDouble("Clearance", &myTolerance, 0.0, 0.0, "%.3f");
+    myTolerance = std::max(myTolerance, 0.0);
+    if (ImGui::Button("Run"))
+    {
+        Start(theOutliner);
+    }
+    ImGui::EndDisabled();
+    if (myIsRunning)
+    {
+        ImGui::SameLine();
+        ImGui::BeginDisabled(myToCancel);
+        if (ImGui::Button(myToCancel ? "Cancelling..." : "Cancel"))
+        {
+            Cancel();
+        }
+        ImGui::EndDisabled();
+    }
+
+    const int aNbCandidates = myNbCandidates;
+    const int aNbTested = myNbTested;
+    ImGui::ProgressBar(aNbCandidates > 0 ? float(aNbTested) / float(aNbCandidates) : 0.0f);
+    ImGui::Text("Parts: %d  candidate pairs: %d", myParts.Length(), aNbCandidates);
+    ImGui::Text("Broad phase: %.1f ms  narrow phase: %.1f ms", myBroadPhaseMs.load(), myNarrowPhaseMs.load());
+    ImGui::Text("Parts without triangulation: %d", (int)myNbUnmeshed);
+    ImGui::SameLine();
+    ImGui::TextDisabled("(unmeshed faces are not checked)");
+
+    std::lock_guard<std::mutex> aLock(myMutex);
+    ImGui::Text("Clashes: %d", (int)myClashes.size());
+    if (ImGui::BeginTable("##clashes", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Part A");
+        ImGui::TableSetupColumn("Part B");
+        ImGui::TableSetupColumn("Faces");
+        ImGui::TableHeadersRow();
+
+        ImGuiListClipper aClipper;
+        aClipper.Begin((int)myClashes.size());
+        while (aClipper.Step())
+        {
+            for (int aRow = aClipper.DisplayStart; aRow < aClipper.DisplayEnd; ++aRow)
+            {
+                const Clash& aClash = myClashes[aRow];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::PushID(aRow);
+                if (ImGui::Selectable(myParts.Value(aClash.Part1).Name.ToCString(), mySelected == aRow, ImGuiSelectableFlags_SpanAllColumns))
+                {
+                    mySelected = aRow;
+                    showClash(aClash);
+                }
+                ImGui::PopID();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(myParts.Value(aClash.Part2).Name.ToCString());
+                ImGui::TableNextColumn();
+                ImGui::Text("%d / %d", aClash.NbFaces1, aClash.NbFaces2);
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
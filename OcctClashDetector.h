@@ -0,0 +1,123 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctClashDetector_Header
+#define _OcctClashDetector_Header
+
+#include "OcctOutliner.h"
+
+#include <AIS_InteractiveContext.hxx>
+#include <BRepExtrema_TriangleSet.hxx>
+#include <Bnd_Box.hxx>
+#include <NCollection_Vector.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <V3d_View.hxx>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//! Interference detection between displayed parts.
+//! Candidate pairs come from a sweep-and-prune broad phase over part bounding boxes,
+//! exact triangle overlap tests run in parallel on a background job
+//! and found clashes are streamed into an ImGui table.
+class OcctClashDetector
+{
+public:
+    //! Part taking part in the check.
+    struct Part
+    {
+        Handle(AIS_InteractiveObject)   Object;
+        TopoDS_Shape                    Shape;    //!< shape in world coordinates
+        TCollection_AsciiString         Name;
+        Bnd_Box                         Box;
+        Handle(BRepExtrema_TriangleSet) Triangles; //!< triangle set, released once the check is over
+    };
+
+    //! Detected clash.
+    struct Clash
+    {
+        int Part1;
+        int Part2;
+        int NbFaces1; //!< number of overlapping faces of the first part
+        int NbFaces2; //!< number of overlapping faces of the second part
+    };
+
+public:
+    //! Default constructor.
+    OcctClashDetector();
+
+    //! Destructor, cancels the running job.
+    ~OcctClashDetector();
+
+    //! Attach the detector to the interactive context and view.
+    void Init(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theView);
+
+    //! Start the check over displayed shapes; parts are named after outliner nodes.
+    void Start(const OcctOutliner& theOutliner);
+
+    //! Request the running job to stop without waiting for it;
+    //! the finished job is joined by RenderGui() or Wait().
+    void Cancel() { myToCancel = true; }
+
+    //! Wait for the running job to finish.
+    void Wait();
+
+    //! Return true if the job is running.
+    bool IsRunning() const { return myIsRunning; }
+
+    //! Render the clash panel.
+    void RenderGui(const OcctOutliner& theOutliner);
+
+private:
+    //! Job entry point.
+    void perform();
+
+    //! Sweep-and-prune over X axis collecting pairs with overlapping boxes.
+    void findCandidates(NCollection_Vector<std::pair<int, int> >& thePairs) const;
+
+    //! Highlight the pair and fit it into the view.
+    void showClash(const Clash& theClash);
+
+private:
+    Handle(AIS_InteractiveContext) myContext;
+    Handle(V3d_View)               myView;
+    NCollection_Vector<Part>       myParts;
+    std::vector<Clash>             myClashes;       //!< found clashes, guarded by myMutex
+    std::mutex                     myMutex;
+    std::thread                    myThread;
+    std::atomic<bool>              myIsRunning;
+    std::atomic<bool>              myToCancel;
+    std::atomic<int>               myNbCandidates;
+    std::atomic<int>               myNbTested;
+    std::atomic<int>               myNbUnmeshed;    //!< candidate parts with faces lacking triangulation
+    std::atomic<double>            myBroadPhaseMs;
+    std::atomic<double>            myNarrowPhaseMs;
+    double                         myTolerance;     //!< clearance tolerance
+    int                            mySelected;
+};
+
+#endif // _OcctClashDetector_Header
@@ -0,0 +1,487 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#include "OcctGuiProfiler.h"
+
+#include "imgui/imgui.h"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    //! Frames rendered before measuring an upload path, letting buffers reach their final size.
+    const int THE_WARMUP_FRAMES = 30;
+
+    //! Display names of the upload paths.
+    const char* const THE_PATH_NAMES[] =
+    {
+        "glBufferData per draw list",
+        "Orphaning + map",
+        "Persistent ring"
+    };
+
+    //! Glyph ranges of the multi-language font: Latin, Greek, Cyrillic, Japanese, CJK ideograms and Hangul.
+    const ImWchar THE_MULTI_LANGUAGE_RANGES[] =
+    {
+        0x0020, 0x024F, // Basic Latin, Latin-1 Supplement, Latin Extended-A and B
+        0x0370, 0x03FF, // Greek and Coptic
+        0x0400, 0x052F, // Cyrillic and Cyrillic Supplement
+        0x2000, 0x206F, // General Punctuation
+        0x3000, 0x30FF, // CJK Symbols and Punctuation, Hiragana, Katakana
+        0x31F0, 0x31FF, // Katakana Phonetic Extensions
+        0x4E00, 0x9FAF, // CJK Unified Ideographs
+        0xAC00, 0xD7A3, // Hangul Syllables
+        0xFF00, 0xFFEF, // Half-width and Full-width Forms
+        0,
+    };
+
+    //! Flags of ImFontAtlas affecting the packing.
+    const ImFontAtlasFlags THE_PACKING_FLAGS = ImFontAtlasFlags_PackBestFit | ImFontAtlasFlags_NoPowerOfTwoHeight;
+
+    //! Add backend statistics.
+    void accumulate(ImGui_ImplOpenGL3_UploadStats& theAccum, const ImGui_ImplOpenGL3_UploadStats& theStats)
+    {
+        theAccum.RenderCalls    += theStats.RenderCalls;
+        theAccum.DrawLists      += theStats.DrawLists;
+        theAccum.BytesUploaded  += theStats.BytesUploaded;
+        theAccum.BytesAllocated += theStats.BytesAllocated;
+        theAccum.FenceStalls    += theStats.FenceStalls;
+        theAccum.DrawCommands   += theStats.DrawCommands;
+        theAccum.DrawCalls      += theStats.DrawCalls;
+        theAccum.UploadSeconds  += theStats.UploadSeconds;
+        theAccum.RenderSeconds  += theStats.RenderSeconds;
+    }
+}
+
+// ================================================================
+// Function : OcctGuiProfiler
+// Purpose  :
+// ================================================================
+OcctGuiProfiler::OcctGuiProfiler()
+    : myNbFrames(0),
+    myIsStressUi(false),
+    myStressRows(2000),
+    myStressLines(20000),
+    myBenchPath(-1),
+    myBenchShared(false),
+    myBenchFrame(0),
+    myBenchFrames(240),
+    myUserPath(ImGui_ImplOpenGL3_UploadPath_BufferData),
+    myUserShared(false),
+    myUserStressUi(false),
+    myFontSize(13.0f),
+    myToMergeFont(false),
+    myIsFontSingleChannel(true),
+    myToRecreateFontTexture(false)
+{
+    myFontPath[0] = '\0';
+    std::memset(&myAccum, 0, sizeof(myAccum));
+    std::memset(&myBenchAccum, 0, sizeof(myBenchAccum));
+    std::memset(&myLast, 0, sizeof(myLast));
+    mySampleTimer.Start();
+}
+
+// ================================================================
+// Function : average
+// Purpose  :
+// ================================================================
+OcctGuiProfiler::Sample OcctGuiProfiler::average(const ImGui_ImplOpenGL3_UploadStats& theStats, int theNbFrames)
+{
+    Sample aSample;
+    const double aNbFrames = theNbFrames > 0 ? double(theNbFrames) : 1.0;
+    aSample.BytesUploaded  = double(theStats.BytesUploaded) / aNbFrames;
+    aSample.BytesAllocated = double(theStats.BytesAllocated) / aNbFrames;
+    aSample.UploadMs       = theStats.UploadSeconds * 1000.0 / aNbFrames;
+    aSample.RenderMs       = theStats.RenderSeconds * 1000.0 / aNbFrames;
+    aSample.DrawCommands   = double(theStats.DrawCommands) / aNbFrames;
+    aSample.DrawCalls      = double(theStats.DrawCalls) / aNbFrames;
+    aSample.FenceStalls    = theStats.FenceStalls;
+    aSample.NbFrames       = theNbFrames;
+    aSample.Path           = ImGui_ImplOpenGL3_GetUploadPath();
+    aSample.IsShared       = ImGui_ImplOpenGL3_IsSharedContext();
+    return aSample;
+}
+
+// ================================================================
+// Function : startBenchmark
+// Purpose  :
+// ================================================================
+void OcctGuiProfiler::startBenchmark()
+{
+    myUserPath = ImGui_ImplOpenGL3_GetUploadPath();
+    myUserShared = ImGui_ImplOpenGL3_IsSharedContext();
+    myUserStressUi = myIsStressUi;
+    myIsStressUi = true;
+    myResults.clear();
+    myBenchPath = ImGui_ImplOpenGL3_UploadPath_BufferData;
+    myBenchShared = false;
+    applyBenchConfig();
+}
+
+// ================================================================
+// Function : applyBenchConfig
+// Purpose  :
+// ================================================================
+void OcctGuiProfiler::applyBenchConfig()
+{
+    myBenchPath = ImGui_ImplOpenGL3_SetUploadPath(myBenchPath);
+    ImGui_ImplOpenGL3_SetSharedContext(myBenchShared);
+    myBenchFrame = 0;
+    std::memset(&myBenchAccum, 0, sizeof(myBenchAccum));
+}
+
+// ================================================================
+// Function : measureAtlas
+// Purpose  :
+// ================================================================
+OcctGuiProfiler::AtlasSize OcctGuiProfiler::measureAtlas(const char* theName, ImFontAtlasFlags theFlags)
+{
+    const ImFontAtlas* aSrcAtlas = ImGui::GetIO().Fonts;
+    ImFontAtlas anAtlas;
+    anAtlas.Flags = (aSrcAtlas->Flags & ~THE_PACKING_FLAGS) | theFlags;
+    anAtlas.TexGlyphPadding = aSrcAtlas->TexGlyphPadding;
+    for (const ImFontConfig& aSrcCfg : aSrcAtlas->ConfigData)
+    {
+        // font data stays owned by the application atlas
+        ImFontConfig aCfg = aSrcCfg;
+        aCfg.FontDataOwnedByAtlas = false;
+        aCfg.DstFont = nullptr;
+        anAtlas.AddFont(&aCfg);
+    }
+    anAtlas.Build();
+
+    AtlasSize aSize;
+    aSize.Name   = theName;
+    aSize.Width  = anAtlas.TexWidth;
+    aSize.Height = anAtlas.TexHeight;
+    return aSize;
+}
+
+// ================================================================
+// Function : mergeFont
+// Purpose  :
+// ================================================================
+void OcctGuiProfiler::mergeFont()
+{
+    if (!std::ifstream(myFontPath).good())
+    {
+        myFontMessage = std::string("Cannot open ") + myFontPath;
+        return;
+    }
+
+    // glyphs missing in the font are skipped
+    ImFontConfig aCfg;
+    aCfg.MergeMode = true;
+    ImFontAtlas* anAtlas = ImGui::GetIO().Fonts;
+    if (anAtlas->Fonts.empty())
+    {
+        anAtlas->AddFontDefault();
+    }
+    if (anAtlas->AddFontFromFileTTF(myFontPath, myFontSize, &aCfg, THE_MULTI_LANGUAGE_RANGES) == nullptr)
+    {
+        myFontMessage = std::string("Cannot load ") + myFontPath;
+        return;
+    }
+
+    ImGui_ImplOpenGL3_DestroyFontsTexture();
+    ImGui_ImplOpenGL3_CreateFontsTexture();
+    myFontMessage = std::string("Merged ") + myFontPath;
+    myAtlasSizes.clear();
+}
+
+// ================================================================
+// Function : RenderStressUi
+// Purpose  :
+// ================================================================
+void OcctGuiProfiler::RenderStressUi()
+{
+    if (!myIsStressUi)
+    {
+        return;
+    }
+
+    myStressValues.resize(myStressRows, 0.5f);
+    ImGui::Begin("Stress UI");
+
+    // long polyline: many vertices in a single draw list
+    const ImVec2 aSize(ImGui::GetContentRegionAvail().x, 200.0f);
+    const ImVec2 aOrigin = ImGui::GetCursorScreenPos();
+    ImDrawList* aDrawList = ImGui::GetWindowDrawList();
+    const float aPhase = float(ImGui::GetTime());
+    ImVec2 aPrev(aOrigin.x, aOrigin.y + aSize.y * 0.5f);
+    for (int aSegIter = 1; aSegIter <= myStressLines; ++aSegIter)
+    {
+        const float aT = float(aSegIter) / float(myStressLines);
+        const ImVec2 aNext(aOrigin.x + aT * aSize.x,
+                           aOrigin.y + aSize.y * (0.5f + 0.45f * std::sin(aT * 200.0f + aPhase)));
+        aDrawList->AddLine(aPrev, aNext, IM_COL32(255, 200, 0, 255));
+        aPrev = aNext;
+    }
+    ImGui::Dummy(aSize);
+
+    // widget rows: many small draw commands and text
+    for (int aRowIter = 0; aRowIter < myStressRows; ++aRowIter)
+    {
+        ImGui::PushID(aRowIter);
+        ImGui::Text("Row %04d", aRowIter);
+        ImGui::SameLine();
+        ImGui::SmallButton("Button");
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(150.0f);
+        ImGui::SliderFloat("##value", &myStressValues[aRowIter], 0.0f, 1.0f);
+        ImGui::SameLine();
+        ImGui::ProgressBar(myStressValues[aRowIter], ImVec2(100.0f, 0.0f));
+        ImGui::PopID();
+    }
+    ImGui::End();
+}
+
+// ================================================================
+// Function : EndFrame
+// Purpose  :
+// ================================================================
+void OcctGuiProfiler::EndFrame()
+{
+    // the font texture is replaced between frames, as draw commands of the current frame refer to it
+    if (myToMergeFont)
+    {
+        myToMergeFont = false;
+        mergeFont();
+    }
+    if (myToRecreateFontTexture)
+    {
+        myToRecreateFontTexture = false;
+        ImGui_ImplOpenGL3_SetFontTextureSingleChannel(myIsFontSingleChannel);
+    }
+
+    ImGui_ImplOpenGL3_UploadStats aStats;
+    ImGui_ImplOpenGL3_GetUploadStats(&aStats, true);
+
+    accumulate(myAccum, aStats);
+    ++myNbFrames;
+    if (mySampleTimer.ElapsedTime() >= 1.0)
+    {
+        myLast = average(myAccum, myNbFrames);
+        std::memset(&myAccum, 0, sizeof(myAccum));
+        myNbFrames = 0;
+        mySampleTimer.Reset();
+        mySampleTimer.Start();
+    }
+
+    if (myBenchPath < 0)
+    {
+        return;
+    }
+
+    if (++myBenchFrame > THE_WARMUP_FRAMES)
+    {
+        accumulate(myBenchAccum, aStats);
+    }
+    if (myBenchFrame < THE_WARMUP_FRAMES + myBenchFrames)
+    {
+        return;
+    }
+
+    myResults.push_back(average(myBenchAccum, myBenchFrames));
+    if (!myBenchShared)
+    {
+        myBenchShared = true;
+        applyBenchConfig();
+        return;
+    }
+    if (myBenchPath < ImGui_ImplOpenGL3_GetBestUploadPath())
+    {
+        ++myBenchPath;
+        myBenchShared = false;
+        applyBenchConfig();
+        return;
+    }
+
+    myBenchPath = -1;
+    myIsStressUi = myUserStressUi;
+    ImGui_ImplOpenGL3_SetUploadPath(myUserPath);
+    ImGui_ImplOpenGL3_SetSharedContext(myUserShared);
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctGuiProfiler::RenderGui()
+{
+    ImGui::Begin("ImGui Renderer");
+
+    const ImGui_ImplOpenGL3_UploadPath aBestPath = ImGui_ImplOpenGL3_GetBestUploadPath();
+    ImGui::BeginDisabled(IsRunning());
+    int aPath = ImGui_ImplOpenGL3_GetUploadPath();
+    if (ImGui::BeginCombo("Upload path", THE_PATH_NAMES[aPath]))
+    {
+        for (int aPathIter = 0; aPathIter <= ImGui_ImplOpenGL3_UploadPath_Persistent; ++aPathIter)
+        {
+            ImGui::BeginDisabled(aPathIter > aBestPath);
+            if (ImGui::Selectable(THE_PATH_NAMES[aPathIter], aPathIter == aPath))
+            {
+                ImGui_ImplOpenGL3_SetUploadPath(aPathIter);
+            }
+            ImGui::EndDisabled();
+        }
+        ImGui::EndCombo();
+    }
+    bool isShared = ImGui_ImplOpenGL3_IsSharedContext();
+    if (ImGui::Checkbox("Shared GL context (no state backup)", &isShared))
+    {
+        ImGui_ImplOpenGL3_SetSharedContext(isShared);
+    }
+    bool isBatching = ImGui_ImplOpenGL3_GetDrawBatching();
+    if (ImGui::Checkbox("Batch draw commands", &isBatching))
+    {
+        ImGui_ImplOpenGL3_SetDrawBatching(isBatching);
+    }
+    ImGui::EndDisabled();
+
+    ImGui::SeparatorText("Per frame");
+    ImGui::Text("Uploaded:  %.1f KB", myLast.BytesUploaded / 1024.0);
+    ImGui::Text("Allocated: %.1f KB", myLast.BytesAllocated / 1024.0);
+    ImGui::Text("Upload CPU: %.3f ms", myLast.UploadMs);
+    ImGui::Text("Render CPU: %.3f ms", myLast.RenderMs);
+    ImGui::Text("Draw commands: %.0f, draw calls: %.0f", myLast.DrawCommands, myLast.DrawCalls);
+    if (aPath == ImGui_ImplOpenGL3_UploadPath_Persistent)
+    {
+        ImGui::Text("Fence stalls: %d in %d frames", myLast.FenceStalls, myLast.NbFrames);
+    }
+
+    ImGui::SeparatorText("Heavy UI");
+    ImGui::BeginDisabled(IsRunning());
+    ImGui::Checkbox("Show", &myIsStressUi);
+    ImGui::EndDisabled();
+    ImGui::SliderInt("Widget rows", &myStressRows, 100, 10000);
+    ImGui::SliderInt("Line segments", &myStressLines, 1000, 200000);
+
+    ImGui::SeparatorText("Benchmark");
+    if (IsRunning())
+    {
+        ImGui::Text("Measuring \"%s\"%s: frame %d of %d", THE_PATH_NAMES[myBenchPath],
+                    myBenchShared ? ", shared context" : "", myBenchFrame, THE_WARMUP_FRAMES + myBenchFrames);
+    }
+    else
+    {
+        ImGui::SliderInt("Frames per path", &myBenchFrames, 60, 1200);
+        if (ImGui::Button("Run with heavy UI"))
+        {
+            startBenchmark();
+        }
+    }
+    if (!myResults.empty()
+     && ImGui::BeginTable("##results", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+    {
+        ImGui::TableSetupColumn("Path");
+        ImGui::TableSetupColumn("GL state");
+        ImGui::TableSetupColumn("Uploaded, KB");
+        ImGui::TableSetupColumn("Allocated, KB");
+        ImGui::TableSetupColumn("Upload, ms");
+        ImGui::TableSetupColumn("Render, ms");
+        ImGui::TableSetupColumn("Commands");
+        ImGui::TableSetupColumn("Draw calls");
+        ImGui::TableHeadersRow();
+        for (const Sample& aRes : myResults)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(THE_PATH_NAMES[aRes.Path]);
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(aRes.IsShared ? "shared" : "backup/restore");
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", aRes.BytesUploaded / 1024.0);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", aRes.BytesAllocated / 1024.0);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", aRes.UploadMs);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", aRes.RenderMs);
+            ImGui::TableNextColumn(); ImGui::Text("%.0f", aRes.DrawCommands);
+            ImGui::TableNextColumn(); ImGui::Text("%.0f", aRes.DrawCalls);
+        }
+        ImGui::EndTable();
+    }
+    for (size_t aResIter = 0; aResIter + 1 < myResults.size(); ++aResIter)
+    {
+        const Sample& aBackup = myResults[aResIter];
+        const Sample& aShared = myResults[aResIter + 1];
+        if (!aBackup.IsShared && aShared.IsShared && aBackup.Path == aShared.Path)
+        {
+            ImGui::Text("%s: shared context saves %.3f ms per frame", THE_PATH_NAMES[aBackup.Path],
+                        aBackup.RenderMs - aShared.RenderMs);
+        }
+    }
+
+    ImGui::SeparatorText("Font atlas");
+    ImGui_ImplOpenGL3_FontTextureInfo aTexInfo;
+    if (ImGui_ImplOpenGL3_GetFontTextureInfo(&aTexInfo))
+    {
+        ImGui::Text("Texture: %d x %d %s, %.1f KB (%.1f KB as RGBA32)", aTexInfo.Width, aTexInfo.Height,
+                    aTexInfo.IsSingleChannel ? "R8" : "RGBA32", double(aTexInfo.Bytes) / 1024.0,
+                    double(aTexInfo.Width) * aTexInfo.Height * 4.0 / 1024.0);
+    }
+    ImGui::Text("Glyphs: %d in %d font(s)", ImGui::GetIO().Fonts->Fonts.empty() ? 0 : ImGui::GetIO().Fonts->Fonts[0]->Glyphs.Size,
+                ImGui::GetIO().Fonts->ConfigData.Size);
+    if (ImGui::Checkbox("Single channel texture", &myIsFontSingleChannel))
+    {
+        myToRecreateFontTexture = true;
+    }
+    ImGui::InputTextWithHint("Font file", "TTF/OTF with CJK glyphs", myFontPath, sizeof(myFontPath));
+    ImGui::SliderFloat("Font size", &myFontSize, 8.0f, 32.0f, "%.0f");
+    ImGui::BeginDisabled(myFontPath[0] == '\0');
+    if (ImGui::Button("Merge multi-language glyphs"))
+    {
+        myToMergeFont = true;
+    }
+    ImGui::EndDisabled();
+    if (!myFontMessage.empty())
+    {
+        ImGui::TextUnformatted(myFontMessage.c_str());
+    }
+    if (ImGui::Button("Compare packers"))
+    {
+        myAtlasSizes.clear();
+        myAtlasSizes.push_back(measureAtlas("Skyline, power-of-two height", ImFontAtlasFlags_None));
+        myAtlasSizes.push_back(measureAtlas("Best fit, power-of-two height", ImFontAtlasFlags_PackBestFit));
+        myAtlasSizes.push_back(measureAtlas("Best fit, exact height", THE_PACKING_FLAGS));
+    }
+    if (!myAtlasSizes.empty()
+     && ImGui::BeginTable("##atlas", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+    {
+        ImGui::TableSetupColumn("Packer");
+        ImGui::TableSetupColumn("Size");
+        ImGui::TableSetupColumn("R8, KB");
+        ImGui::TableSetupColumn("RGBA32, KB");
+        ImGui::TableHeadersRow();
+        for (const AtlasSize& aSize : myAtlasSizes)
+        {
+            const double aNbPixels = double(aSize.Width) * aSize.Height;
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(aSize.Name);
+            ImGui::TableNextColumn(); ImGui::Text("%d x %d", aSize.Width, aSize.Height);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", aNbPixels / 1024.0);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", aNbPixels * 4.0 / 1024.0);
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
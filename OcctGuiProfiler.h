@@ -0,0 +1,127 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#ifndef _OcctGuiProfiler_Header
+#define _OcctGuiProfiler_Header
+
+#include "imgui/imgui_impl_opengl3.h"
+
+#include <OSD_Timer.hxx>
+
+#include <string>
+#include <vector>
+
+//! Profiler of the ImGui renderer backend.
+//! Shows per-frame averages of the bytes uploaded and allocated for vertex/index data
+//! and of the CPU time spent in ImGui_ImplOpenGL3_RenderDrawData(), lets the upload path
+//! the shared context mode (no GL state backup/restore) and draw command batching be switched,
+//! and benchmarks all supported combinations in turn against an optional heavy UI.
+//! The font atlas section reports the font texture size and format, can merge a multi-language font
+//! and compares the atlas size given by the default and best-fit glyph packers.
+class OcctGuiProfiler
+{
+public:
+    //! Default constructor.
+    OcctGuiProfiler();
+
+    //! Return true while the benchmark runs, so that frames are rendered without waiting for events.
+    bool IsRunning() const { return myBenchPath >= 0; }
+
+    //! Render the heavy UI if enabled, to be called within the ImGui frame.
+    void RenderStressUi();
+
+    //! Collect backend statistics after the ImGui draw data has been rendered.
+    void EndFrame();
+
+    //! Render the profiler panel.
+    void RenderGui();
+
+private:
+    //! Per-frame averages of backend statistics.
+    struct Sample
+    {
+        double BytesUploaded;
+        double BytesAllocated;
+        double UploadMs;
+        double RenderMs;
+        double DrawCommands;
+        double DrawCalls;
+        int    FenceStalls;
+        int    NbFrames;
+        int    Path;
+        bool   IsShared;
+    };
+
+    //! Font atlas size given by a packer.
+    struct AtlasSize
+    {
+        const char* Name;
+        int         Width;
+        int         Height;
+    };
+
+    //! Build a copy of the current font atlas with the given packing flags and return its size.
+    static AtlasSize measureAtlas(const char* theName, ImFontAtlasFlags theFlags);
+
+    //! Merge glyphs of the font file into the default font and recreate the font texture.
+    //! Should be called between frames, while the atlas is not locked.
+    void mergeFont();
+
+    //! Average accumulated statistics per frame.
+    static Sample average(const ImGui_ImplOpenGL3_UploadStats& theStats, int theNbFrames);
+
+    //! Start the benchmark from the first upload path.
+    void startBenchmark();
+
+    //! Apply the benchmark configuration under test.
+    void applyBenchConfig();
+
+private:
+    ImGui_ImplOpenGL3_UploadStats myAccum;       //!< statistics since the last sample
+    ImGui_ImplOpenGL3_UploadStats myBenchAccum;  //!< statistics of the upload path under test
+    int                           myNbFrames;    //!< frames since the last sample
+    OSD_Timer                     mySampleTimer;
+    Sample                        myLast;        //!< averages over the last second
+    bool                          myIsStressUi;
+    int                           myStressRows;  //!< widget rows of the heavy UI
+    int                           myStressLines; //!< polyline segments of the heavy UI
+    std::vector<float>            myStressValues;
+    int                           myBenchPath;   //!< upload path under test, -1 if not running
+    bool                          myBenchShared; //!< shared context mode under test
+    int                           myBenchFrame;  //!< frame within the current path
+    int                           myBenchFrames; //!< measured frames per path
+    ImGui_ImplOpenGL3_UploadPath  myUserPath;    //!< path restored after the benchmark
+    bool                          myUserShared;  //!< shared context mode restored after the benchmark
+    bool                          myUserStressUi;
+    std::vector<Sample>           myResults;     //!< benchmark results per upload path
+    char                          myFontPath[512];
+    float                         myFontSize;
+    std::string                   myFontMessage; //!< result of the last font merge
+    bool                          myToMergeFont; //!< merge the font at the end of the frame
+    bool                          myIsFontSingleChannel;
+    bool                          myToRecreateFontTexture;
+    std::vector<AtlasSize>        myAtlasSizes;  //!< packer comparison for the current fonts
+};
+
+#endif // _OcctGuiProfiler_Header
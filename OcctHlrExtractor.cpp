@@ -0,0 +1,588 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctHlrExtractor.h"
+
+#include "imgui/imgui.h"
+
+#include <AIS_InteractiveObject.hxx>
+#include <AIS_Shape.hxx>
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepLib.hxx>
+#include <GCPnts_TangentialDeflection.hxx>
+#include <Graphic3d_ArrayOfPolylines.hxx>
+#include <Graphic3d_AspectLine3d.hxx>
+#include <HLRBRep_Algo.hxx>
+#include <HLRBRep_HLRToShape.hxx>
+#include <HLRBRep_PolyAlgo.hxx>
+#include <HLRBRep_PolyHLRToShape.hxx>
+#include <Message.hxx>
+#include <Message_Messenger.hxx>
+#include <OSD_Parallel.hxx>
+#include <Prs3d_Presentation.hxx>
+#include <Standard_Failure.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+    const char* THE_MODE_NAMES[] = { "Exact (HLRBRep_Algo)", "Polygonal (HLRBRep_PolyAlgo)" };
+
+    //! Add the shape to the compound, skipping empty results.
+    void addToCompound(const TopoDS_Shape& theShape, BRep_Builder& theBuilder, TopoDS_Compound& theCompound)
+    {
+        if (!theShape.IsNull())
+        {
+            theBuilder.Add(theCompound, theShape);
+        }
+    }
+
+    //! Collect sharp edges and silhouettes, skipping smooth edges as drawings usually do.
+    template<typename ToShape>
+    void collectLines(ToShape& theToShape, TopoDS_Compound& theVisible, TopoDS_Compound& theHidden)
+    {
+        BRep_Builder aBuilder;
+        aBuilder.MakeCompound(theVisible);
+        aBuilder.MakeCompound(theHidden);
+        addToCompound(theToShape.VCompound(), aBuilder, theVisible);
+        addToCompound(theToShape.OutLineVCompound(), aBuilder, theVisible);
+        addToCompound(theToShape.HCompound(), aBuilder, theHidden);
+        addToCompound(theToShape.OutLineHCompound(), aBuilder, theHidden);
+    }
+
+    //! Discretize edges lying in the projection plane into polylines.
+    void discretize(const TopoDS_Shape& theEdges, double theDeflection, OcctHlrExtractor::Lines& theLines)
+    {
+        // polygonal results may carry only 2D curves
+        BRepLib::BuildCurves3d(theEdges);
+        for (TopExp_Explorer anExp(theEdges, TopAbs_EDGE); anExp.More(); anExp.Next())
+        {
+            const TopoDS_Edge& anEdge = TopoDS::Edge(anExp.Current());
+            if (BRep_Tool::Degenerated(anEdge)
+            || !BRep_Tool::IsGeometric(anEdge))
+            {
+                continue;
+            }
+
+            BRepAdaptor_Curve aCurve(anEdge);
+            theLines.Starts.push_back((int)theLines.XY.size() / 2);
+            if (aCurve.GetType() == GeomAbs_Line)
+            {
+                const gp_Pnt aFirst = aCurve.Value(aCurve.FirstParameter());
+                const gp_Pnt aLast  = aCurve.Value(aCurve.LastParameter());
+                theLines.XY.insert(theLines.XY.end(), { (float)aFirst.X(), (float)aFirst.Y(), (float)aLast.X(), (float)aLast.Y() });
+                continue;
+            }
+
+            GCPnts_TangentialDeflection aPoints(aCurve, 0.2, theDeflection);
+            for (int aPntIter = 1; aPntIter <= aPoints.NbPoints(); ++aPntIter)
+            {
+                const gp_Pnt aPnt = aPoints.Value(aPntIter);
+                theLines.XY.push_back((float)aPnt.X());
+                theLines.XY.push_back((float)aPnt.Y());
+            }
+        }
+    }
+
+    //! Append polylines of theFrom to theTo.
+    void appendLines(const OcctHlrExtractor::Lines& theFrom, OcctHlrExtractor::Lines& theTo)
+    {
+        const int anOffset = (int)theTo.XY.size() / 2;
+        for (int aStart : theFrom.Starts)
+        {
+            theTo.Starts.push_back(aStart + anOffset);
+        }
+        theTo.XY.insert(theTo.XY.end(), theFrom.XY.begin(), theFrom.XY.end());
+    }
+
+    //! Build polylines placed back into the world on the projection plane.
+    Handle(Graphic3d_ArrayOfPolylines) toPolylines(const OcctHlrExtractor::Lines& theLines, const gp_Trsf& theToWorld)
+    {
+        if (theLines.Starts.empty())
+        {
+            return Handle(Graphic3d_ArrayOfPolylines)();
+        }
+
+        Handle(Graphic3d_ArrayOfPolylines) anArray = new Graphic3d_ArrayOfPolylines((int)theLines.XY.size() / 2, theLines.NbPolylines());
+        for (int aLineIter = 0; aLineIter < theLines.NbPolylines(); ++aLineIter)
+        {
+            const int anEnd = theLines.PolylineEnd(aLineIter);
+            anArray->AddBound(anEnd - theLines.Starts[aLineIter]);
+            for (int aPntIter = theLines.Starts[aLineIter]; aPntIter < anEnd; ++aPntIter)
+            {
+                anArray->AddVertex(gp_Pnt(theLines.XY[aPntIter * 2], theLines.XY[aPntIter * 2 + 1], 0.0).Transformed(theToWorld));
+            }
+        }
+        return anArray;
+    }
+
+    //! Overlay of visible and hidden lines.
+    class OcctHlrPrs : public AIS_InteractiveObject
+    {
+        DEFINE_STANDARD_RTTI_INLINE(OcctHlrPrs, AIS_InteractiveObject)
+    public:
+        OcctHlrPrs(const Handle(Graphic3d_ArrayOfPolylines)& theVisible,
+                   const Handle(Graphic3d_ArrayOfPolylines)& theHidden)
+            : myVisible(theVisible),
+            myHidden(theHidden)
+        {
+        }
+
+        virtual Standard_Boolean AcceptDisplayMode(const Standard_Integer theMode) const Standard_OVERRIDE { return theMode == 0; }
+
+    protected:
+        virtual void Compute(const Handle(PrsMgr_PresentationManager)& ,
+                             const Handle(Prs3d_Presentation)& thePrs,
+                             const Standard_Integer ) Standard_OVERRIDE
+        {
+            if (!myVisible.IsNull())
+            {
+                Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
+                aGroup->SetGroupPrimitivesAspect(new Graphic3d_AspectLine3d(Quantity_NOC_WHITE, Aspect_TOL_SOLID, 2.0));
+                aGroup->AddPrimitiveArray(myVisible);
+            }
+            if (!myHidden.IsNull())
+            {
+                Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
+                aGroup->SetGroupPrimitivesAspect(new Graphic3d_AspectLine3d(Quantity_NOC_GRAY50, Aspect_TOL_DASH, 1.0));
+                aGroup->AddPrimitiveArray(myHidden);
+            }
+        }
+
+        virtual void ComputeSelection(const Handle(SelectMgr_Selection)& ,
+                                      const Standard_Integer ) Standard_OVERRIDE {}
+
+    private:
+        Handle(Graphic3d_ArrayOfPolylines) myVisible;
+        Handle(Graphic3d_ArrayOfPolylines) myHidden;
+    };
+}
+
+// ================================================================
+// Function : OcctHlrExtractor
+// Purpose  :
+// ================================================================
+OcctHlrExtractor::OcctHlrExtractor()
+    : myIsRunning(false),
+    myToCancel(false),
+    myNbDone(0),
+    myNbFailed(0),
+    myMode(HlrMode_Polygonal),
+    myIsPerPart(false),
+    myToShowHidden(false),
+    myToShowOverlay(true),
+    myJobSeconds(0.0)
+{
+    strcpy(myPathBuffer, "drawing.svg");
+}
+
+// ================================================================
+// Function : ~OcctHlrExtractor
+// Purpose  :
+// ================================================================
+OcctHlrExtractor::~OcctHlrExtractor()
+{
+    Cancel();
+    Wait();
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctHlrExtractor::Init(const Handle(AIS_InteractiveContext)& theCtx,
+                            const Handle(V3d_View)& theView)
+{
+    myContext = theCtx;
+    myView = theView;
+}
+
+// ================================================================
+// Function : Wait
+// Purpose  :
+// ================================================================
+void OcctHlrExtractor::Wait()
+{
+    if (myThread.joinable())
+    {
+        myThread.join();
+    }
+    myToCancel = false;
+    myIsRunning = false;
+    myParts.clear();
+    myResults.clear();
+}
+
+// ================================================================
+// Function : Start
+// Purpose  :
+// ================================================================
+void OcctHlrExtractor::Start()
+{
+    if (IsRunning() || myContext.IsNull())
+    {
+        return;
+    }
+
+    // shapes are collected on the GUI thread, the job only reads them
+    BRep_Builder aBuilder;
+    TopoDS_Compound anAssembly;
+    aBuilder.MakeCompound(anAssembly);
+    AIS_ListOfInteractive anObjects;
+    myContext->DisplayedObjects(anObjects);
+    for (AIS_ListOfInteractive::Iterator anObjIter(anObjects); anObjIter.More(); anObjIter.Next())
+    {
+        Handle(AIS_Shape) aShapePrs = Handle(AIS_Shape)::DownCast(anObjIter.Value());
+        if (aShapePrs.IsNull() || aShapePrs->Shape().IsNull())
+        {
+            continue;
+        }
+
+        const TopoDS_Shape aShape = aShapePrs->HasTransformation()
+                                  ? aShapePrs->Shape().Moved(TopLoc_Location(aShapePrs->Transformation()))
+                                  : aShapePrs->Shape();
+        if (myIsPerPart)
+        {
+            myParts.push_back(aShape);
+        }
+        else
+        {
+            aBuilder.Add(anAssembly, aShape);
+        }
+    }
+    if (!myIsPerPart)
+    {
+        myParts.push_back(anAssembly);
+    }
+
+    // projection plane passes through the camera center, so the overlay matches the view it was made for
+    const Handle(Graphic3d_Camera)& aCamera = myView->Camera();
+    const gp_Ax2 aPlane(aCamera->Center(), aCamera->Direction().Reversed(), aCamera->Direction().Crossed(aCamera->Up()));
+    myProjector = aCamera->IsOrthographic()
+                ? HLRAlgo_Projector(aPlane)
+                : HLRAlgo_Projector(aPlane, aCamera->Distance());
+    myToWorld.SetTransformation(gp_Ax3(aPlane));
+    myToWorld.Invert();
+
+    myResults.assign(myParts.size(), PartResult());
+    myNbDone = 0;
+    myNbFailed = 0;
+    myTimer.Reset();
+    myTimer.Start();
+    myIsRunning = true;
+    myThread = std::thread([this]() { perform(); });
+}
+
+// ================================================================
+// Function : perform
+// Purpose  :
+// ================================================================
+void OcctHlrExtractor::perform()
+{
+    const HlrMode aMode = myMode;
+    OSD_Parallel::For(0, (int)myParts.size(), [this, aMode](int theIndex)
+    {
+        PartResult& aResult = myResults[theIndex];
+        aResult.IsFailed = false;
+        if (myToCancel)
+        {
+            return;
+        }
+
+        try
+        {
+            const TopoDS_Shape& aShape = myParts[theIndex];
+            TopoDS_Compound aVisible, aHidden;
+            if (aMode == HlrMode_Exact)
+            {
+                Handle(HLRBRep_Algo) anAlgo = new HLRBRep_Algo();
+                anAlgo->Add(aShape);
+                anAlgo->Projector(myProjector);
+                anAlgo->Update();
+                anAlgo->Hide();
+                HLRBRep_HLRToShape aToShape(anAlgo);
+                collectLines(aToShape, aVisible, aHidden);
+            }
+            else
+            {
+                Handle(HLRBRep_PolyAlgo) anAlgo = new HLRBRep_PolyAlgo();
+                anAlgo->Load(aShape);
+                anAlgo->Projector(myProjector);
+                anAlgo->Update();
+                HLRBRep_PolyHLRToShape aToShape;
+                aToShape.Update(anAlgo);
+                collectLines(aToShape, aVisible, aHidden);
+            }
+
+            Bnd_Box aBox;
+            BRepBndLib::Add(aShape, aBox);
+            const double aDeflection = aBox.IsVoid() ? 0.01 : 0.001 * std::sqrt(aBox.SquareExtent());
+            discretize(aVisible, aDeflection, aResult.Visible);
+            discretize(aHidden, aDeflection, aResult.Hidden);
+        }
+        catch (const Standard_Failure&)
+        {
+            aResult.IsFailed = true;
+            ++myNbFailed;
+        }
+        ++myNbDone;
+    });
+    myIsRunning = false;
+}
+
+// ================================================================
+// Function : finish
+// Purpose  :
+// ================================================================
+void OcctHlrExtractor::finish()
+{
+    myThread.join();
+    myTimer.Stop();
+    myJobSeconds = myTimer.ElapsedTime();
+
+    myVisible = Lines();
+    myHidden = Lines();
+    for (const PartResult& aResult : myResults)
+    {
+        appendLines(aResult.Visible, myVisible);
+        appendLines(aResult.Hidden, myHidden);
+    }
+    myParts.clear();
+    myResults.clear();
+    updateOverlay();
+}
+
+// ================================================================
+// Function : updateOverlay
+// Purpose  :
+// ================================================================
+void OcctHlrExtractor::updateOverlay()
+{
+    if (!myOverlay.IsNull())
+    {
+        myContext->Remove(myOverlay, false);
+        myOverlay.Nullify();
+    }
+    if (myToShowOverlay
+    && !myVisible.Starts.empty())
+    {
+        myOverlay = new OcctHlrPrs(toPolylines(myVisible, myToWorld),
+                                   myToShowHidden ? toPolylines(myHidden, myToWorld) : Handle(Graphic3d_ArrayOfPolylines)());
+        myOverlay->SetZLayer(Graphic3d_ZLayerId_Topmost);
+        myContext->Display(myOverlay, 0, -1, false);
+    }
+    myView->Invalidate();
+}
+
+// ================================================================
+// Function : ExportSvg
+// Purpose  :
+// ================================================================
+bool OcctHlrExtractor::ExportSvg(const TCollection_AsciiString& thePath) const
+{
+    std::ofstream aFile(thePath.ToCString());
+    if (!aFile)
+    {
+        return false;
+    }
+
+    float aMin[2] = { FLT_MAX, FLT_MAX }, aMax[2] = { -FLT_MAX, -FLT_MAX };
+    for (size_t aCoordIter = 0; aCoordIter < myVisible.XY.size(); ++aCoordIter)
+    {
+        aMin[aCoordIter % 2] = std::min(aMin[aCoordIter % 2], myVisible.XY[aCoordIter]);
+        aMax[aCoordIter % 2] = std::max(aMax[aCoordIter % 2], myVisible.XY[aCoordIter]);
+    }
+    if (aMin[0] > aMax[0])
+    {
+        aMin[0] = aMin[1] = 0.0f;
+        aMax[0] = aMax[1] = 1.0f;
+    }
+
+    // SVG Y axis points down, so Y coordinates are negated
+    const float aSize = std::max(aMax[0] - aMin[0], aMax[1] - aMin[1]);
+    const float aMargin = 0.02f * aSize;
+    char aBuffer[256];
+    snprintf(aBuffer, sizeof(aBuffer), "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"%g %g %g %g\">\n",
+             aMin[0] - aMargin, -aMax[1] - aMargin, aMax[0] - aMin[0] + 2.0f * aMargin, aMax[1] - aMin[1] + 2.0f * aMargin);
+    aFile << aBuffer;
+
+    auto aWriteGroup = [&](const Lines& theLines, const char* theStyle)
+    {
+        aFile << "<g fill=\"none\" stroke-linecap=\"round\" " << theStyle << ">\n";
+        for (int aLineIter = 0; aLineIter < theLines.NbPolylines(); ++aLineIter)
+        {
+            aFile << "<path d=\"";
+            const int anEnd = theLines.PolylineEnd(aLineIter);
+            for (int aPntIter = theLines.Starts[aLineIter]; aPntIter < anEnd; ++aPntIter)
+            {
+                snprintf(aBuffer, sizeof(aBuffer), "%c%g %g", aPntIter == theLines.Starts[aLineIter] ? 'M' : 'L',
+                         theLines.XY[aPntIter * 2], -theLines.XY[aPntIter * 2 + 1]);
+                aFile << aBuffer;
+            }
+            aFile << "\"/>\n";
+        }
+        aFile << "</g>\n";
+    };
+    if (myToShowHidden)
+    {
+        snprintf(aBuffer, sizeof(aBuffer), "stroke=\"gray\" stroke-width=\"%g\" stroke-dasharray=\"%g %g\"",
+                 aSize * 0.001f, aSize * 0.005f, aSize * 0.003f);
+        aWriteGroup(myHidden, aBuffer);
+    }
+    snprintf(aBuffer, sizeof(aBuffer), "stroke=\"black\" stroke-width=\"%g\"", aSize * 0.002f);
+    aWriteGroup(myVisible, aBuffer);
+    aFile << "</svg>\n";
+    return aFile.good();
+}
+
+// ================================================================
+// Function : ExportDxf
+// Purpose  :
+// ================================================================
+bool OcctHlrExtractor::ExportDxf(const TCollection_AsciiString& thePath) const
+{
+    std::ofstream aFile(thePath.ToCString());
+    if (!aFile)
+    {
+        return false;
+    }
+
+    char aBuffer[256];
+    auto aWriteLayer = [&](const Lines& theLines, const char* theLayer)
+    {
+        for (int aLineIter = 0; aLineIter < theLines.NbPolylines(); ++aLineIter)
+        {
+            const int anEnd = theLines.PolylineEnd(aLineIter);
+            for (int aPntIter = theLines.Starts[aLineIter] + 1; aPntIter < anEnd; ++aPntIter)
+            {
+                snprintf(aBuffer, sizeof(aBuffer), "0\nLINE\n8\n%s\n10\n%g\n20\n%g\n30\n0\n11\n%g\n21\n%g\n31\n0\n", theLayer,
+                         theLines.XY[aPntIter * 2 - 2], theLines.XY[aPntIter * 2 - 1],
+                         theLines.XY[aPntIter * 2], theLines.XY[aPntIter * 2 + 1]);
+                aFile << aBuffer;
+            }
+        }
+    };
+    aFile << "0\nSECTION\n2\nENTITIES\n";
+    aWriteLayer(myVisible, "VISIBLE");
+    if (myToShowHidden)
+    {
+        aWriteLayer(myHidden, "HIDDEN");
+    }
+    aFile << "0\nENDSEC\n0\nEOF\n";
+    return aFile.good();
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctHlrExtractor::RenderGui()
+{
+    // merge results on the GUI thread once the job is over, results of a cancelled job are dropped
+    if (!myIsRunning
+     && myThread.joinable())
+    {
+        if (myToCancel)
+        {
+            Wait();
+        }
+        else
+        {
+            finish();
+        }
+    }
+
+    ImGui::Begin("Drawing");
+    ImGui::BeginDisabled(myIsRunning);
+    int aMode = myMode;
+    if (ImGui::Combo("Algorithm", &aMode, THE_MODE_NAMES, IM_ARRAYSIZE(THE_MODE_NAMES)))
+    {
+        myMode = (HlrMode)aMode;
+    }
+    ImGui::Checkbox("Split per part (approximate)", &myIsPerPart);
+    ImGui::SameLine();
+    ImGui::TextDisabled(myIsPerPart ? "(parts do not hide each other)" : "(single job, parts hide each other)");
+    ImGui::EndDisabled();
+
+    if (myIsRunning)
+    {
+        const int aNbJobs = (int)myParts.size();
+        char aLabel[64];
+        snprintf(aLabel, sizeof(aLabel), "%d / %d parts", (int)myNbDone, aNbJobs);
+        ImGui::ProgressBar(aNbJobs > 0 ? float(myNbDone) / float(aNbJobs) : 0.0f, ImVec2(-80.0f, 0.0f), aLabel);
+        ImGui::SameLine();
+        ImGui::BeginDisabled(myToCancel);
+        if (ImGui::Button(myToCancel ? "Cancelling..." : "Cancel", ImVec2(-1.0f, 0.0f)))
+        {
+            Cancel();
+        }
+        ImGui::EndDisabled();
+        ImGui::Text("Elapsed: %.1f s", myTimer.ElapsedTime());
+    }
+    else if (ImGui::Button("Extract for current view"))
+    {
+        Start();
+    }
+
+    bool toUpdate = ImGui::Checkbox("Show overlay", &myToShowOverlay);
+    ImGui::SameLine();
+    toUpdate |= ImGui::Checkbox("Hidden lines", &myToShowHidden);
+    if (toUpdate)
+    {
+        updateOverlay();
+    }
+
+    ImGui::SeparatorText("Export");
+    ImGui::InputText("File", myPathBuffer, sizeof(myPathBuffer));
+    ImGui::BeginDisabled(myIsRunning || myVisible.Starts.empty());
+    bool isExported = true;
+    if (ImGui::Button("SVG"))
+    {
+        isExported = ExportSvg(myPathBuffer);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("DXF"))
+    {
+        isExported = ExportDxf(myPathBuffer);
+    }
+    ImGui::EndDisabled();
+    if (!isExported)
+    {
+        Message::DefaultMessenger()->Send(TCollection_AsciiString("Unable to write '") + myPathBuffer + "'", Message_Fail);
+    }
+
+    ImGui::SeparatorText("Statistics");
+    ImGui::Text("Visible polylines: %d  hidden: %d", myVisible.NbPolylines(), myHidden.NbPolylines());
+    ImGui::Text("Last job: %.2f s  failed parts: %d", myJobSeconds, (int)myNbFailed);
+    ImGui::End();
+}
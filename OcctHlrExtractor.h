@@ -0,0 +1,144 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctHlrExtractor_Header
+#define _OcctHlrExtractor_Header
+
+#include <AIS_InteractiveContext.hxx>
+#include <HLRAlgo_Projector.hxx>
+#include <OSD_Timer.hxx>
+#include <V3d_View.hxx>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+//! Background hidden line removal for the current view direction.
+//! Parts are processed in parallel on a background job, either by exact HLRBRep_Algo
+//! or by polygonal HLRBRep_PolyAlgo over the existing triangulation; results are discretized
+//! into 2D polylines on the worker threads and merged when all parts are done.
+//! By default a single HLR job runs over the whole assembly, so that parts hide each other;
+//! splitting per part is an approximate mode resolving only self-occlusion of each part.
+//! Merged lines are shown as an overlay in the view and streamed to SVG or DXF.
+//! Cancellation never blocks the GUI: HLR algorithms cannot be interrupted, so that parts being processed
+//! are finished in background and the result of the cancelled job is discarded.
+class OcctHlrExtractor
+{
+public:
+    //! HLR algorithm.
+    enum HlrMode
+    {
+        HlrMode_Exact,
+        HlrMode_Polygonal
+    };
+
+    //! Polylines in projection plane coordinates.
+    struct Lines
+    {
+        std::vector<float> XY;     //!< point coordinates
+        std::vector<int>   Starts; //!< index of the first point of each polyline
+
+        //! Return number of polylines.
+        int NbPolylines() const { return (int)Starts.size(); }
+
+        //! Return index following the last point of the polyline.
+        int PolylineEnd(int theIndex) const { return theIndex + 1 < (int)Starts.size() ? Starts[theIndex + 1] : (int)XY.size() / 2; }
+    };
+
+public:
+    //! Default constructor.
+    OcctHlrExtractor();
+
+    //! Destructor, cancels the running job.
+    ~OcctHlrExtractor();
+
+    //! Attach the extractor to the interactive context and view.
+    void Init(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theView);
+
+    //! Start hidden line removal of displayed shapes for the current camera.
+    void Start();
+
+    //! Request the running job to stop without waiting for it;
+    //! the finished job is joined and discarded by RenderGui() or Wait().
+    void Cancel() { myToCancel = true; }
+
+    //! Wait for the running job to finish and discard results of a cancelled one.
+    void Wait();
+
+    //! Return true if the job is running or its results are not merged yet.
+    bool IsRunning() const { return myThread.joinable(); }
+
+    //! Write merged lines as SVG.
+    bool ExportSvg(const TCollection_AsciiString& thePath) const;
+
+    //! Write merged lines as DXF (R12 LINE entities on VISIBLE and HIDDEN layers).
+    bool ExportDxf(const TCollection_AsciiString& thePath) const;
+
+    //! Render the drawing panel.
+    void RenderGui();
+
+private:
+    //! Result of one job.
+    struct PartResult
+    {
+        Lines Visible;
+        Lines Hidden;
+        bool  IsFailed;
+    };
+
+private:
+    //! Job entry point.
+    void perform();
+
+    //! Merge part results and display the overlay.
+    void finish();
+
+    //! Show or hide the overlay.
+    void updateOverlay();
+
+private:
+    Handle(AIS_InteractiveContext) myContext;
+    Handle(V3d_View)               myView;
+    std::vector<TopoDS_Shape>      myParts;         //!< shapes in world coordinates, one per job
+    std::vector<PartResult>        myResults;       //!< one per job, written only by its job
+    HLRAlgo_Projector              myProjector;
+    gp_Trsf                        myToWorld;       //!< projection plane to world coordinates
+    Lines                          myVisible;       //!< merged visible lines
+    Lines                          myHidden;        //!< merged hidden lines
+    Handle(AIS_InteractiveObject)  myOverlay;
+    std::thread                    myThread;
+    std::atomic<bool>              myIsRunning;
+    std::atomic<bool>              myToCancel;
+    std::atomic<int>               myNbDone;
+    std::atomic<int>               myNbFailed;
+    HlrMode                        myMode;
+    bool                           myIsPerPart;
+    bool                           myToShowHidden;
+    bool                           myToShowOverlay;
+    OSD_Timer                      myTimer;
+    double                         myJobSeconds;
+    char                           myPathBuffer[512];
+};
+
+#endif // _OcctHlrExtractor_Header
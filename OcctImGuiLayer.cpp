@@ -0,0 +1,207 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctImGuiLayer.h"
+
+#include "imgui/imgui.h"
+#include "imgui/imgui_impl_opengl3.h"
+
+#include <Graphic3d_ZLayerSettings.hxx>
+#include <OpenGl_Context.hxx>
+#include <OpenGl_Element.hxx>
+#include <OpenGl_Group.hxx>
+#include <OpenGl_ShaderProgram.hxx>
+#include <OpenGl_TextureSet.hxx>
+#include <OpenGl_Workspace.hxx>
+#include <V3d_Viewer.hxx>
+
+namespace
+{
+    //! Element submitting the ImGui draw data of the current frame.
+    class ImGuiElement : public OpenGl_Element
+    {
+    public:
+        DEFINE_STANDARD_ALLOC
+
+        //! Render the draw data, if any, and reset OCCT state caches.
+        virtual void Render(const Handle(OpenGl_Workspace)& theWorkspace) const Standard_OVERRIDE
+        {
+            ImDrawData* aDrawData = ImGui::GetCurrentContext() != nullptr ? ImGui::GetDrawData() : nullptr;
+            if (aDrawData == nullptr
+             || !aDrawData->Valid)
+            {
+                return;
+            }
+
+            // ImGui colors and the viewport texture are already sRGB-encoded, while OCCT may render into an sRGB
+            // offscreen FBO with GL_FRAMEBUFFER_SRGB on when the window buffer is not sRGB-ready, so that encoding
+            // is disabled meanwhile to avoid a washed-out UI; the state is read back from GL, as OpenGl_Context keeps it private
+            const Handle(OpenGl_Context)& aGlCtx = theWorkspace->GetGlContext();
+            const bool wasSRgb = aGlCtx->ToRenderSRGB()
+                              && aGlCtx->GraphicsLibrary() == Aspect_GraphicsLibrary_OpenGL
+                              && aGlCtx->core11fwd->glIsEnabled(GL_FRAMEBUFFER_SRGB) == GL_TRUE;
+            if (wasSRgb)
+            {
+                aGlCtx->SetFrameBufferSRGB(true, false);
+            }
+
+            ImGui_ImplOpenGL3_RenderDrawData(aDrawData);
+
+            if (wasSRgb)
+            {
+                aGlCtx->SetFrameBufferSRGB(true, true);
+            }
+
+            // the backend leaves its own program, texture, culling and polygon mode behind in a shared context;
+            // OCCT caches are reset here, so that OCCT binds its state again on next use instead of skipping it
+            aGlCtx->BindProgram(Handle(OpenGl_ShaderProgram)());
+            aGlCtx->BindTextures(Handle(OpenGl_TextureSet)(), Handle(OpenGl_ShaderProgram)());
+            aGlCtx->SetFaceCulling(Graphic3d_TypeOfBackfacingModel_DoubleSided);
+            aGlCtx->SetPolygonMode(GL_FILL);
+        }
+
+        //! GL resources are owned by the ImGui backend.
+        virtual void Release(OpenGl_Context* ) Standard_OVERRIDE {}
+    };
+
+    //! Presentation holding the ImGui element.
+    class ImGuiPresentation : public AIS_InteractiveObject
+    {
+        DEFINE_STANDARD_RTTI_INLINE(ImGuiPresentation, AIS_InteractiveObject)
+    public:
+        //! The UI covers the whole window, so that it is never culled nor taken into bounding box.
+        ImGuiPresentation() { SetInfiniteState(Standard_True); }
+
+        //! Only the default mode is supported.
+        virtual Standard_Boolean AcceptDisplayMode(const Standard_Integer theMode) const Standard_OVERRIDE { return theMode == 0; }
+
+    protected:
+        //! Put the ImGui element into a new group; the draw data is fetched at render time.
+        virtual void Compute(const Handle(PrsMgr_PresentationManager)& ,
+                             const Handle(Prs3d_Presentation)& thePrs,
+                             const Standard_Integer ) Standard_OVERRIDE
+        {
+            Handle(OpenGl_Group) aGroup = Handle(OpenGl_Group)::DownCast(thePrs->NewGroup());
+            if (!aGroup.IsNull())
+            {
+                aGroup->AddElement(new ImGuiElement());
+            }
+        }
+
+        //! The UI is not selectable.
+        virtual void ComputeSelection(const Handle(SelectMgr_Selection)& ,
+                                      const Standard_Integer ) Standard_OVERRIDE {}
+    };
+}
+
+// ================================================================
+// Function : OcctImGuiLayer
+// Purpose  :
+// ================================================================
+OcctImGuiLayer::OcctImGuiLayer()
+    : myLayerId(Graphic3d_ZLayerId_UNKNOWN)
+{
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctImGuiLayer::Init(const Handle(AIS_InteractiveContext)& theCtx,
+                          const Handle(V3d_View)& theMainView,
+                          Aspect_RenderingContext theGlContext)
+{
+    // a private viewer on the same driver keeps the UI out of the 3D scene and its views
+    Handle(V3d_Viewer) aViewer = new V3d_Viewer(theCtx->CurrentViewer()->Driver());
+    myContext = new AIS_InteractiveContext(aViewer);
+
+    // the UI is drawn last, over whatever else the view shows, without depth
+    Graphic3d_ZLayerSettings aSettings;
+    aSettings.SetName("ImGui");
+    aSettings.SetEnableDepthTest(Standard_False);
+    aSettings.SetEnableDepthWrite(Standard_False);
+    aSettings.SetClearDepth(Standard_False);
+    aViewer->InsertLayerAfter(myLayerId, aSettings, Graphic3d_ZLayerId_TopOSD);
+
+    int aWidth = 0, aHeight = 0;
+    theMainView->Window()->Size(aWidth, aHeight);
+    myWindow = new Aspect_NeutralWindow();
+    myWindow->SetVirtual(Standard_True);
+    myWindow->SetNativeHandle(theMainView->Window()->NativeHandle());
+    myWindow->SetSize(aWidth, aHeight);
+
+    myView = aViewer->CreateView();
+    myView->SetImmediateUpdate(Standard_False);
+    myView->SetWindow(myWindow, theGlContext);
+    myView->SetBackgroundColor(Quantity_NOC_BLACK);
+
+    myPrs = new ImGuiPresentation();
+    myPrs->SetZLayer(myLayerId);
+    myContext->Display(myPrs, 0, -1, Standard_False);
+}
+
+// ================================================================
+// Function : Release
+// Purpose  :
+// ================================================================
+void OcctImGuiLayer::Release()
+{
+    if (!myContext.IsNull()
+     && !myPrs.IsNull())
+    {
+        myContext->Remove(myPrs, Standard_False);
+        myPrs.Nullify();
+    }
+    if (!myView.IsNull())
+    {
+        myView->Remove();
+        myView.Nullify();
+    }
+}
+
+// ================================================================
+// Function : Redraw
+// Purpose  :
+// ================================================================
+void OcctImGuiLayer::Redraw(const Graphic3d_Vec2i& theSize)
+{
+    if (myView.IsNull()
+     || theSize.x() <= 0
+     || theSize.y() <= 0)
+    {
+        return;
+    }
+
+    int aWidth = 0, aHeight = 0;
+    myWindow->Size(aWidth, aHeight);
+    if (aWidth != theSize.x()
+     || aHeight != theSize.y())
+    {
+        myWindow->SetSize(theSize.x(), theSize.y());
+        myView->MustBeResized();
+    }
+
+    // the draw data changes every UI frame, so the whole view is redrawn rather than its immediate layers
+    myView->Invalidate();
+    myView->Redraw();
+}
@@ -0,0 +1,67 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctImGuiLayer_Header
+#define _OcctImGuiLayer_Header
+
+#include <AIS_InteractiveContext.hxx>
+#include <Aspect_NeutralWindow.hxx>
+#include <V3d_View.hxx>
+
+//! ImGui drawn by OCCT as a native graphic layer of the application window.
+//! A private viewer on the shared graphic driver holds a single presentation with a custom OpenGl_Element
+//! submitting the current ImGui draw data, displayed in a Z-layer above all default layers.
+//! The window frame is thus cleared, drawn and finished by OCCT within one V3d_View::Redraw(),
+//! and OCCT state caches are brought back in sync right after the ImGui draw calls.
+//! The 3D scene, including its immediate layers, keeps rendering into the offscreen FBO of the main view
+//! shown by ImGui as a texture, so that its redraws never touch the UI layer.
+class OcctImGuiLayer
+{
+public:
+    //! Default constructor.
+    OcctImGuiLayer();
+
+    //! Create the UI view on the window of the main view.
+    void Init(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theMainView,
+              Aspect_RenderingContext theGlContext);
+
+    //! Remove the UI view.
+    void Release();
+
+    //! Draw the current ImGui draw data into the window; should be called after ImGui::Render().
+    //! @param theSize [in] framebuffer size of the window in pixels
+    void Redraw(const Graphic3d_Vec2i& theSize);
+
+    //! Return the UI view.
+    const Handle(V3d_View)& View() const { return myView; }
+
+private:
+    Handle(AIS_InteractiveContext) myContext;
+    Handle(V3d_View)               myView;
+    Handle(Aspect_NeutralWindow)   myWindow;
+    Handle(AIS_InteractiveObject)  myPrs;
+    Graphic3d_ZLayerId             myLayerId;
+};
+
+#endif // _OcctImGuiLayer_Header
@@ -0,0 +1,162 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctInfiniteGrid.h"
+
+#include <Aspect_Grid.hxx>
+#include <Graphic3d_ArrayOfTriangles.hxx>
+#include <Graphic3d_AspectFillArea3d.hxx>
+#include <Graphic3d_ShaderProgram.hxx>
+#include <Prs3d_Presentation.hxx>
+
+namespace
+{
+    //! Full-screen triangle unprojected into near and far points of the view ray.
+    const char THE_GRID_VERT[] =
+        "THE_SHADER_OUT vec3 NearPoint;\n"
+        "THE_SHADER_OUT vec3 FarPoint;\n"
+        "vec3 unproject(vec3 theNdc)\n"
+        "{\n"
+        "  vec4 aPnt = occWorldViewMatrixInverse * occProjectionMatrixInverse * vec4(theNdc, 1.0);\n"
+        "  return aPnt.xyz / aPnt.w;\n"
+        "}\n"
+        "void main()\n"
+        "{\n"
+        "  NearPoint = unproject(vec3(occVertex.xy, -1.0));\n"
+        "  FarPoint  = unproject(vec3(occVertex.xy,  1.0));\n"
+        "  gl_Position = vec4(occVertex.xy, 0.0, 1.0);\n"
+        "}\n";
+
+    //! Ray-plane intersection with derivative-based line coverage and fading between decades of the step.
+    const char THE_GRID_FRAG[] =
+        "uniform vec3  uOrigin;\n"
+        "uniform vec3  uXDir;\n"
+        "uniform vec3  uYDir;\n"
+        "uniform vec3  uNormal;\n"
+        "uniform vec2  uStep;\n"
+        "uniform vec3  uColor;\n"
+        "uniform vec3  uTenthColor;\n"
+        "uniform float uMinCellPixels;\n"
+        "THE_SHADER_IN vec3 NearPoint;\n"
+        "THE_SHADER_IN vec3 FarPoint;\n"
+        "float lineCoverage(vec2 theCoord, vec2 theDeriv)\n"
+        "{\n"
+        "  vec2 aDist = abs(fract(theCoord - 0.5) - 0.5) / theDeriv;\n"
+        "  return 1.0 - min(min(aDist.x, aDist.y), 1.0);\n"
+        "}\n"
+        "void main()\n"
+        "{\n"
+        "  vec3  aDir   = FarPoint - NearPoint;\n"
+        "  float aDenom = dot(aDir, uNormal);\n"
+        "  if (abs(aDenom) < 1.0e-12) { discard; }\n"
+        "  float aParam = dot(uOrigin - NearPoint, uNormal) / aDenom;\n"
+        // the grid is ignored by z-fit, so hits beyond the far plane are kept and faded by the level of detail
+        "  if (aParam < 0.0) { discard; }\n"
+        "  vec3 aHit   = NearPoint + aDir * aParam;\n"
+        "  vec2 aCoord = vec2(dot(aHit - uOrigin, uXDir), dot(aHit - uOrigin, uYDir)) / uStep;\n"
+        "  vec2 aDeriv = max(fwidth(aCoord), vec2(1.0e-12));\n"
+        // level of detail: the finest level keeps at least uMinCellPixels between lines
+        "  float aLod   = max(0.0, log(max(aDeriv.x, aDeriv.y) * uMinCellPixels) / log(10.0));\n"
+        "  float aFade  = fract(aLod);\n"
+        "  float aScale = pow(10.0, floor(aLod));\n"
+        "  float aFine   = lineCoverage(aCoord / aScale,          aDeriv / aScale) * (1.0 - aFade);\n"
+        "  float aCoarse = lineCoverage(aCoord / (aScale * 10.0), aDeriv / (aScale * 10.0));\n"
+        "  float aMajor  = lineCoverage(aCoord / (aScale * 100.0), aDeriv / (aScale * 100.0));\n"
+        "  float anAlpha = max(max(aFine, aCoarse) * 0.5, aMajor * mix(0.5, 1.0, aFade));\n"
+        "  vec3  aColor  = mix(uColor, uTenthColor, aCoarse > aFine ? aFade : 0.0);\n"
+        "  if (aMajor > 0.0) { aColor = uTenthColor; }\n"
+        // grazing angles are faded out to hide aliasing near the horizon
+        "  anAlpha *= smoothstep(0.0, 0.15, abs(dot(normalize(aDir), uNormal)));\n"
+        "  if (anAlpha <= 0.0) { discard; }\n"
+        "  vec4 aClip = occProjectionMatrix * occWorldViewMatrix * vec4(aHit, 1.0);\n"
+        "  gl_FragDepth = min((aClip.z / aClip.w) * 0.5 + 0.5, 0.99999);\n"
+        "  occSetFragColor(vec4(aColor, anAlpha));\n"
+        "}\n";
+}
+
+// ================================================================
+// Function : OcctInfiniteGrid
+// Purpose  :
+// ================================================================
+OcctInfiniteGrid::OcctInfiniteGrid(const Handle(V3d_Viewer)& theViewer)
+    : myViewer(theViewer),
+    myMinCellPixels(8.0f)
+{
+    // excluded from bounding box and frustum culling;
+    // the top layer reuses scene depth and is never ray-traced, as vertices are not in world space
+    SetInfiniteState(Standard_True);
+    SetZLayer(Graphic3d_ZLayerId_Top);
+}
+
+// ================================================================
+// Function : Compute
+// Purpose  :
+// ================================================================
+void OcctInfiniteGrid::Compute(const Handle(PrsMgr_PresentationManager)& ,
+                               const Handle(Prs3d_Presentation)& thePrs,
+                               const Standard_Integer theMode)
+{
+    if (theMode != 0)
+    {
+        return;
+    }
+
+    // grid origin and rotation are defined within the privileged plane, as for V3d_RectangularGrid
+    Standard_Real anOriginX = 0.0, anOriginY = 0.0, aStepX = 1.0, aStepY = 1.0, anAngle = 0.0;
+    myViewer->RectangularGridValues(anOriginX, anOriginY, aStepX, aStepY, anAngle);
+    const gp_Ax3 aPlane = myViewer->PrivilegedPlane();
+    const gp_Pnt anOrigin = aPlane.Location().Translated(gp_Vec(aPlane.XDirection()) * anOriginX
+                                                       + gp_Vec(aPlane.YDirection()) * anOriginY);
+    const gp_Dir aXDir = aPlane.XDirection().Rotated(gp_Ax1(anOrigin, aPlane.Direction()), anAngle);
+    const gp_Dir aYDir = aPlane.Direction().Crossed(aXDir);
+    Quantity_Color aColor, aTenthColor;
+    myViewer->Grid()->Colors(aColor, aTenthColor);
+
+    Handle(Graphic3d_ShaderProgram) aProgram = new Graphic3d_ShaderProgram();
+    aProgram->AttachShader(Graphic3d_ShaderObject::CreateFromSource(Graphic3d_TOS_VERTEX,   THE_GRID_VERT));
+    aProgram->AttachShader(Graphic3d_ShaderObject::CreateFromSource(Graphic3d_TOS_FRAGMENT, THE_GRID_FRAG));
+    aProgram->PushVariableVec3("uOrigin",    Graphic3d_Vec3((float)anOrigin.X(), (float)anOrigin.Y(), (float)anOrigin.Z()));
+    aProgram->PushVariableVec3("uXDir",      Graphic3d_Vec3((float)aXDir.X(), (float)aXDir.Y(), (float)aXDir.Z()));
+    aProgram->PushVariableVec3("uYDir",      Graphic3d_Vec3((float)aYDir.X(), (float)aYDir.Y(), (float)aYDir.Z()));
+    aProgram->PushVariableVec3("uNormal",    Graphic3d_Vec3((float)aPlane.Direction().X(), (float)aPlane.Direction().Y(), (float)aPlane.Direction().Z()));
+    aProgram->PushVariableVec2("uStep",      Graphic3d_Vec2((float)aStepX, (float)aStepY));
+    aProgram->PushVariableVec3("uColor",     Graphic3d_Vec3((float)aColor.Red(), (float)aColor.Green(), (float)aColor.Blue()));
+    aProgram->PushVariableVec3("uTenthColor", Graphic3d_Vec3((float)aTenthColor.Red(), (float)aTenthColor.Green(), (float)aTenthColor.Blue()));
+    aProgram->PushVariableFloat("uMinCellPixels", myMinCellPixels);
+
+    Handle(Graphic3d_AspectFillArea3d) anAspect = new Graphic3d_AspectFillArea3d();
+    anAspect->SetInteriorStyle(Aspect_IS_SOLID);
+    anAspect->SetShadingModel(Graphic3d_TypeOfShadingModel_Unlit);
+    anAspect->SetAlphaMode(Graphic3d_AlphaMode_Blend);
+    anAspect->SetShaderProgram(aProgram);
+
+    // vertices are given in normalized device coordinates and cover the whole viewport
+    Handle(Graphic3d_ArrayOfTriangles) aTriangle = new Graphic3d_ArrayOfTriangles(3);
+    aTriangle->AddVertex(-1.0, -1.0, 0.0);
+    aTriangle->AddVertex( 3.0, -1.0, 0.0);
+    aTriangle->AddVertex(-1.0,  3.0, 0.0);
+
+    Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
+    aGroup->SetGroupPrimitivesAspect(anAspect);
+    aGroup->AddPrimitiveArray(aTriangle);
+}
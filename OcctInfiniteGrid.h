@@ -0,0 +1,67 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctInfiniteGrid_Header
+#define _OcctInfiniteGrid_Header
+
+#include <AIS_InteractiveObject.hxx>
+#include <V3d_Viewer.hxx>
+
+//! Procedural infinite grid drawn as a single full-screen triangle.
+//! The fragment shader intersects the view ray with the privileged plane of the viewer,
+//! draws anti-aliased lines from screen-space derivatives and fades between decades of the grid step,
+//! so that the cost depends only on the number of covered pixels, not on zoom or grid density.
+//! The grid follows the rectangular grid of V3d_Viewer, which stays active (but not displayed)
+//! for snapping through V3d_View::ConvertToGrid().
+class OcctInfiniteGrid : public AIS_InteractiveObject
+{
+    DEFINE_STANDARD_RTTI_INLINE(OcctInfiniteGrid, AIS_InteractiveObject)
+public:
+    //! Create the grid following the rectangular grid of the viewer.
+    OcctInfiniteGrid(const Handle(V3d_Viewer)& theViewer);
+
+    //! Return minimal distance in pixels between lines of the finest visible level.
+    float MinCellPixels() const { return myMinCellPixels; }
+
+    //! Set minimal distance in pixels between lines; the presentation should be recomputed.
+    void SetMinCellPixels(float thePixels) { myMinCellPixels = thePixels; }
+
+    //! Only the default mode is supported.
+    virtual Standard_Boolean AcceptDisplayMode(const Standard_Integer theMode) const Standard_OVERRIDE { return theMode == 0; }
+
+protected:
+    //! Build the full-screen triangle with the grid shader taking the current viewer grid parameters.
+    virtual void Compute(const Handle(PrsMgr_PresentationManager)& thePrsMgr,
+                         const Handle(Prs3d_Presentation)& thePrs,
+                         const Standard_Integer theMode) Standard_OVERRIDE;
+
+    //! The grid is not selectable.
+    virtual void ComputeSelection(const Handle(SelectMgr_Selection)& ,
+                                  const Standard_Integer ) Standard_OVERRIDE {}
+
+private:
+    Handle(V3d_Viewer) myViewer;
+    float              myMinCellPixels;
+};
+
+#endif // _OcctInfiniteGrid_Header
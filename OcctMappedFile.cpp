@@ -0,0 +1,153 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctMappedFile.h"
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+// ================================================================
+// Function : Open
+// Purpose  :
+// ================================================================
+bool OcctMappedFile::Open(const TCollection_AsciiString& thePath)
+{
+    Close();
+#ifdef _WIN32
+    HANDLE aFile = CreateFileA(thePath.ToCString(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, NULL);
+    if (aFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER aSize;
+    if (!GetFileSizeEx(aFile, &aSize)
+     || aSize.QuadPart == 0)
+    {
+        CloseHandle(aFile);
+        return false;
+    }
+
+    HANDLE aMapping = CreateFileMappingA(aFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    const void* aData = aMapping != NULL ? MapViewOfFile(aMapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (aData == NULL)
+    {
+        if (aMapping != NULL)
+        {
+            CloseHandle(aMapping);
+        }
+        CloseHandle(aFile);
+        return false;
+    }
+
+    myFile    = aFile;
+    myMapping = aMapping;
+    mySize    = (size_t)aSize.QuadPart;
+#else
+    const int aFile = open(thePath.ToCString(), O_RDONLY);
+    if (aFile < 0)
+    {
+        return false;
+    }
+
+    struct stat aStat;
+    if (fstat(aFile, &aStat) != 0
+     || aStat.st_size == 0)
+    {
+        close(aFile);
+        return false;
+    }
+
+    void* aData = mmap(NULL, (size_t)aStat.st_size, PROT_READ, MAP_SHARED, aFile, 0);
+    // the mapping keeps its own reference to the file
+    close(aFile);
+    if (aData == MAP_FAILED)
+    {
+        return false;
+    }
+
+    mySize = (size_t)aStat.st_size;
+#endif
+    myData = static_cast<const unsigned char*>(aData);
+    return true;
+}
+
+// ================================================================
+// Function : Close
+// Purpose  :
+// ================================================================
+void OcctMappedFile::Close()
+{
+    if (myData == NULL)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(myData);
+    CloseHandle((HANDLE)myMapping);
+    CloseHandle((HANDLE)myFile);
+#else
+    munmap(const_cast<unsigned char*>(myData), mySize);
+#endif
+    myData    = NULL;
+    mySize    = 0;
+    myFile    = NULL;
+    myMapping = NULL;
+}
+
+// ================================================================
+// Function : WillNeed
+// Purpose  :
+// ================================================================
+void OcctMappedFile::WillNeed(size_t theOffset, size_t theSize) const
+{
+    if (myData == NULL
+     || theOffset >= mySize)
+    {
+        return;
+    }
+
+    if (theSize > mySize - theOffset)
+    {
+        theSize = mySize - theOffset;
+    }
+#ifdef _WIN32
+    WIN32_MEMORY_RANGE_ENTRY aRange;
+    aRange.VirtualAddress = const_cast<unsigned char*>(myData + theOffset);
+    aRange.NumberOfBytes  = theSize;
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &aRange, 0);
+#else
+    // madvise() expects a page-aligned address
+    const size_t aPageSize = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t anAligned = theOffset - theOffset % aPageSize;
+    madvise(const_cast<unsigned char*>(myData + anAligned), theSize + (theOffset - anAligned), MADV_WILLNEED);
+#endif
+}
@@ -0,0 +1,72 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctMappedFile_Header
+#define _OcctMappedFile_Header
+
+#include <TCollection_AsciiString.hxx>
+
+#include <cstddef>
+
+//! Read-only memory mapping of a whole file.
+//! Pages are loaded by the OS on first access, so large files can be opened instantly
+//! and only the touched parts occupy memory.
+class OcctMappedFile
+{
+public:
+    //! Default constructor.
+    OcctMappedFile() : myData(NULL), mySize(0), myFile(NULL), myMapping(NULL) {}
+
+    //! Destructor, unmaps the file.
+    ~OcctMappedFile() { Close(); }
+
+    //! Map the file; returns false on failure or for an empty file.
+    bool Open(const TCollection_AsciiString& thePath);
+
+    //! Unmap the file.
+    void Close();
+
+    //! Return true if the file is mapped.
+    bool IsOpen() const { return myData != NULL; }
+
+    //! Return mapped bytes.
+    const unsigned char* Data() const { return myData; }
+
+    //! Return file size in bytes.
+    size_t Size() const { return mySize; }
+
+    //! Hint the OS that the range will be read soon; the range is clamped to the file.
+    void WillNeed(size_t theOffset, size_t theSize) const;
+
+private:
+    OcctMappedFile(const OcctMappedFile&);
+    OcctMappedFile& operator=(const OcctMappedFile&);
+
+private:
+    const unsigned char* myData;
+    size_t               mySize;
+    void*                myFile;     //!< platform file handle
+    void*                myMapping;  //!< platform mapping handle
+};
+
+#endif // _OcctMappedFile_Header
@@ -0,0 +1,512 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctMeasureTool.h"
+
+#include "imgui/imgui.h"
+
+#include <AIS_Shape.hxx>
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepAdaptor_Surface.hxx>
+#include <BRepExtrema_DistShapeShape.hxx>
+#include <OSD_Timer.hxx>
+#include <SelectMgr_ViewerSelector.hxx>
+#include <StdSelect_BRepOwner.hxx>
+#include <TopoDS.hxx>
+
+#include <cstdio>
+
+namespace
+{
+    //! Format value with a caption.
+    static TCollection_AsciiString formatValue(const char* theCaption, Standard_Real theValue, const char* theUnits = "")
+    {
+        char aBuffer[128];
+        std::snprintf(aBuffer, sizeof(aBuffer), "%s %.3f%s", theCaption, theValue, theUnits);
+        return TCollection_AsciiString(aBuffer);
+    }
+}
+
+// ================================================================
+// Function : OcctMeasureTool
+// Purpose  :
+// ================================================================
+OcctMeasureTool::OcctMeasureTool()
+    : myMode(MeasureMode_None),
+    myHasHover(false),
+    myHoverQueryMs(0.0),
+    myLastExactMs(0.0)
+{
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctMeasureTool::Init(const Handle(AIS_InteractiveContext)& theCtx,
+                           const Handle(V3d_View)& theView)
+{
+    myContext = theCtx;
+    myView = theView;
+    myBvhCache.Clear();
+}
+
+// ================================================================
+// Function : SetMode
+// Purpose  :
+// ================================================================
+void OcctMeasureTool::SetMode(MeasureMode theMode)
+{
+    if (myMode == theMode)
+    {
+        return;
+    }
+
+    if (myMode == MeasureMode_Radius)
+    {
+        activateSubShapes(false);
+    }
+    myMode = theMode;
+    if (myMode == MeasureMode_Radius)
+    {
+        activateSubShapes(true);
+    }
+
+    myPendingPoints.Clear();
+    myPendingShapes.Clear();
+    myHasHover = false;
+}
+
+// ================================================================
+// Function : Clear
+// Purpose  :
+// ================================================================
+void OcctMeasureTool::Clear()
+{
+    myResults.Clear();
+    myPendingPoints.Clear();
+    myPendingShapes.Clear();
+    myHasHover = false;
+}
+
+// ================================================================
+// Function : activateSubShapes
+// Purpose  :
+// ================================================================
+void OcctMeasureTool::activateSubShapes(bool theToActivate)
+{
+    if (myContext.IsNull())
+    {
+        return;
+    }
+
+    AIS_ListOfInteractive anObjects;
+    myContext->DisplayedObjects(anObjects);
+    for (AIS_ListOfInteractive::Iterator anObjIter(anObjects); anObjIter.More(); anObjIter.Next())
+    {
+        if (!anObjIter.Value()->IsKind(STANDARD_TYPE(AIS_Shape)))
+        {
+            continue;
+        }
+
+        // whole shape mode is disabled meanwhile to pick edges and faces only
+        for (TopAbs_ShapeEnum aType : { TopAbs_SHAPE, TopAbs_EDGE, TopAbs_FACE })
+        {
+            if (theToActivate == (aType != TopAbs_SHAPE))
+            {
+                myContext->Activate(anObjIter.Value(), AIS_Shape::SelectionMode(aType));
+            }
+            else
+            {
+                myContext->Deactivate(anObjIter.Value(), AIS_Shape::SelectionMode(aType));
+            }
+        }
+    }
+}
+
+// ================================================================
+// Function : pickPoint
+// Purpose  :
+// ================================================================
+bool OcctMeasureTool::pickPoint(gp_Pnt& thePnt, TopoDS_Shape& theShape) const
+{
+    if (myContext.IsNull() || myView.IsNull())
+    {
+        return false;
+    }
+
+    // results of the last AIS_InteractiveContext::MoveTo() are reused instead of picking once more,
+    // which would double the picking cost and overwrite the detection sequence of the context
+    const Handle(SelectMgr_ViewerSelector)& aSelector = myContext->MainSelector();
+    for (Standard_Integer aPickIter = 1; aPickIter <= aSelector->NbPicked(); ++aPickIter)
+    {
+        Handle(StdSelect_BRepOwner) anOwner = Handle(StdSelect_BRepOwner)::DownCast(aSelector->Picked(aPickIter));
+        if (anOwner.IsNull() || !anOwner->HasShape())
+        {
+            continue;
+        }
+
+        thePnt = aSelector->PickedPoint(aPickIter);
+        theShape = anOwner->Shape().Moved(anOwner->Location());
+        return true;
+    }
+    return false;
+}
+
+// ================================================================
+// Function : Pick
+// Purpose  :
+// ================================================================
+void OcctMeasureTool::Pick()
+{
+    gp_Pnt aPnt;
+    TopoDS_Shape aShape;
+    if (!IsActive() || !pickPoint(aPnt, aShape))
+    {
+        return;
+    }
+
+    switch (myMode)
+    {
+        case MeasureMode_Distance:
+        {
+            myPendingPoints.Append(aPnt);
+            if (myPendingPoints.Length() == 2)
+            {
+                Measurement aResult;
+                aResult.Points = myPendingPoints;
+                aResult.Label = formatValue("D", myPendingPoints.First().Distance(myPendingPoints.Last()));
+                myResults.Append(aResult);
+                myPendingPoints.Clear();
+            }
+            break;
+        }
+        case MeasureMode_MinDistance:
+        {
+            // distance of the shape to itself is always zero
+            if (myPendingShapes.Length() == 1
+             && myPendingShapes.First().IsSame(aShape))
+            {
+                return;
+            }
+
+            myPendingShapes.Append(aShape);
+            if (myPendingShapes.Length() == 1)
+            {
+                // warm up the cache so that hover queries never build BVH
+                myBvhCache.Faces(aShape);
+            }
+            else
+            {
+                measureMinDistance();
+                myPendingShapes.Clear();
+            }
+            break;
+        }
+        case MeasureMode_Angle:
+        {
+            myPendingPoints.Append(aPnt);
+            if (myPendingPoints.Length() == 3)
+            {
+                const gp_Vec aDir1(myPendingPoints.Value(1), myPendingPoints.Value(0));
+                const gp_Vec aDir2(myPendingPoints.Value(1), myPendingPoints.Value(2));
+                if (aDir1.Magnitude() > gp::Resolution()
+                    && aDir2.Magnitude() > gp::Resolution())
+                {
+                    Measurement aResult;
+                    aResult.Points = myPendingPoints;
+                    aResult.Label = formatValue("A", aDir1.Angle(aDir2) * 180.0 / M_PI, " deg");
+                    myResults.Append(aResult);
+                }
+                myPendingPoints.Clear();
+            }
+            break;
+        }
+        case MeasureMode_Radius:
+        {
+            measureRadius(aShape);
+            break;
+        }
+        case MeasureMode_None:
+        {
+            break;
+        }
+    }
+    myHasHover = false;
+}
+
+// ================================================================
+// Function : UpdateHover
+// Purpose  :
+// ================================================================
+void OcctMeasureTool::UpdateHover()
+{
+    myHasHover = false;
+    if (myMode != MeasureMode_Distance
+        && myMode != MeasureMode_MinDistance)
+    {
+        return;
+    }
+
+    gp_Pnt aPnt;
+    TopoDS_Shape aShape;
+    if (!pickPoint(aPnt, aShape))
+    {
+        return;
+    }
+
+    myHover.Points.Clear();
+    if (myMode == MeasureMode_Distance
+        && myPendingPoints.Length() == 1)
+    {
+        myHover.Points.Append(myPendingPoints.First());
+        myHover.Points.Append(aPnt);
+        myHover.Label = formatValue("D", aPnt.Distance(myPendingPoints.First()));
+        myHasHover = true;
+    }
+    else if (myMode == MeasureMode_MinDistance
+          && myPendingShapes.Length() == 1
+          && !myPendingShapes.First().IsSame(aShape))
+    {
+        // point-to-shape query through cached per-face BVHs
+        OSD_Timer aTimer;
+        aTimer.Start();
+        gp_Pnt aNearest;
+        Standard_Real aDist = 0.0;
+        myHasHover = myBvhCache.NearestPoint(myPendingShapes.First(), aPnt, aNearest, aDist);
+        myHoverQueryMs = aTimer.ElapsedTime() * 1000.0;
+        if (myHasHover)
+        {
+            myHover.Points.Append(aPnt);
+            myHover.Points.Append(aNearest);
+            myHover.Label = formatValue("~D", aDist);
+        }
+    }
+}
+
+// ================================================================
+// Function : measureMinDistance
+// Purpose  :
+// ================================================================
+void OcctMeasureTool::measureMinDistance()
+{
+    OSD_Timer aTimer;
+    aTimer.Start();
+
+    BRepExtrema_DistShapeShape aDistTool;
+    aDistTool.SetMultiThread(Standard_True);
+    aDistTool.LoadS1(myPendingShapes.Value(0));
+    aDistTool.LoadS2(myPendingShapes.Value(1));
+    aDistTool.Perform();
+    myLastExactMs = aTimer.ElapsedTime() * 1000.0;
+    if (!aDistTool.IsDone()
+        || aDistTool.NbSolution() < 1)
+    {
+        return;
+    }
+
+    Measurement aResult;
+    aResult.Points.Append(aDistTool.PointOnShape1(1));
+    aResult.Points.Append(aDistTool.PointOnShape2(1));
+    aResult.Label = formatValue("Min", aDistTool.Value());
+    myResults.Append(aResult);
+}
+
+// ================================================================
+// Function : measureRadius
+// Purpose  :
+// ================================================================
+void OcctMeasureTool::measureRadius(const TopoDS_Shape& theShape)
+{
+    Measurement aResult;
+    if (theShape.ShapeType() == TopAbs_EDGE)
+    {
+        BRepAdaptor_Curve aCurve(TopoDS::Edge(theShape));
+        if (aCurve.GetType() != GeomAbs_Circle)
+        {
+            return;
+        }
+
+        const gp_Circ aCirc = aCurve.Circle();
+        aResult.Points.Append(aCirc.Location());
+        aResult.Points.Append(aCurve.Value(aCurve.FirstParameter()));
+        aResult.Label = formatValue("R", aCirc.Radius());
+    }
+    else if (theShape.ShapeType() == TopAbs_FACE)
+    {
+        BRepAdaptor_Surface aSurf(TopoDS::Face(theShape));
+        const Standard_Real aU = aSurf.FirstUParameter();
+        const Standard_Real aV = 0.5 * (aSurf.FirstVParameter() + aSurf.LastVParameter());
+        if (aSurf.GetType() == GeomAbs_Cylinder)
+        {
+            const gp_Cylinder aCyl = aSurf.Cylinder();
+            const gp_Pnt aPnt = aSurf.Value(aU, aV);
+            const gp_Lin anAxis(aCyl.Axis());
+            const gp_Vec anOffset(anAxis.Location(), aPnt);
+            aResult.Points.Append(anAxis.Location().Translated(gp_Vec(anAxis.Direction()) * anOffset.Dot(gp_Vec(anAxis.Direction()))));
+            aResult.Points.Append(aPnt);
+            aResult.Label = formatValue("R", aCyl.Radius());
+        }
+        else if (aSurf.GetType() == GeomAbs_Sphere)
+        {
+            const gp_Sphere aSphere = aSurf.Sphere();
+            aResult.Points.Append(aSphere.Location());
+            aResult.Points.Append(aSurf.Value(aU, aV));
+            aResult.Label = formatValue("R", aSphere.Radius());
+        }
+        else
+        {
+            return;
+        }
+    }
+    else
+    {
+        return;
+    }
+    myResults.Append(aResult);
+}
+
+// ================================================================
+// Function : project
+// Purpose  :
+// ================================================================
+bool OcctMeasureTool::project(const gp_Pnt& thePnt, float& theX, float& theY) const
+{
+    if (myView.IsNull()
+     || myView->Window().IsNull())
+    {
+        return false;
+    }
+
+    // V3d_View::Convert() mirrors points behind the camera, so that they are rejected by NDC depth
+    const gp_Pnt aNdc = myView->Camera()->Project(thePnt);
+    if (aNdc.Z() < -1.0 || aNdc.Z() > 1.0)
+    {
+        return false;
+    }
+
+    Standard_Integer aWidth = 0, aHeight = 0;
+    myView->Window()->Size(aWidth, aHeight);
+    theX = float((aNdc.X() + 1.0) * 0.5 * aWidth);
+    theY = float((1.0 - aNdc.Y()) * 0.5 * aHeight);
+    return true;
+}
+
+// ================================================================
+// Function : RenderOverlay
+// Purpose  :
+// ================================================================
+void OcctMeasureTool::RenderOverlay(ImDrawList* theDrawList, const Graphic3d_Vec2& theOrigin, float thePixelRatio) const
+{
+    const ImU32 aLineColor  = IM_COL32(255, 200, 0, 255);
+    const ImU32 aHoverColor = IM_COL32(0, 200, 255, 255);
+    const ImU32 aTextColor  = IM_COL32(255, 255, 255, 255);
+
+    auto aDrawMeasurement = [&](const Measurement& theMeasure, ImU32 theColor)
+    {
+        ImVec2 aPrev, aLabelPos;
+        for (int aPntIter = 0; aPntIter < theMeasure.Points.Length(); ++aPntIter)
+        {
+            ImVec2 aCur;
+            if (!project(theMeasure.Points.Value(aPntIter), aCur.x, aCur.y))
+            {
+                return;
+            }
+            aCur = ImVec2(theOrigin.x() + aCur.x / thePixelRatio, theOrigin.y() + aCur.y / thePixelRatio);
+
+            theDrawList->AddCircleFilled(aCur, 3.0f, theColor);
+            if (aPntIter > 0)
+            {
+                theDrawList->AddLine(aPrev, aCur, theColor, 2.0f);
+            }
+            if (aPntIter == theMeasure.Points.Length() / 2)
+            {
+                aLabelPos = aPntIter > 0 && theMeasure.Points.Length() % 2 == 0
+                          ? ImVec2(0.5f * (aPrev.x + aCur.x), 0.5f * (aPrev.y + aCur.y))
+                          : aCur;
+            }
+            aPrev = aCur;
+        }
+        theDrawList->AddText(ImVec2(aLabelPos.x + 6.0f, aLabelPos.y - 18.0f), aTextColor, theMeasure.Label.ToCString());
+    };
+
+    for (NCollection_Sequence<Measurement>::Iterator aResIter(myResults); aResIter.More(); aResIter.Next())
+    {
+        aDrawMeasurement(aResIter.Value(), aLineColor);
+    }
+    if (myHasHover)
+    {
+        aDrawMeasurement(myHover, aHoverColor);
+    }
+    for (NCollection_Vector<gp_Pnt>::Iterator aPntIter(myPendingPoints); aPntIter.More(); aPntIter.Next())
+    {
+        ImVec2 aPos;
+        if (project(aPntIter.Value(), aPos.x, aPos.y))
+        {
+            aPos = ImVec2(theOrigin.x() + aPos.x / thePixelRatio, theOrigin.y() + aPos.y / thePixelRatio);
+            theDrawList->AddCircle(aPos, 5.0f, aHoverColor, 0, 2.0f);
+        }
+    }
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctMeasureTool::RenderGui()
+{
+    ImGui::Begin("Measure");
+
+    int aMode = (int)myMode;
+    ImGui::RadioButton("Off", &aMode, MeasureMode_None);
+    ImGui::SameLine();
+    ImGui::RadioButton("Distance", &aMode, MeasureMode_Distance);
+    ImGui::SameLine();
+    ImGui::RadioButton("Min distance", &aMode, MeasureMode_MinDistance);
+    ImGui::RadioButton("Angle", &aMode, MeasureMode_Angle);
+    ImGui::SameLine();
+    ImGui::RadioButton("Radius", &aMode, MeasureMode_Radius);
+    SetMode((MeasureMode)aMode);
+
+    switch (myMode)
+    {
+        case MeasureMode_Distance:    ImGui::TextDisabled("Click two points."); break;
+        case MeasureMode_MinDistance: ImGui::TextDisabled("Click two shapes."); break;
+        case MeasureMode_Angle:       ImGui::TextDisabled("Click three points, apex second."); break;
+        case MeasureMode_Radius:      ImGui::TextDisabled("Click a circular edge or face."); break;
+        case MeasureMode_None:        break;
+    }
+
+    ImGui::Text("Cursor query: %.3f ms", myHoverQueryMs);
+    ImGui::Text("Exact min distance: %.3f ms", myLastExactMs);
+    ImGui::Separator();
+    for (NCollection_Sequence<Measurement>::Iterator aResIter(myResults); aResIter.More(); aResIter.Next())
+    {
+        ImGui::TextUnformatted(aResIter.Value().Label.ToCString());
+    }
+    if (ImGui::Button("Clear"))
+    {
+        Clear();
+    }
+    ImGui::End();
+}
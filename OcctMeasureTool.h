@@ -0,0 +1,127 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctMeasureTool_Header
+#define _OcctMeasureTool_Header
+
+#include "OcctShapeBvhCache.h"
+
+#include <AIS_InteractiveContext.hxx>
+#include <Graphic3d_Vec.hxx>
+#include <NCollection_Sequence.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <V3d_View.hxx>
+
+struct ImDrawList;
+
+//! Interactive measurement tool: point distance, minimal shape distance, angle and radius.
+//! Results are drawn as ImGui overlay projected from 3D.
+class OcctMeasureTool
+{
+public:
+    //! Measurement mode.
+    enum MeasureMode
+    {
+        MeasureMode_None,        //!< tool is inactive
+        MeasureMode_Distance,    //!< distance between two picked points
+        MeasureMode_MinDistance, //!< minimal distance between two picked shapes
+        MeasureMode_Angle,       //!< angle defined by three picked points (apex is the second one)
+        MeasureMode_Radius       //!< radius of a picked circular edge, cylinder or sphere
+    };
+
+public:
+    //! Default constructor.
+    OcctMeasureTool();
+
+    //! Attach the tool to the interactive context and view.
+    void Init(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theView);
+
+    //! Return active mode.
+    MeasureMode Mode() const { return myMode; }
+
+    //! Set active mode; pending picks are discarded.
+    void SetMode(MeasureMode theMode);
+
+    //! Return true if the tool consumes picks.
+    bool IsActive() const { return myMode != MeasureMode_None; }
+
+    //! Pick a point or shape detected under the cursor for the active measurement.
+    //! Detection results of the last AIS_InteractiveContext::MoveTo() are used.
+    void Pick();
+
+    //! Update live "distance under the cursor" feedback;
+    //! to be called after AIS_InteractiveContext::MoveTo().
+    void UpdateHover();
+
+    //! Remove all measurements.
+    void Clear();
+
+    //! Render the tool panel.
+    void RenderGui();
+
+    //! Draw measurements projected from 3D.
+    //! @param theDrawList   [in] draw list of the window showing the view
+    //! @param theOrigin     [in] screen position of the view top-left corner
+    //! @param thePixelRatio [in] view pixels per ImGui unit
+    void RenderOverlay(ImDrawList* theDrawList, const Graphic3d_Vec2& theOrigin, float thePixelRatio) const;
+
+private:
+    //! Measurement result drawn in the overlay.
+    struct Measurement
+    {
+        NCollection_Vector<gp_Pnt> Points; //!< polyline to draw
+        TCollection_AsciiString    Label;  //!< text drawn at the middle of the polyline
+    };
+
+private:
+    //! Return the point and the shape detected under the cursor.
+    bool pickPoint(gp_Pnt& thePnt, TopoDS_Shape& theShape) const;
+
+    //! Compute minimal distance between two pending shapes.
+    void measureMinDistance();
+
+    //! Compute radius of the shape.
+    void measureRadius(const TopoDS_Shape& theShape);
+
+    //! (De)activate sub-shape selection modes used by radius measurement.
+    void activateSubShapes(bool theToActivate);
+
+    //! Project 3D point into view pixel coordinates.
+    bool project(const gp_Pnt& thePnt, float& theX, float& theY) const;
+
+private:
+    Handle(AIS_InteractiveContext)   myContext;
+    Handle(V3d_View)                 myView;
+    OcctShapeBvhCache                myBvhCache;
+    MeasureMode                      myMode;
+    NCollection_Vector<gp_Pnt>       myPendingPoints;
+    NCollection_Vector<TopoDS_Shape> myPendingShapes;
+    NCollection_Sequence<Measurement> myResults;
+    Measurement                      myHover;
+    bool                             myHasHover;
+    double                           myHoverQueryMs;
+    double                           myLastExactMs;
+};
+
+#endif // _OcctMeasureTool_Header
@@ -0,0 +1,479 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctMotionPlayer.h"
+
+#include "imgui/imgui.h"
+
+#include <AIS_Shape.hxx>
+#include <Graphic3d_CView.hxx>
+#include <gp_Quaternion.hxx>
+#include <gp_QuaternionSLerp.hxx>
+#include <Message.hxx>
+#include <Message_Messenger.hxx>
+#include <OSD_Parallel.hxx>
+#include <SelectMgr_SelectionManager.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    //! Size of the file header in bytes.
+    const size_t THE_HEADER_SIZE = 32;
+
+    //! Translation and rotation of the identity motion.
+    const float THE_IDENTITY[7] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+}
+
+// ================================================================
+// Function : OcctMotionPlayer
+// Purpose  :
+// ================================================================
+OcctMotionPlayer::OcctMotionPlayer()
+    : myNbTracks(0),
+    myNbFrames(0),
+    myFileRate(30.0f),
+    myTime(0.0f),
+    myClockTime(0.0f),
+    myAppliedTime(-1.0f),
+    mySpeed(1.0f),
+    myIsPlaying(false),
+    myToLoop(true),
+    myToSelectEachFrame(false),
+    myIsSelectionDirty(false),
+    myNbApplied(0),
+    myApplyMs(0.0),
+    mySelectionMs(0.0),
+    myTotalApplyMs(0.0),
+    myTotalApplied(0)
+{
+    strcpy(myPathBuffer, "motion.ocmf");
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctMotionPlayer::Init(const Handle(AIS_InteractiveContext)& theCtx,
+                            const Handle(V3d_View)& theView)
+{
+    myContext = theCtx;
+    myView = theView;
+}
+
+// ================================================================
+// Function : SetAssembly
+// Purpose  :
+// ================================================================
+void OcctMotionPlayer::SetAssembly(const OcctOutliner& theOutliner)
+{
+    Close();
+    myTracks.clear();
+    for (const OcctOutliner::Node& aNode : theOutliner.Nodes())
+    {
+        if (aNode.Object.IsNull())
+        {
+            continue;
+        }
+
+        Track aTrack;
+        aTrack.Object  = aNode.Object;
+        aTrack.Base    = aNode.Location.Transformation();
+        aTrack.IsMoved = false;
+        std::copy(THE_IDENTITY, THE_IDENTITY + 7, aTrack.Applied);
+        myTracks.push_back(aTrack);
+    }
+}
+
+// ================================================================
+// Function : Duration
+// Purpose  :
+// ================================================================
+float OcctMotionPlayer::Duration() const
+{
+    // looping interpolates the last frame back to the first one
+    return myNbFrames > 0 ? (float)(myToLoop ? myNbFrames : myNbFrames - 1) / myFileRate : 0.0f;
+}
+
+// ================================================================
+// Function : Open
+// Purpose  :
+// ================================================================
+bool OcctMotionPlayer::Open(const TCollection_AsciiString& thePath)
+{
+    Close();
+    if (!myFile.Open(thePath))
+    {
+        Message::DefaultMessenger()->Send(TCollection_AsciiString("Unable to map motion file '") + thePath + "'", Message_Fail);
+        return false;
+    }
+
+    uint32_t aHeader[8] = {};
+    if (myFile.Size() >= THE_HEADER_SIZE)
+    {
+        memcpy(aHeader, myFile.Data(), THE_HEADER_SIZE);
+    }
+    myNbTracks = (int)aHeader[2];
+    myNbFrames = (int)aHeader[3];
+    memcpy(&myFileRate, &aHeader[4], sizeof(float));
+    if (memcmp(myFile.Data(), "OCMF", 4) != 0
+     || aHeader[1] != 1
+     || myNbTracks <= 0 || myNbFrames <= 0
+     || !(myFileRate > 0.0f)
+     || myFile.Size() < THE_HEADER_SIZE + (size_t)myNbTracks * myNbFrames * 32)
+    {
+        Message::DefaultMessenger()->Send(TCollection_AsciiString("Invalid motion file '") + thePath + "'", Message_Fail);
+        myFile.Close();
+        myNbTracks = myNbFrames = 0;
+        return false;
+    }
+    if (myNbTracks != (int)myTracks.size())
+    {
+        Message::DefaultMessenger()->Send(TCollection_AsciiString("Motion file has ") + myNbTracks
+                                        + " tracks for " + (int)myTracks.size() + " part instances", Message_Warning);
+    }
+
+    myFrameValues.resize((size_t)std::min(myNbTracks, (int)myTracks.size()) * 7);
+    myTime = 0.0f;
+    myAppliedTime = -1.0f;
+    myIsPlaying = false;
+    myTotalApplyMs = 0.0;
+    myTotalApplied = 0;
+    return true;
+}
+
+// ================================================================
+// Function : Close
+// Purpose  :
+// ================================================================
+void OcctMotionPlayer::Close()
+{
+    if (!myFile.IsOpen())
+    {
+        return;
+    }
+
+    for (Track& aTrack : myTracks)
+    {
+        if (memcmp(aTrack.Applied, THE_IDENTITY, sizeof(THE_IDENTITY)) == 0)
+        {
+            continue;
+        }
+
+        std::copy(THE_IDENTITY, THE_IDENTITY + 7, aTrack.Applied);
+        if (aTrack.Base.Form() == gp_Identity)
+        {
+            aTrack.Object->ResetTransformation();
+        }
+        else
+        {
+            aTrack.Object->SetLocalTransformation(aTrack.Base);
+        }
+        aTrack.IsMoved = true;
+        myIsSelectionDirty = true;
+    }
+    updateSelection();
+    myView->Invalidate();
+
+    myIsPlaying = false;
+    myNbTracks = myNbFrames = 0;
+    myFile.Close();
+}
+
+// ================================================================
+// Function : restartClock
+// Purpose  :
+// ================================================================
+void OcctMotionPlayer::restartClock()
+{
+    myClockTime = myTime;
+    myClock.Reset();
+    myClock.Start();
+}
+
+// ================================================================
+// Function : applyFrame
+// Purpose  :
+// ================================================================
+void OcctMotionPlayer::applyFrame(int theFrame, float theFraction)
+{
+    const int aNext = theFrame + 1 < myNbFrames ? theFrame + 1 : (myToLoop ? 0 : theFrame);
+    const int aNbTracks = (int)myFrameValues.size() / 7;
+
+    // interpolation only reads the mapped file, so it runs in parallel;
+    // presentations are modified sequentially below
+    OSD_Parallel::For(0, aNbTracks, [&](int theTrack)
+    {
+        const float* aFrom = record(theFrame, theTrack);
+        const float* aTo   = record(aNext, theTrack);
+        float* aValues = myFrameValues.data() + (size_t)theTrack * 7;
+        if (theFraction <= 0.0f
+         || memcmp(aFrom, aTo, 7 * sizeof(float)) == 0)
+        {
+            std::copy(aFrom, aFrom + 7, aValues);
+            return;
+        }
+
+        for (int aComp = 0; aComp < 3; ++aComp)
+        {
+            aValues[aComp] = aFrom[aComp] + (aTo[aComp] - aFrom[aComp]) * theFraction;
+        }
+        gp_Quaternion aRot;
+        gp_QuaternionSLerp::Interpolate(gp_Quaternion(aFrom[3], aFrom[4], aFrom[5], aFrom[6]),
+                                        gp_Quaternion(aTo[3], aTo[4], aTo[5], aTo[6]), theFraction, aRot);
+        aValues[3] = (float)aRot.X();
+        aValues[4] = (float)aRot.Y();
+        aValues[5] = (float)aRot.Z();
+        aValues[6] = (float)aRot.W();
+    });
+
+    myNbApplied = 0;
+    const Handle(SelectMgr_SelectionManager)& aSelMgr = myContext->SelectionManager();
+    for (int aTrackIter = 0; aTrackIter < aNbTracks; ++aTrackIter)
+    {
+        Track& aTrack = myTracks[aTrackIter];
+        const float* aValues = myFrameValues.data() + (size_t)aTrackIter * 7;
+        if (memcmp(aValues, aTrack.Applied, sizeof(aTrack.Applied)) == 0)
+        {
+            continue;
+        }
+
+        std::copy(aValues, aValues + 7, aTrack.Applied);
+        gp_Quaternion aRot(aValues[3], aValues[4], aValues[5], aValues[6]);
+        aRot.Normalize();
+        gp_Trsf aMotion;
+        aMotion.SetRotation(aRot);
+        aMotion.SetTranslationPart(gp_Vec(aValues[0], aValues[1], aValues[2]));
+
+        // only the structure transformation changes, presentations are not recomputed
+        aTrack.Object->SetLocalTransformation(aMotion * aTrack.Base);
+        if (myToSelectEachFrame)
+        {
+            aSelMgr->Update(aTrack.Object, Standard_False);
+        }
+        else
+        {
+            aTrack.IsMoved = true;
+            myIsSelectionDirty = true;
+        }
+        ++myNbApplied;
+    }
+}
+
+// ================================================================
+// Function : updateSelection
+// Purpose  :
+// ================================================================
+void OcctMotionPlayer::updateSelection()
+{
+    if (!myIsSelectionDirty)
+    {
+        return;
+    }
+
+    OSD_Timer aTimer;
+    aTimer.Start();
+    const Handle(SelectMgr_SelectionManager)& aSelMgr = myContext->SelectionManager();
+    for (Track& aTrack : myTracks)
+    {
+        if (aTrack.IsMoved)
+        {
+            aSelMgr->Update(aTrack.Object, Standard_False);
+            aTrack.IsMoved = false;
+        }
+    }
+    myIsSelectionDirty = false;
+    aTimer.Stop();
+    mySelectionMs = aTimer.ElapsedTime() * 1000.0;
+}
+
+// ================================================================
+// Function : Update
+// Purpose  :
+// ================================================================
+void OcctMotionPlayer::Update()
+{
+    if (!IsOpen()
+     || myFrameValues.empty())
+    {
+        return;
+    }
+
+    if (myIsPlaying)
+    {
+        myTime = myClockTime + (float)myClock.ElapsedTime() * mySpeed;
+        const float aDuration = Duration();
+        if (myTime >= aDuration)
+        {
+            if (myToLoop && aDuration > 0.0f)
+            {
+                myTime = std::fmod(myTime, aDuration);
+            }
+            else
+            {
+                myTime = aDuration;
+                myIsPlaying = false;
+            }
+        }
+    }
+
+    if (myTime != myAppliedTime)
+    {
+        OSD_Timer aTimer;
+        aTimer.Start();
+        const float aFramePos = myTime * myFileRate;
+        const int aFrame = std::min((int)aFramePos, myNbFrames - 1);
+        applyFrame(aFrame, std::min(std::max(aFramePos - (float)aFrame, 0.0f), 1.0f));
+        aTimer.Stop();
+        myApplyMs = aTimer.ElapsedTime() * 1000.0;
+        myTotalApplyMs += myApplyMs;
+        myTotalApplied += myNbApplied;
+        myAppliedTime = myTime;
+        if (myNbApplied > 0)
+        {
+            myView->Invalidate();
+        }
+    }
+
+    // moved objects become pickable at their new places once the motion stops
+    if (!myIsPlaying)
+    {
+        updateSelection();
+    }
+}
+
+// ================================================================
+// Function : WriteSample
+// Purpose  :
+// ================================================================
+bool OcctMotionPlayer::WriteSample(const TCollection_AsciiString& thePath,
+                                   int theNbTracks, int theNbFrames, float theAmplitude)
+{
+    std::ofstream aFile(thePath.ToCString(), std::ios::binary);
+    if (!aFile)
+    {
+        return false;
+    }
+
+    const float aRate = 60.0f;
+    uint32_t aHeader[7] = { 1, (uint32_t)theNbTracks, (uint32_t)theNbFrames, 0, 0, 0, 0 };
+    memcpy(&aHeader[3], &aRate, sizeof(float));
+    aFile.write("OCMF", 4);
+    aFile.write(reinterpret_cast<const char*>(aHeader), sizeof(aHeader));
+
+    // each part bounces along Z and sways around it with its own phase;
+    // the period divides the frame count, so the motion loops seamlessly
+    std::vector<float> aFrame((size_t)theNbTracks * 8, 0.0f);
+    for (int aFrameIter = 0; aFrameIter < theNbFrames; ++aFrameIter)
+    {
+        const double aPhase = 2.0 * M_PI * aFrameIter / theNbFrames;
+        for (int aTrackIter = 0; aTrackIter < theNbTracks; ++aTrackIter)
+        {
+            const double anOffset = 0.37 * aTrackIter;
+            float* aRecord = aFrame.data() + (size_t)aTrackIter * 8;
+            aRecord[2] = theAmplitude * (float)std::sin(2.0 * aPhase + anOffset);
+            const gp_Quaternion aRot(gp_Vec(0.0, 0.0, 1.0), 0.05 * std::sin(aPhase + anOffset));
+            aRecord[3] = (float)aRot.X();
+            aRecord[4] = (float)aRot.Y();
+            aRecord[5] = (float)aRot.Z();
+            aRecord[6] = (float)aRot.W();
+        }
+        aFile.write(reinterpret_cast<const char*>(aFrame.data()), aFrame.size() * sizeof(float));
+    }
+    return aFile.good();
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctMotionPlayer::RenderGui()
+{
+    ImGui::Begin("Motion");
+    ImGui::InputText("File", myPathBuffer, sizeof(myPathBuffer));
+    if (ImGui::Button("Open"))
+    {
+        Open(myPathBuffer);
+    }
+    ImGui::SameLine();
+    ImGui::BeginDisabled(myTracks.empty());
+    if (ImGui::Button("Write sample"))
+    {
+        Close();
+        const Bnd_Box aBox = myView->View()->MinMaxValues();
+        const float anAmplitude = aBox.IsVoid() ? 1.0f : 0.02f * (float)std::sqrt(aBox.SquareExtent());
+        if (!WriteSample(myPathBuffer, (int)myTracks.size(), 600, anAmplitude))
+        {
+            Message::DefaultMessenger()->Send(TCollection_AsciiString("Unable to write '") + myPathBuffer + "'", Message_Fail);
+        }
+    }
+    ImGui::EndDisabled();
+    if (IsOpen())
+    {
+        ImGui::SameLine();
+        if (ImGui::Button("Close"))
+        {
+            Close();
+        }
+    }
+    ImGui::Text("Part instances: %d", (int)myTracks.size());
+    if (!IsOpen())
+    {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text("Tracks: %d  frames: %d at %.0f fps", myNbTracks, myNbFrames, myFileRate);
+    ImGui::SeparatorText("Playback");
+    if (ImGui::Button(myIsPlaying ? "Pause" : "Play", ImVec2(64.0f, 0.0f)))
+    {
+        myIsPlaying = !myIsPlaying;
+        if (myIsPlaying)
+        {
+            restartClock();
+        }
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Loop", &myToLoop);
+    if (ImGui::SliderFloat("Time, s", &myTime, 0.0f, Duration(), "%.2f"))
+    {
+        restartClock();
+    }
+    if (ImGui::SliderFloat("Speed", &mySpeed, 0.1f, 4.0f, "%.1fx"))
+    {
+        restartClock();
+    }
+    ImGui::Checkbox("Update selection every frame", &myToSelectEachFrame);
+
+    ImGui::SeparatorText("Statistics");
+    ImGui::Text("Moved objects: %d  frame: %.2f ms", myNbApplied, myApplyMs);
+    ImGui::Text("Per object: %.2f us (last)  %.2f us (average)",
+                myNbApplied > 0 ? myApplyMs * 1000.0 / myNbApplied : 0.0,
+                myTotalApplied > 0 ? myTotalApplyMs * 1000.0 / (double)myTotalApplied : 0.0);
+    ImGui::Text("Deferred selection update: %.2f ms", mySelectionMs);
+    ImGui::End();
+}
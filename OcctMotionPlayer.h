@@ -0,0 +1,138 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctMotionPlayer_Header
+#define _OcctMotionPlayer_Header
+
+#include "OcctMappedFile.h"
+#include "OcctOutliner.h"
+
+#include <AIS_InteractiveContext.hxx>
+#include <OSD_Timer.hxx>
+#include <V3d_View.hxx>
+
+#include <vector>
+
+//! Replay of recorded motion for assembly parts.
+//! The motion file is memory-mapped and has the following little-endian layout:
+//! @code
+//!   char[4]  "OCMF", uint32 version (1), uint32 nbTracks, uint32 nbFrames,
+//!   float32  framesPerSecond, uint32[3] reserved
+//!   { float32 tx, ty, tz, qx, qy, qz, qw, reserved } x nbTracks x nbFrames
+//! @endcode
+//! Track i drives the i-th part instance of the outliner (depth-first order);
+//! the recorded transformation is applied on top of the instance location.
+//! Frames are interpolated from the playback clock, so the motion does not depend on the redraw rate.
+//! Only local transformations of presentations are changed per frame: nothing is recomputed,
+//! tracks which did not move are skipped, and selection of moved objects is updated once when the playback stops.
+class OcctMotionPlayer
+{
+public:
+    //! Default constructor.
+    OcctMotionPlayer();
+
+    //! Attach the player to the interactive context and view.
+    void Init(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theView);
+
+    //! Bind tracks to part instances of the loaded assembly.
+    void SetAssembly(const OcctOutliner& theOutliner);
+
+    //! Map the motion file; returns false if the file is invalid.
+    bool Open(const TCollection_AsciiString& thePath);
+
+    //! Restore instance locations and unmap the file.
+    void Close();
+
+    //! Return true if motion is loaded.
+    bool IsOpen() const { return myFile.IsOpen(); }
+
+    //! Return true if the playback is running.
+    bool IsPlaying() const { return myIsPlaying; }
+
+    //! Return playback duration in seconds.
+    float Duration() const;
+
+    //! Apply transformations of the current playback time; should be called before redrawing the view.
+    void Update();
+
+    //! Render the playback panel.
+    void RenderGui();
+
+    //! Write a synthetic motion of theNbTracks parts oscillating with the amplitude.
+    static bool WriteSample(const TCollection_AsciiString& thePath,
+                            int theNbTracks, int theNbFrames, float theAmplitude);
+
+private:
+    //! Part instance driven by a track.
+    struct Track
+    {
+        Handle(AIS_InteractiveObject) Object;
+        gp_Trsf                       Base;       //!< instance location
+        float                         Applied[7]; //!< last applied translation and rotation
+        bool                          IsMoved;    //!< moved since the last selection update
+    };
+
+private:
+    //! Return record of the track at the frame.
+    const float* record(int theFrame, int theTrack) const
+    {
+        return reinterpret_cast<const float*>(myFile.Data() + 32) + ((size_t)theFrame * myNbTracks + theTrack) * 8;
+    }
+
+    //! Apply the frame with the fraction towards the next one.
+    void applyFrame(int theFrame, float theFraction);
+
+    //! Update selection of moved objects.
+    void updateSelection();
+
+    //! Restart the playback clock from the current time.
+    void restartClock();
+
+private:
+    Handle(AIS_InteractiveContext) myContext;
+    Handle(V3d_View)               myView;
+    OcctMappedFile                 myFile;
+    std::vector<Track>             myTracks;
+    std::vector<float>             myFrameValues;     //!< interpolated records of the frame, 7 floats per track
+    int                            myNbTracks;        //!< tracks within the file
+    int                            myNbFrames;
+    float                          myFileRate;        //!< recorded frames per second
+    float                          myTime;            //!< playback time in seconds
+    float                          myClockTime;       //!< playback time at the clock start
+    float                          myAppliedTime;     //!< playback time of the applied frame, negative if none
+    float                          mySpeed;
+    bool                           myIsPlaying;
+    bool                           myToLoop;
+    bool                           myToSelectEachFrame;
+    bool                           myIsSelectionDirty; //!< some tracks moved since the last selection update
+    OSD_Timer                      myClock;
+    int                            myNbApplied;       //!< objects moved by the last frame
+    double                         myApplyMs;         //!< time of the last frame
+    double                         mySelectionMs;     //!< time of the last selection update
+    double                         myTotalApplyMs;    //!< accumulated over myTotalApplied
+    long long                      myTotalApplied;
+    char                           myPathBuffer[512];
+};
+
+#endif // _OcctMotionPlayer_Header
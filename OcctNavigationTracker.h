@@ -0,0 +1,88 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctNavigationTracker_Header
+#define _OcctNavigationTracker_Header
+
+#include <Graphic3d_WorldViewProjState.hxx>
+#include <OSD_Timer.hxx>
+#include <V3d_View.hxx>
+
+//! Detects camera navigation from camera state changes between frames.
+//! Navigation is considered finished after the camera stays still for the idle delay.
+class OcctNavigationTracker
+{
+public:
+    //! Default constructor.
+    OcctNavigationTracker() : myIsNavigating(false), myIdleDelay(0.15) {}
+
+    //! Attach the tracker to the view.
+    void Init(const Handle(V3d_View)& theView)
+    {
+        myView = theView;
+        myCameraState = myView->Camera()->WorldViewProjState();
+        myIdleTimer.Start();
+    }
+
+    //! Update the state from the current camera; returns true while navigating.
+    bool Update()
+    {
+        if (myView.IsNull())
+        {
+            return false;
+        }
+
+        const Graphic3d_WorldViewProjState& aState = myView->Camera()->WorldViewProjState();
+        if (aState != myCameraState)
+        {
+            myCameraState = aState;
+            myIsNavigating = true;
+            myIdleTimer.Reset();
+            myIdleTimer.Start();
+        }
+        else if (myIsNavigating
+              && myIdleTimer.ElapsedTime() > myIdleDelay)
+        {
+            myIsNavigating = false;
+        }
+        return myIsNavigating;
+    }
+
+    //! Return true while navigating; the event loop should wake up after IdleDelay() to detect its end.
+    bool IsNavigating() const { return myIsNavigating; }
+
+    //! Return delay in seconds after the last camera change ending navigation.
+    double IdleDelay() const { return myIdleDelay; }
+
+    //! Set delay in seconds after the last camera change ending navigation.
+    void SetIdleDelay(double theDelay) { myIdleDelay = theDelay; }
+
+private:
+    Handle(V3d_View)             myView;
+    Graphic3d_WorldViewProjState myCameraState; //!< camera state of the previous frame
+    OSD_Timer                    myIdleTimer;   //!< time since the last camera change
+    bool                         myIsNavigating;
+    double                       myIdleDelay;
+};
+
+#endif // _OcctNavigationTracker_Header
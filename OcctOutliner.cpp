@@ -0,0 +1,497 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctOutliner.h"
+
+#include "OcctBatchDisplay.h"
+#include "imgui/imgui.h"
+
+#include <AIS_Shape.hxx>
+#include <BRepBndLib.hxx>
+#include <OSD_Timer.hxx>
+#include <TDataStd_Name.hxx>
+#include <TDF_LabelSequence.hxx>
+#include <TDF_Tool.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+
+#include <algorithm>
+
+namespace
+{
+    //! Return name of the label or of the referred shape.
+    static TCollection_AsciiString nodeName(const TDF_Label& theLabel, const TDF_Label& theShapeLabel)
+    {
+        Handle(TDataStd_Name) aName;
+        if (theLabel.FindAttribute(TDataStd_Name::GetID(), aName)
+         || theShapeLabel.FindAttribute(TDataStd_Name::GetID(), aName))
+        {
+            return TCollection_AsciiString(aName->Get());
+        }
+
+        TCollection_AsciiString anEntry;
+        TDF_Tool::Entry(theLabel, anEntry);
+        return anEntry;
+    }
+}
+
+// ================================================================
+// Function : OcctOutliner
+// Purpose  :
+// ================================================================
+OcctOutliner::OcctOutliner()
+    : myScrollToNode(-1),
+    myFrameMs(0.0)
+{
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctOutliner::Init(const Handle(AIS_InteractiveContext)& theCtx,
+                        const Handle(V3d_View)& theView)
+{
+    myContext = theCtx;
+    myView = theView;
+}
+
+// ================================================================
+// Function : SetDocument
+// Purpose  :
+// ================================================================
+void OcctOutliner::SetDocument(const Handle(TDocStd_Document)& theDoc)
+{
+    for (const Node& aNode : myNodes)
+    {
+        if (!aNode.Object.IsNull())
+        {
+            myContext->Remove(aNode.Object, false);
+        }
+    }
+    myNodes.clear();
+    myRows.clear();
+    mySelectedNodes.clear();
+    myObjectNodes.clear();
+    if (theDoc.IsNull())
+    {
+        return;
+    }
+
+    TDF_LabelSequence aFreeShapes;
+    XCAFDoc_DocumentTool::ShapeTool(theDoc->Main())->GetFreeShapes(aFreeShapes);
+    for (TDF_LabelSequence::Iterator aLabelIter(aFreeShapes); aLabelIter.More(); aLabelIter.Next())
+    {
+        addNode(aLabelIter.Value(), TopLoc_Location(), -1);
+    }
+
+    NCollection_Vector<Handle(AIS_InteractiveObject)> anObjects;
+    for (const Node& aNode : myNodes)
+    {
+        if (!aNode.Object.IsNull())
+        {
+            anObjects.Append(aNode.Object);
+        }
+    }
+    OcctBatchDisplay::Display(myContext, anObjects, AIS_Shaded, 0);
+
+    // top-level nodes are shown expanded
+    for (int aNodeIter = 0; aNodeIter < (int)myNodes.size(); aNodeIter = myNodes[aNodeIter].SubtreeEnd)
+    {
+        myRows.push_back(aNodeIter);
+    }
+    for (int aRow = (int)myRows.size() - 1; aRow >= 0; --aRow)
+    {
+        expandRow(aRow);
+    }
+}
+
+// ================================================================
+// Function : addNode
+// Purpose  :
+// ================================================================
+void OcctOutliner::addNode(const TDF_Label& theLabel, const TopLoc_Location& theParentLoc, int theParent)
+{
+    TDF_Label aShapeLabel = theLabel;
+    TopLoc_Location aLoc = theParentLoc;
+    if (XCAFDoc_ShapeTool::IsReference(theLabel))
+    {
+        XCAFDoc_ShapeTool::GetReferredShape(theLabel, aShapeLabel);
+        aLoc = theParentLoc * XCAFDoc_ShapeTool::GetLocation(theLabel);
+    }
+
+    Node aNode;
+    aNode.Label = theLabel;
+    aNode.Name = nodeName(theLabel, aShapeLabel);
+    aNode.Location = aLoc;
+    aNode.Parent = theParent;
+    aNode.Depth = theParent >= 0 ? myNodes[theParent].Depth + 1 : 0;
+    aNode.SubtreeEnd = 0;
+    aNode.IsExpanded = false;
+    aNode.IsVisible = true;
+    aNode.IsSelected = false;
+
+    const int anIndex = (int)myNodes.size();
+    myNodes.push_back(aNode);
+    if (XCAFDoc_ShapeTool::IsAssembly(aShapeLabel))
+    {
+        TDF_LabelSequence aComponents;
+        XCAFDoc_ShapeTool::GetComponents(aShapeLabel, aComponents);
+        for (TDF_LabelSequence::Iterator aCompIter(aComponents); aCompIter.More(); aCompIter.Next())
+        {
+            addNode(aCompIter.Value(), aLoc, anIndex);
+        }
+    }
+    else
+    {
+        // instances share the part shape and differ by local transformation only
+        const TopoDS_Shape aShape = XCAFDoc_ShapeTool::GetShape(aShapeLabel);
+        if (!aShape.IsNull())
+        {
+            Handle(AIS_Shape) aPrs = new AIS_Shape(aShape);
+            aPrs->SetDisplayMode(AIS_Shaded);
+            if (!aLoc.IsIdentity())
+            {
+                aPrs->SetLocalTransformation(aLoc.Transformation());
+            }
+            myNodes[anIndex].Object = aPrs;
+            myObjectNodes[aPrs.get()] = anIndex;
+        }
+    }
+    myNodes[anIndex].SubtreeEnd = (int)myNodes.size();
+}
+
+// ================================================================
+// Function : FindNode
+// Purpose  :
+// ================================================================
+int OcctOutliner::FindNode(const Handle(AIS_InteractiveObject)& theObject) const
+{
+    std::unordered_map<const AIS_InteractiveObject*, int>::const_iterator aFound = myObjectNodes.find(theObject.get());
+    return aFound != myObjectNodes.end() ? aFound->second : -1;
+}
+
+// ================================================================
+// Function : findRow
+// Purpose  :
+// ================================================================
+int OcctOutliner::findRow(int theNode) const
+{
+    std::vector<int>::const_iterator aFound = std::lower_bound(myRows.begin(), myRows.end(), theNode);
+    return aFound != myRows.end() && *aFound == theNode ? int(aFound - myRows.begin()) : -1;
+}
+
+// ================================================================
+// Function : expandRow
+// Purpose  :
+// ================================================================
+void OcctOutliner::expandRow(int theRow)
+{
+    Node& aNode = myNodes[myRows[theRow]];
+    if (aNode.IsExpanded)
+    {
+        return;
+    }
+    aNode.IsExpanded = true;
+
+    std::vector<int> aNewRows;
+    for (int aChild = myRows[theRow] + 1; aChild < aNode.SubtreeEnd; )
+    {
+        aNewRows.push_back(aChild);
+        aChild = myNodes[aChild].IsExpanded ? aChild + 1 : myNodes[aChild].SubtreeEnd;
+    }
+    myRows.insert(myRows.begin() + theRow + 1, aNewRows.begin(), aNewRows.end());
+}
+
+// ================================================================
+// Function : collapseRow
+// Purpose  :
+// ================================================================
+void OcctOutliner::collapseRow(int theRow)
+{
+    Node& aNode = myNodes[myRows[theRow]];
+    if (!aNode.IsExpanded)
+    {
+        return;
+    }
+    aNode.IsExpanded = false;
+
+    std::vector<int>::iterator aFirst = myRows.begin() + theRow + 1;
+    myRows.erase(aFirst, std::lower_bound(aFirst, myRows.end(), aNode.SubtreeEnd));
+}
+
+// ================================================================
+// Function : SetNodeVisible
+// Purpose  :
+// ================================================================
+void OcctOutliner::SetNodeVisible(int theNode, bool theIsVisible)
+{
+    for (int aNodeIter = theNode; aNodeIter < myNodes[theNode].SubtreeEnd; ++aNodeIter)
+    {
+        Node& aNode = myNodes[aNodeIter];
+        aNode.IsVisible = theIsVisible;
+        if (aNode.Object.IsNull()
+         || myContext->IsDisplayed(aNode.Object) == theIsVisible)
+        {
+            continue;
+        }
+
+        if (theIsVisible)
+        {
+            myContext->Display(aNode.Object, false);
+        }
+        else
+        {
+            myContext->Erase(aNode.Object, false);
+        }
+    }
+    if (theIsVisible)
+    {
+        for (int aParent = myNodes[theNode].Parent; aParent >= 0; aParent = myNodes[aParent].Parent)
+        {
+            myNodes[aParent].IsVisible = true;
+        }
+    }
+    myView->Invalidate();
+}
+
+// ================================================================
+// Function : SelectNodes
+// Purpose  :
+// ================================================================
+void OcctOutliner::SelectNodes(const std::vector<int>& theNodes)
+{
+    for (int aNode : mySelectedNodes)
+    {
+        myNodes[aNode].IsSelected = false;
+    }
+    mySelectedNodes.clear();
+
+    myContext->ClearSelected(false);
+    for (int aSelNode : theNodes)
+    {
+        for (int aNodeIter = aSelNode; aNodeIter < myNodes[aSelNode].SubtreeEnd; ++aNodeIter)
+        {
+            const Node& aNode = myNodes[aNodeIter];
+            if (!aNode.Object.IsNull()
+              && myContext->IsDisplayed(aNode.Object)
+              && !myContext->IsSelected(aNode.Object))
+            {
+                myContext->AddOrRemoveSelected(aNode.Object, false);
+            }
+        }
+        myNodes[aSelNode].IsSelected = true;
+        mySelectedNodes.push_back(aSelNode);
+    }
+    myView->Invalidate();
+}
+
+// ================================================================
+// Function : IsolateNodes
+// Purpose  :
+// ================================================================
+void OcctOutliner::IsolateNodes(const std::vector<int>& theNodes)
+{
+    for (int aNodeIter = 0; aNodeIter < (int)myNodes.size(); aNodeIter = myNodes[aNodeIter].SubtreeEnd)
+    {
+        SetNodeVisible(aNodeIter, false);
+    }
+    for (int aNode : theNodes)
+    {
+        SetNodeVisible(aNode, true);
+    }
+}
+
+// ================================================================
+// Function : ShowAll
+// Purpose  :
+// ================================================================
+void OcctOutliner::ShowAll()
+{
+    for (int aNodeIter = 0; aNodeIter < (int)myNodes.size(); aNodeIter = myNodes[aNodeIter].SubtreeEnd)
+    {
+        SetNodeVisible(aNodeIter, true);
+    }
+}
+
+// ================================================================
+// Function : FitNodes
+// Purpose  :
+// ================================================================
+void OcctOutliner::FitNodes(const std::vector<int>& theNodes)
+{
+    Bnd_Box aBox;
+    for (int aFitNode : theNodes)
+    {
+        for (int aNodeIter = aFitNode; aNodeIter < myNodes[aFitNode].SubtreeEnd; ++aNodeIter)
+        {
+            Handle(AIS_Shape) aPrs = Handle(AIS_Shape)::DownCast(myNodes[aNodeIter].Object);
+            if (!aPrs.IsNull())
+            {
+                BRepBndLib::Add(aPrs->Shape().Moved(myNodes[aNodeIter].Location), aBox);
+            }
+        }
+    }
+    if (!aBox.IsVoid())
+    {
+        myView->FitAll(aBox, 0.1, false);
+        myView->Invalidate();
+    }
+}
+
+// ================================================================
+// Function : SyncSelection
+// Purpose  :
+// ================================================================
+void OcctOutliner::SyncSelection()
+{
+    for (int aNode : mySelectedNodes)
+    {
+        myNodes[aNode].IsSelected = false;
+    }
+    mySelectedNodes.clear();
+
+    for (myContext->InitSelected(); myContext->MoreSelected(); myContext->NextSelected())
+    {
+        const int aNode = FindNode(myContext->SelectedInteractive());
+        if (aNode >= 0 && !myNodes[aNode].IsSelected)
+        {
+            myNodes[aNode].IsSelected = true;
+            mySelectedNodes.push_back(aNode);
+        }
+    }
+    if (!mySelectedNodes.empty())
+    {
+        RevealNode(mySelectedNodes.front());
+    }
+}
+
+// ================================================================
+// Function : RevealNode
+// Purpose  :
+// ================================================================
+void OcctOutliner::RevealNode(int theNode)
+{
+    std::vector<int> anAncestors;
+    for (int aParent = myNodes[theNode].Parent; aParent >= 0; aParent = myNodes[aParent].Parent)
+    {
+        anAncestors.push_back(aParent);
+    }
+    for (std::vector<int>::reverse_iterator anIter = anAncestors.rbegin(); anIter != anAncestors.rend(); ++anIter)
+    {
+        const int aRow = findRow(*anIter);
+        if (aRow >= 0)
+        {
+            expandRow(aRow);
+        }
+    }
+    myScrollToNode = theNode;
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctOutliner::RenderGui()
+{
+    OSD_Timer aTimer;
+    aTimer.Start();
+
+    ImGui::Begin("Outliner");
+    ImGui::Text("Nodes: %d  rows: %d  %.3f ms", (int)myNodes.size(), (int)myRows.size(), myFrameMs);
+    ImGui::BeginChild("##rows");
+
+    const float aRowHeight = ImGui::GetFrameHeightWithSpacing();
+    if (myScrollToNode >= 0)
+    {
+        const int aRow = findRow(myScrollToNode);
+        if (aRow >= 0)
+        {
+            ImGui::SetScrollY(std::max(aRow * aRowHeight - 0.5f * ImGui::GetWindowHeight(), 0.0f));
+        }
+        myScrollToNode = -1;
+    }
+
+    // changes of rows are deferred until the clipper is done
+    int aToggleRow = -1, aVisibleNode = -1, aSelectNode = -1;
+    bool toShow = false;
+    ImGuiListClipper aClipper;
+    aClipper.Begin((int)myRows.size(), aRowHeight);
+    while (aClipper.Step())
+    {
+        for (int aRow = aClipper.DisplayStart; aRow < aClipper.DisplayEnd; ++aRow)
+        {
+            const int aNodeIndex = myRows[aRow];
+            const Node& aNode = myNodes[aNodeIndex];
+            ImGui::PushID(aNodeIndex);
+            ImGui::SetCursorPosX(ImGui::GetCursorPosX() + aNode.Depth * ImGui::GetStyle().IndentSpacing);
+            if (aNode.SubtreeEnd > aNodeIndex + 1)
+            {
+                if (ImGui::ArrowButton("##expand", aNode.IsExpanded ? ImGuiDir_Down : ImGuiDir_Right))
+                {
+                    aToggleRow = aRow;
+                }
+            }
+            else
+            {
+                ImGui::Dummy(ImVec2(ImGui::GetFrameHeight(), ImGui::GetFrameHeight()));
+            }
+            ImGui::SameLine();
+            bool isVisible = aNode.IsVisible;
+            if (ImGui::Checkbox("##visible", &isVisible))
+            {
+                aVisibleNode = aNodeIndex;
+                toShow = isVisible;
+            }
+            ImGui::SameLine();
+            if (ImGui::Selectable(aNode.Name.ToCString(), aNode.IsSelected))
+            {
+                aSelectNode = aNodeIndex;
+            }
+            ImGui::PopID();
+        }
+    }
+    ImGui::EndChild();
+    ImGui::End();
+
+    if (aToggleRow >= 0)
+    {
+        if (myNodes[myRows[aToggleRow]].IsExpanded)
+        {
+            collapseRow(aToggleRow);
+        }
+        else
+        {
+            expandRow(aToggleRow);
+        }
+    }
+    if (aVisibleNode >= 0)
+    {
+        SetNodeVisible(aVisibleNode, toShow);
+    }
+    if (aSelectNode >= 0)
+    {
+        SelectNode(aSelectNode);
+    }
+    myFrameMs = aTimer.ElapsedTime() * 1000.0;
+}
@@ -0,0 +1,127 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctOutliner_Header
+#define _OcctOutliner_Header
+
+#include <AIS_InteractiveContext.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <TDF_Label.hxx>
+#include <TDocStd_Document.hxx>
+#include <TopLoc_Location.hxx>
+#include <V3d_View.hxx>
+
+#include <unordered_map>
+#include <vector>
+
+//! Assembly outliner over XCAF label tree.
+//! Nodes are stored flat in depth-first order, so that the subtree of a node is a contiguous range.
+//! Only expanded nodes are flattened into the cached array of visible rows,
+//! and only rows on screen are emitted through ImGuiListClipper.
+class OcctOutliner
+{
+public:
+    //! Outliner node - free shape or component instance.
+    struct Node
+    {
+        TDF_Label                     Label;      //!< free shape or component label
+        TCollection_AsciiString       Name;
+        TopLoc_Location               Location;   //!< accumulated location of the instance
+        Handle(AIS_InteractiveObject) Object;     //!< presentation of the leaf part
+        int                           Parent;
+        int                           Depth;
+        int                           SubtreeEnd; //!< index following the last descendant
+        bool                          IsExpanded;
+        bool                          IsVisible;
+        bool                          IsSelected;
+    };
+
+public:
+    //! Default constructor.
+    OcctOutliner();
+
+    //! Attach the outliner to the interactive context and view.
+    void Init(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theView);
+
+    //! Build the node tree from the document and display a presentation for each leaf part.
+    void SetDocument(const Handle(TDocStd_Document)& theDoc);
+
+    //! Return nodes in depth-first order.
+    const std::vector<Node>& Nodes() const { return myNodes; }
+
+    //! Return node displaying the object or -1.
+    int FindNode(const Handle(AIS_InteractiveObject)& theObject) const;
+
+    //! Update node selection from the interactive context.
+    void SyncSelection();
+
+    //! Select objects of the node subtree in the interactive context.
+    void SelectNode(int theNode) { SelectNodes(std::vector<int>(1, theNode)); }
+
+    //! Select objects of the node subtrees in the interactive context.
+    void SelectNodes(const std::vector<int>& theNodes);
+
+    //! Show or hide the node subtree.
+    void SetNodeVisible(int theNode, bool theIsVisible);
+
+    //! Hide everything except the node subtrees.
+    void IsolateNodes(const std::vector<int>& theNodes);
+
+    //! Show all nodes.
+    void ShowAll();
+
+    //! Fit the node subtrees into the view.
+    void FitNodes(const std::vector<int>& theNodes);
+
+    //! Expand all ancestors of the node and scroll to it.
+    void RevealNode(int theNode);
+
+    //! Render the outliner panel.
+    void RenderGui();
+
+private:
+    //! Append the node and its descendants.
+    void addNode(const TDF_Label& theLabel, const TopLoc_Location& theParentLoc, int theParent);
+
+    //! Return row of the node within visible rows or -1.
+    int findRow(int theNode) const;
+
+    //! Insert visible descendants of the node after its row.
+    void expandRow(int theRow);
+
+    //! Remove descendants of the node from visible rows.
+    void collapseRow(int theRow);
+
+private:
+    Handle(AIS_InteractiveContext)                        myContext;
+    Handle(V3d_View)                                      myView;
+    std::vector<Node>                                     myNodes;
+    std::vector<int>                                      myRows;          //!< visible nodes, sorted by index
+    std::vector<int>                                      mySelectedNodes;
+    std::unordered_map<const AIS_InteractiveObject*, int> myObjectNodes;
+    int                                                   myScrollToNode;
+    double                                                myFrameMs;
+};
+
+#endif // _OcctOutliner_Header
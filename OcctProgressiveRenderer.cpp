@@ -0,0 +1,190 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctProgressiveRenderer.h"
+
+#include "imgui/imgui.h"
+
+#include <cmath>
+
+// ================================================================
+// Function : OcctProgressiveRenderer
+// Purpose  :
+// ================================================================
+OcctProgressiveRenderer::OcctProgressiveRenderer()
+    : mySavedMethod(Graphic3d_RM_RASTERIZATION),
+    mySavedGi(Standard_False),
+    mySavedScale(1.0f),
+    myIsEnabled(false),
+    myIsAccumulating(false),
+    myBudgetMs(30.0f),
+    myTargetSamples(256),
+    myNbSamples(0),
+    myLastSampleMs(0.0)
+{
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctProgressiveRenderer::Init(const Handle(V3d_View)& theView)
+{
+    myView = theView;
+}
+
+// ================================================================
+// Function : SetEnabled
+// Purpose  :
+// ================================================================
+void OcctProgressiveRenderer::SetEnabled(bool theIsEnabled)
+{
+    if (myIsEnabled == theIsEnabled)
+    {
+        return;
+    }
+
+    myIsEnabled = theIsEnabled;
+    Graphic3d_RenderingParams& aParams = myView->ChangeRenderingParams();
+    if (myIsEnabled)
+    {
+        mySavedMethod = aParams.Method;
+        mySavedGi     = aParams.IsGlobalIlluminationEnabled;
+    }
+    else
+    {
+        aParams.Method                      = mySavedMethod;
+        aParams.IsGlobalIlluminationEnabled = mySavedGi;
+        myIsAccumulating = false;
+        myNbSamples      = 0;
+    }
+    myView->Invalidate();
+}
+
+// ================================================================
+// Function : Update
+// Purpose  :
+// ================================================================
+void OcctProgressiveRenderer::Update(bool theIsNavigating)
+{
+    myFrameTimer.Reset();
+    myFrameTimer.Start();
+    if (!myIsEnabled)
+    {
+        return;
+    }
+
+    Graphic3d_RenderingParams& aParams = myView->ChangeRenderingParams();
+    if (theIsNavigating)
+    {
+        aParams.Method   = Graphic3d_RM_RASTERIZATION;
+        myIsAccumulating = false;
+        myNbSamples      = 0;
+        return;
+    }
+
+    // view invalidation comes from scene, size or camera changes, as accumulation frames are requested by continuous redraw
+    bool isChanged = myView->IsInvalidated()
+                  || aParams.RenderResolutionScale != mySavedScale;
+    if (aParams.Method != Graphic3d_RM_RAYTRACING
+    || !aParams.IsGlobalIlluminationEnabled)
+    {
+        aParams.Method                      = Graphic3d_RM_RAYTRACING;
+        aParams.IsGlobalIlluminationEnabled = Standard_True;
+        myView->Invalidate();
+        isChanged = true;
+    }
+    mySavedScale = aParams.RenderResolutionScale;
+    if (isChanged)
+    {
+        myNbSamples = 0;
+        myAccumTimer.Reset();
+        myAccumTimer.Start();
+    }
+    myIsAccumulating = myNbSamples < myTargetSamples;
+}
+
+// ================================================================
+// Function : Accumulate
+// Purpose  :
+// ================================================================
+void OcctProgressiveRenderer::Accumulate(const Handle(OpenGl_Context)& theGlCtx)
+{
+    if (!myIsAccumulating)
+    {
+        return;
+    }
+
+    // the frame redraw has already added one sample;
+    // glFinish() makes the budget account GPU time instead of queued commands
+    ++myNbSamples;
+    theGlCtx->core11fwd->glFinish();
+    for (;;)
+    {
+        const double aFrameMs = myFrameTimer.ElapsedTime() * 1000.0;
+        if (myNbSamples >= myTargetSamples
+         || aFrameMs + myLastSampleMs > myBudgetMs)
+        {
+            break;
+        }
+
+        myView->Redraw();
+        theGlCtx->core11fwd->glFinish();
+        myLastSampleMs = myFrameTimer.ElapsedTime() * 1000.0 - aFrameMs;
+        ++myNbSamples;
+    }
+    myIsAccumulating = myNbSamples < myTargetSamples;
+    if (!myIsAccumulating)
+    {
+        myAccumTimer.Stop();
+    }
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctProgressiveRenderer::RenderGui()
+{
+    ImGui::Begin("Progressive Rendering");
+    bool isEnabled = myIsEnabled;
+    if (ImGui::Checkbox("Path tracing when idle", &isEnabled))
+    {
+        SetEnabled(isEnabled);
+    }
+    ImGui::SliderFloat("Frame budget, ms", &myBudgetMs, 5.0f, 200.0f, "%.0f");
+    if (ImGui::SliderInt("Target samples", &myTargetSamples, 1, 4096))
+    {
+        myIsAccumulating = myIsEnabled && myNbSamples < myTargetSamples;
+    }
+
+    ImGui::SeparatorText("Accumulation");
+    const double aSeconds = myAccumTimer.ElapsedTime();
+    ImGui::Text("Samples: %d / %d", myNbSamples, myTargetSamples);
+    ImGui::Text("%.1f samples/s, %.1f ms/sample", aSeconds > 0.0 ? myNbSamples / aSeconds : 0.0, myLastSampleMs);
+
+    // Monte Carlo noise decreases as 1/sqrt(N)
+    ImGui::ProgressBar(float(myNbSamples) / float(myTargetSamples), ImVec2(-1.0f, 0.0f));
+    ImGui::Text("Relative noise: %.1f %%", myNbSamples > 0 ? 100.0 / std::sqrt(double(myNbSamples)) : 100.0);
+    ImGui::End();
+}
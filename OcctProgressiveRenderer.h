@@ -0,0 +1,79 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctProgressiveRenderer_Header
+#define _OcctProgressiveRenderer_Header
+
+#include <OpenGl_Context.hxx>
+#include <OSD_Timer.hxx>
+#include <V3d_View.hxx>
+
+//! Budgeted progressive path tracing.
+//! While the camera moves the view is rasterized; once it stops, Graphic3d_RM_RAYTRACING with global illumination
+//! is enabled and OpenGl_View accumulates one sample per pixel per redraw.
+//! Each frame renders as many samples as fit into the time budget and then returns to the event loop,
+//! so that input is processed between accumulation steps. Accumulation restarts on any view change
+//! and stops when the target number of samples is reached.
+class OcctProgressiveRenderer
+{
+public:
+    //! Default constructor.
+    OcctProgressiveRenderer();
+
+    //! Attach the renderer to the view.
+    void Init(const Handle(V3d_View)& theView);
+
+    //! Return true if the progressive mode is enabled.
+    bool IsEnabled() const { return myIsEnabled; }
+
+    //! Enable or disable the progressive mode.
+    void SetEnabled(bool theIsEnabled);
+
+    //! Return true if samples are being accumulated, so that the view should be redrawn continuously.
+    bool IsAccumulating() const { return myIsAccumulating; }
+
+    //! Switch the rendering method and restart accumulation on view changes; should be called before the view redraw.
+    void Update(bool theIsNavigating);
+
+    //! Render extra samples within the frame budget; should be called after the view redraw.
+    void Accumulate(const Handle(OpenGl_Context)& theGlCtx);
+
+    //! Render the panel with sampling rate and convergence.
+    void RenderGui();
+
+private:
+    Handle(V3d_View)        myView;
+    OSD_Timer               myFrameTimer;       //!< time spent in the current frame
+    OSD_Timer               myAccumTimer;       //!< time since accumulation restart
+    Graphic3d_RenderingMode mySavedMethod;      //!< rendering method before enabling
+    Standard_Boolean        mySavedGi;          //!< global illumination flag before enabling
+    float                   mySavedScale;       //!< resolution scale of the accumulated frame
+    bool                    myIsEnabled;
+    bool                    myIsAccumulating;
+    float                   myBudgetMs;         //!< per-frame time budget
+    int                     myTargetSamples;    //!< samples per pixel to stop at
+    int                     myNbSamples;        //!< samples accumulated since restart
+    double                  myLastSampleMs;
+};
+
+#endif // _OcctProgressiveRenderer_Header
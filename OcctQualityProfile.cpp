@@ -0,0 +1,186 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctQualityProfile.h"
+
+#include "imgui/imgui.h"
+
+// ================================================================
+// Function : OcctQualityProfile
+// Purpose  :
+// ================================================================
+OcctQualityProfile::OcctQualityProfile()
+    : myFullCullingSize(0.0),
+    myInteractiveCullingSize(4.0f),
+    myIsEnabled(true),
+    myIsInteractive(false),
+    myFullSeconds(0.0),
+    myInteractiveSeconds(0.0),
+    myNbSwitches(0)
+{
+    myInteractiveParams.NbMsaaSamples = 0;
+    myInteractiveParams.TransparencyMethod = Graphic3d_RTM_BLEND_UNORDERED;
+    myInteractiveParams.Method = Graphic3d_RM_RASTERIZATION;
+    myInteractiveParams.IsShadowEnabled = Standard_False;
+    myInteractiveParams.IsReflectionEnabled = Standard_False;
+    myInteractiveParams.IsAntialiasingEnabled = Standard_False;
+    myInteractiveParams.IsGlobalIlluminationEnabled = Standard_False;
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctQualityProfile::Init(const Handle(V3d_View)& theView)
+{
+    myView = theView;
+    myProfileTimer.Start();
+}
+
+// ================================================================
+// Function : copyProfile
+// Purpose  :
+// ================================================================
+void OcctQualityProfile::copyProfile(const Graphic3d_RenderingParams& theFrom, Graphic3d_RenderingParams& theTo)
+{
+    theTo.Method                      = theFrom.Method;
+    theTo.NbMsaaSamples               = theFrom.NbMsaaSamples;
+    theTo.TransparencyMethod          = theFrom.TransparencyMethod;
+    theTo.IsShadowEnabled             = theFrom.IsShadowEnabled;
+    theTo.IsReflectionEnabled         = theFrom.IsReflectionEnabled;
+    theTo.IsAntialiasingEnabled       = theFrom.IsAntialiasingEnabled;
+    theTo.IsGlobalIlluminationEnabled = theFrom.IsGlobalIlluminationEnabled;
+}
+
+// ================================================================
+// Function : setCullingSize
+// Purpose  :
+// ================================================================
+void OcctQualityProfile::setCullingSize(Standard_Real theSize)
+{
+    const Handle(V3d_Viewer)& aViewer = myView->Viewer();
+    Graphic3d_ZLayerSettings aSettings = aViewer->ZLayerSettings(Graphic3d_ZLayerId_Default);
+    aSettings.SetCullingSize(theSize);
+    aViewer->SetZLayerSettings(Graphic3d_ZLayerId_Default, aSettings);
+}
+
+// ================================================================
+// Function : Update
+// Purpose  :
+// ================================================================
+void OcctQualityProfile::Update(bool theIsNavigating)
+{
+    const bool toBeInteractive = myIsEnabled && theIsNavigating;
+    if (myView.IsNull()
+     || toBeInteractive == myIsInteractive)
+    {
+        return;
+    }
+
+    (myIsInteractive ? myInteractiveSeconds : myFullSeconds) += myProfileTimer.ElapsedTime();
+    myProfileTimer.Reset();
+    myProfileTimer.Start();
+    myIsInteractive = toBeInteractive;
+
+    Graphic3d_RenderingParams& aParams = myView->ChangeRenderingParams();
+    if (myIsInteractive)
+    {
+        // the full profile is captured each time to respect changes made while idle
+        copyProfile(aParams, myFullParams);
+        copyProfile(myInteractiveParams, aParams);
+        myFullCullingSize = myView->Viewer()->ZLayerSettings(Graphic3d_ZLayerId_Default).CullingSize();
+        setCullingSize(myInteractiveCullingSize > 0.0f ? Standard_Real(myInteractiveCullingSize) : myFullCullingSize);
+        ++myNbSwitches;
+    }
+    else
+    {
+        copyProfile(myFullParams, aParams);
+        setCullingSize(myFullCullingSize);
+    }
+    myView->Invalidate();
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctQualityProfile::RenderGui(OcctNavigationTracker& theNavigation)
+{
+    ImGui::Begin("Interactive Profile");
+    bool isEnabled = myIsEnabled;
+    if (ImGui::Checkbox("Degrade while navigating", &isEnabled))
+    {
+        Update(false);
+        myIsEnabled = isEnabled;
+    }
+
+    float anIdleMs = float(theNavigation.IdleDelay() * 1000.0);
+    if (ImGui::SliderFloat("Idle delay, ms", &anIdleMs, 0.0f, 1000.0f, "%.0f"))
+    {
+        theNavigation.SetIdleDelay(anIdleMs / 1000.0);
+    }
+
+    // changes apply from the next navigation
+    ImGui::SeparatorText("While navigating");
+    int aNbSamples = myInteractiveParams.NbMsaaSamples;
+    if (ImGui::SliderInt("MSAA samples", &aNbSamples, 0, 8))
+    {
+        myInteractiveParams.NbMsaaSamples = aNbSamples;
+    }
+    bool isOit = myInteractiveParams.TransparencyMethod != Graphic3d_RTM_BLEND_UNORDERED;
+    if (ImGui::Checkbox("Order-independent transparency", &isOit))
+    {
+        myInteractiveParams.TransparencyMethod = isOit ? Graphic3d_RTM_BLEND_OIT : Graphic3d_RTM_BLEND_UNORDERED;
+    }
+    bool isRayTracing = myInteractiveParams.Method == Graphic3d_RM_RAYTRACING;
+    if (ImGui::Checkbox("Ray tracing", &isRayTracing))
+    {
+        myInteractiveParams.Method = isRayTracing ? Graphic3d_RM_RAYTRACING : Graphic3d_RM_RASTERIZATION;
+    }
+    bool aFlag = myInteractiveParams.IsShadowEnabled == Standard_True;
+    if (ImGui::Checkbox("Shadows", &aFlag))
+    {
+        myInteractiveParams.IsShadowEnabled = aFlag;
+    }
+    aFlag = myInteractiveParams.IsReflectionEnabled == Standard_True;
+    if (ImGui::Checkbox("Reflections", &aFlag))
+    {
+        myInteractiveParams.IsReflectionEnabled = aFlag;
+    }
+    aFlag = myInteractiveParams.IsAntialiasingEnabled == Standard_True;
+    if (ImGui::Checkbox("Ray-traced anti-aliasing", &aFlag))
+    {
+        myInteractiveParams.IsAntialiasingEnabled = aFlag;
+    }
+    ImGui::SliderFloat("Cull smaller than, px", &myInteractiveCullingSize, 0.0f, 32.0f, "%.0f");
+
+    ImGui::SeparatorText("Statistics");
+    const double aCurrent = myProfileTimer.ElapsedTime();
+    ImGui::Text("Profile: %s", myIsInteractive ? "interactive" : "full");
+    ImGui::Text("Full: %.1f s  interactive: %.1f s",
+                myFullSeconds + (myIsInteractive ? 0.0 : aCurrent),
+                myInteractiveSeconds + (myIsInteractive ? aCurrent : 0.0));
+    ImGui::Text("Switches: %d  avg. navigation: %.2f s", myNbSwitches,
+                myNbSwitches > 0 ? (myInteractiveSeconds + (myIsInteractive ? aCurrent : 0.0)) / myNbSwitches : 0.0);
+    ImGui::End();
+}
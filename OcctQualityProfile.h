@@ -0,0 +1,81 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctQualityProfile_Header
+#define _OcctQualityProfile_Header
+
+#include "OcctNavigationTracker.h"
+
+#include <Graphic3d_RenderingParams.hxx>
+#include <Graphic3d_ZLayerSettings.hxx>
+#include <OSD_Timer.hxx>
+#include <V3d_View.hxx>
+
+//! Interaction-time quality degradation.
+//! The interactive profile is a set of Graphic3d_RenderingParams fields (MSAA, transparency method,
+//! shadows, reflections, ray tracing) plus size culling of the default Z-layer,
+//! which is applied when navigation starts and rolled back to the full profile once it ends.
+//! Switching touches only those fields and never recomputes presentations.
+class OcctQualityProfile
+{
+public:
+    //! Default constructor.
+    OcctQualityProfile();
+
+    //! Attach the profile to the view.
+    void Init(const Handle(V3d_View)& theView);
+
+    //! Return the interactive profile for modification.
+    Graphic3d_RenderingParams& ChangeInteractiveParams() { return myInteractiveParams; }
+
+    //! Return true if the interactive profile is applied.
+    bool IsInteractive() const { return myIsInteractive; }
+
+    //! Switch the profile according to navigation state.
+    void Update(bool theIsNavigating);
+
+    //! Render the profile panel with time spent in each profile and the switch delay of the tracker.
+    void RenderGui(OcctNavigationTracker& theNavigation);
+
+private:
+    //! Copy fields controlled by the profile.
+    static void copyProfile(const Graphic3d_RenderingParams& theFrom, Graphic3d_RenderingParams& theTo);
+
+    //! Set culling size of the default Z-layer.
+    void setCullingSize(Standard_Real theSize);
+
+private:
+    Handle(V3d_View)          myView;
+    Graphic3d_RenderingParams myInteractiveParams;
+    Graphic3d_RenderingParams myFullParams;        //!< full profile saved when navigation starts
+    Standard_Real             myFullCullingSize;
+    float                     myInteractiveCullingSize; //!< objects smaller than this size in pixels are skipped
+    bool                      myIsEnabled;
+    bool                      myIsInteractive;
+    OSD_Timer                 myProfileTimer;      //!< time in the current profile
+    double                    myFullSeconds;
+    double                    myInteractiveSeconds;
+    int                       myNbSwitches;
+};
+
+#endif // _OcctQualityProfile_Header
@@ -0,0 +1,548 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctRefinementService.h"
+
+#include "imgui/imgui.h"
+
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <OSD_Parallel.hxx>
+#include <OSD_Timer.hxx>
+#include <TopExp.hxx>
+#include <TopoDS.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+// ================================================================
+// Function : OcctRefinementService
+// Purpose  :
+// ================================================================
+OcctRefinementService::OcctRefinementService()
+    : myIsRunning(false),
+    myToCancel(false),
+    myIsEnabled(true),
+    myTolerancePx(1.0f),
+    myBudgetMs(4.0f),
+    myNbRefined(0),
+    myNbReleased(0),
+    myRefinedTris(0),
+    myJobMs(0.0),
+    myCheckMs(0.0),
+    mySwapMs(0.0)
+{
+}
+
+// ================================================================
+// Function : ~OcctRefinementService
+// Purpose  :
+// ================================================================
+OcctRefinementService::~OcctRefinementService()
+{
+    Cancel();
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctRefinementService::Init(const Handle(AIS_InteractiveContext)& theCtx,
+                                 const Handle(V3d_View)& theView)
+{
+    myContext = theCtx;
+    myView = theView;
+}
+
+// ================================================================
+// Function : Cancel
+// Purpose  :
+// ================================================================
+void OcctRefinementService::Cancel()
+{
+    myToCancel = true;
+    if (myThread.joinable())
+    {
+        myThread.join();
+    }
+    myToCancel = false;
+}
+
+// ================================================================
+// Function : syncParts
+// Purpose  :
+// ================================================================
+void OcctRefinementService::syncParts()
+{
+    AIS_ListOfInteractive anObjects;
+    myContext->DisplayedObjects(anObjects);
+    for (AIS_ListOfInteractive::Iterator anObjIter(anObjects); anObjIter.More(); anObjIter.Next())
+    {
+        Handle(AIS_Shape) aShapePrs = Handle(AIS_Shape)::DownCast(anObjIter.Value());
+        if (aShapePrs.IsNull()
+         || aShapePrs->Shape().IsNull()
+         || myPartIndices.count(aShapePrs.get()) != 0)
+        {
+            continue;
+        }
+
+        PartEntry aPart;
+        aPart.Object   = aShapePrs;
+        aPart.Original = aShapePrs->Shape();
+        aPart.HasCopy  = false;
+        aPart.IsDirty  = false;
+        TopTools_IndexedMapOfShape aFaces;
+        TopExp::MapShapes(aShapePrs->Shape(), TopAbs_FACE, aFaces);
+        for (int aFaceIter = 1; aFaceIter <= aFaces.Extent(); ++aFaceIter)
+        {
+            FaceEntry aFace;
+            aFace.Face  = TopoDS::Face(aFaces(aFaceIter));
+            aFace.Index = aFaceIter;
+            TopLoc_Location aLoc;
+            aFace.Coarse = BRep_Tool::Triangulation(aFace.Face, aLoc);
+            if (aFace.Coarse.IsNull())
+            {
+                continue;
+            }
+
+            BRepBndLib::Add(aFace.Face, aFace.Box);
+            aFace.Deflection    = aFace.Coarse->Deflection();
+            aFace.NbRefinedTris = 0;
+            aFace.IsPending     = false;
+            aPart.Faces.push_back(aFace);
+        }
+        myPartIndices[aShapePrs.get()] = (int)myParts.size();
+        myParts.push_back(aPart);
+    }
+}
+
+// ================================================================
+// Function : checkView
+// Purpose  :
+// ================================================================
+void OcctRefinementService::checkView()
+{
+    OSD_Timer aTimer;
+    aTimer.Start();
+    syncParts();
+
+    const Handle(Graphic3d_Camera)& aCamera = myView->Camera();
+    const gp_Vec anUp(aCamera->Up());
+    Standard_Integer aWidth = 0, aHeight = 0;
+    myView->Window()->Size(aWidth, aHeight);
+
+    BRep_Builder aBuilder;
+    std::vector<Job> aJobs;
+    for (int aPartIter = 0; aPartIter < (int)myParts.size(); ++aPartIter)
+    {
+        PartEntry& aPart = myParts[aPartIter];
+        if (!myContext->IsDisplayed(aPart.Object))
+        {
+            continue;
+        }
+
+        const gp_Trsf aTrsf = aPart.Object->Transformation();
+        for (int aFaceIter = 0; aFaceIter < (int)aPart.Faces.size(); ++aFaceIter)
+        {
+            FaceEntry& aFace = aPart.Faces[aFaceIter];
+            if (aFace.IsPending)
+            {
+                continue;
+            }
+
+            // visibility by the face box in normalized device coordinates
+            const Bnd_Box aBox = aFace.Box.Transformed(aTrsf);
+            const gp_Pnt aMin = aBox.CornerMin(), aMax = aBox.CornerMax();
+            double aNdcMin[2] = { RealLast(), RealLast() }, aNdcMax[2] = { -RealLast(), -RealLast() };
+            bool isInFront = false;
+            for (int aCornerIter = 0; aCornerIter < 8; ++aCornerIter)
+            {
+                const gp_Pnt aCorner((aCornerIter & 1) != 0 ? aMax.X() : aMin.X(),
+                                     (aCornerIter & 2) != 0 ? aMax.Y() : aMin.Y(),
+                                     (aCornerIter & 4) != 0 ? aMax.Z() : aMin.Z());
+                const gp_Pnt aNdc = aCamera->Project(aCorner);
+                isInFront = isInFront || (aNdc.Z() >= -1.0 && aNdc.Z() <= 1.0);
+                aNdcMin[0] = std::min(aNdcMin[0], aNdc.X());
+                aNdcMin[1] = std::min(aNdcMin[1], aNdc.Y());
+                aNdcMax[0] = std::max(aNdcMax[0], aNdc.X());
+                aNdcMax[1] = std::max(aNdcMax[1], aNdc.Y());
+            }
+            const bool isVisible = isInFront
+                                && aNdcMax[0] >= -1.0 && aNdcMin[0] <= 1.0
+                                && aNdcMax[1] >= -1.0 && aNdcMin[1] <= 1.0;
+
+            // chord error of the active triangulation projected at the face center
+            double anErrorPx = 0.0;
+            if (isVisible)
+            {
+                const gp_Pnt aCenter = (aMin.XYZ() + aMax.XYZ()) * 0.5;
+                const gp_Pnt aNdc1 = aCamera->Project(aCenter);
+                const gp_Pnt aNdc2 = aCamera->Project(aCenter.Translated(anUp * aFace.Deflection));
+                anErrorPx = std::hypot((aNdc2.X() - aNdc1.X()) * 0.5 * aWidth, (aNdc2.Y() - aNdc1.Y()) * 0.5 * aHeight);
+            }
+
+            const double aCoarseErrorPx = anErrorPx * aFace.Coarse->Deflection() / aFace.Deflection;
+            if (aFace.NbRefinedTris != 0
+            && (!isVisible || aCoarseErrorPx <= myTolerancePx))
+            {
+                // the face left the view or the coarse mesh is good enough again
+                aBuilder.UpdateFace(aFace.PrsFace, aFace.Coarse);
+                aFace.Deflection = aFace.Coarse->Deflection();
+                myRefinedTris -= aFace.NbRefinedTris;
+                aFace.NbRefinedTris = 0;
+                --myNbRefined;
+                ++myNbReleased;
+                aPart.IsDirty = true;
+                continue;
+            }
+            if (!isVisible
+             || anErrorPx <= myTolerancePx)
+            {
+                continue;
+            }
+
+            // halve the deflection until the projected error fits the tolerance
+            const double aMinDeflection = 1.0e-4 * std::sqrt(aBox.SquareExtent());
+            double aDeflection = aFace.Deflection;
+            while (anErrorPx > myTolerancePx
+                && aDeflection * 0.5 >= aMinDeflection)
+            {
+                aDeflection *= 0.5;
+                anErrorPx   *= 0.5;
+            }
+            if (aDeflection >= aFace.Deflection)
+            {
+                continue;
+            }
+
+            Job aJob;
+            aJob.Part       = aPartIter;
+            aJob.Face       = aFaceIter;
+            aJob.Shape      = aFace.Face;
+            aJob.Deflection = aDeflection;
+            aJobs.push_back(aJob);
+            aFace.IsPending = true;
+        }
+    }
+    aTimer.Stop();
+    myCheckMs = aTimer.ElapsedTime() * 1000.0;
+
+    if (!aJobs.empty())
+    {
+        Cancel();
+        myJobs.swap(aJobs);
+        myIsRunning = true;
+        myThread = std::thread([this]() { perform(); });
+    }
+}
+
+// ================================================================
+// Function : perform
+// Purpose  :
+// ================================================================
+void OcctRefinementService::perform()
+{
+    OSD_Timer aTimer;
+    aTimer.Start();
+    OSD_Parallel::For(0, (int)myJobs.size(), [this](int theIndex)
+    {
+        Job& aJob = myJobs[theIndex];
+        if (!myToCancel)
+        {
+            // the copy shares geometry but not topology, so meshing does not touch the displayed shape
+            BRepBuilderAPI_Copy aCopier(aJob.Shape, Standard_False, Standard_False);
+            const TopoDS_Face aCopy = TopoDS::Face(aCopier.Shape());
+            BRepMesh_IncrementalMesh aMesher(aCopy, aJob.Deflection, Standard_False, 0.5, Standard_False);
+            TopLoc_Location aLoc;
+            aJob.Triangulation = BRep_Tool::Triangulation(aCopy, aLoc);
+        }
+
+        // cancelled faces are reported as well to reset their pending state
+        std::lock_guard<std::mutex> aLock(myMutex);
+        myResults.push_back(aJob);
+    });
+    aTimer.Stop();
+    myJobMs = aTimer.ElapsedTime() * 1000.0;
+    myIsRunning = false;
+}
+
+// ================================================================
+// Function : copyPart
+// Purpose  :
+// ================================================================
+void OcctRefinementService::copyPart(PartEntry& thePart)
+{
+    if (thePart.HasCopy)
+    {
+        return;
+    }
+
+    // the copy shares geometry and holds its own triangulations, so that document shapes
+    // (possibly shared by several instances) are never modified; face maps of both shapes have the same order
+    BRepBuilderAPI_Copy aCopier(thePart.Original, Standard_False, Standard_True);
+    TopTools_IndexedMapOfShape aFaces;
+    TopExp::MapShapes(aCopier.Shape(), TopAbs_FACE, aFaces);
+    for (FaceEntry& aFace : thePart.Faces)
+    {
+        aFace.PrsFace = TopoDS::Face(aFaces(aFace.Index));
+    }
+    thePart.Object->SetShape(aCopier.Shape());
+    thePart.HasCopy = true;
+
+    // the presentation is recomputed within the swap budget, selection should refer to the copied sub-shapes
+    myContext->RecomputeSelectionOnly(thePart.Object);
+}
+
+// ================================================================
+// Function : releasePart
+// Purpose  :
+// ================================================================
+void OcctRefinementService::releasePart(PartEntry& thePart)
+{
+    for (FaceEntry& aFace : thePart.Faces)
+    {
+        if (aFace.NbRefinedTris != 0)
+        {
+            myRefinedTris -= aFace.NbRefinedTris;
+            --myNbRefined;
+            ++myNbReleased;
+        }
+        aFace.PrsFace.Nullify();
+        aFace.Deflection    = aFace.Coarse->Deflection();
+        aFace.NbRefinedTris = 0;
+    }
+    thePart.IsDirty = false;
+    if (thePart.HasCopy)
+    {
+        // refined triangulations are held only by faces of the copy
+        thePart.Object->SetShape(thePart.Original);
+        thePart.HasCopy = false;
+    }
+}
+
+// ================================================================
+// Function : releaseHidden
+// Purpose  :
+// ================================================================
+void OcctRefinementService::releaseHidden()
+{
+    {
+        // pending results refer to parts by index
+        std::lock_guard<std::mutex> aLock(myMutex);
+        if (!myResults.empty())
+        {
+            return;
+        }
+    }
+
+    bool isRemoved = false;
+    for (PartEntry& aPart : myParts)
+    {
+        const PrsMgr_DisplayStatus aStatus = myContext->DisplayStatus(aPart.Object);
+        if (aStatus == PrsMgr_DisplayStatus_Displayed
+         || (aStatus != PrsMgr_DisplayStatus_None && !aPart.HasCopy))
+        {
+            continue;
+        }
+
+        const bool hasCopy = aPart.HasCopy;
+        releasePart(aPart);
+        if (aStatus == PrsMgr_DisplayStatus_None)
+        {
+            // removed from the context, the entry should not keep the object alive
+            aPart.Object.Nullify();
+            isRemoved = true;
+        }
+        else if (hasCopy)
+        {
+            // erased presentations are recomputed once displayed again
+            myContext->Redisplay(aPart.Object, Standard_False);
+        }
+    }
+    if (!isRemoved)
+    {
+        return;
+    }
+
+    myParts.erase(std::remove_if(myParts.begin(), myParts.end(),
+                                 [](const PartEntry& thePart) { return thePart.Object.IsNull(); }),
+                  myParts.end());
+    myPartIndices.clear();
+    for (int aPartIter = 0; aPartIter < (int)myParts.size(); ++aPartIter)
+    {
+        myPartIndices[myParts[aPartIter].Object.get()] = aPartIter;
+    }
+}
+
+// ================================================================
+// Function : Restore
+// Purpose  :
+// ================================================================
+void OcctRefinementService::Restore()
+{
+    for (PartEntry& aPart : myParts)
+    {
+        const bool hasCopy = aPart.HasCopy;
+        releasePart(aPart);
+        if (hasCopy)
+        {
+            myContext->Redisplay(aPart.Object, Standard_False);
+        }
+    }
+    myCheckedState = Graphic3d_WorldViewProjState();
+    if (!myView.IsNull())
+    {
+        myView->Invalidate();
+    }
+}
+
+// ================================================================
+// Function : applyResults
+// Purpose  :
+// ================================================================
+void OcctRefinementService::applyResults()
+{
+    {
+        std::lock_guard<std::mutex> aLock(myMutex);
+        myReady.insert(myReady.end(), myResults.begin(), myResults.end());
+        myResults.clear();
+    }
+
+    OSD_Timer aTimer;
+    aTimer.Start();
+    BRep_Builder aBuilder;
+    for (const Job& aJob : myReady)
+    {
+        PartEntry& aPart = myParts[aJob.Part];
+        FaceEntry& aFace = aPart.Faces[aJob.Face];
+        aFace.IsPending = false;
+        if (!myIsEnabled
+         || aJob.Triangulation.IsNull()
+         || aJob.Triangulation->NbTriangles() == 0)
+        {
+            continue;
+        }
+
+        copyPart(aPart);
+        aBuilder.UpdateFace(aFace.PrsFace, aJob.Triangulation);
+        aFace.Deflection = aJob.Deflection;
+        if (aFace.NbRefinedTris == 0)
+        {
+            ++myNbRefined;
+        }
+        myRefinedTris += aJob.Triangulation->NbTriangles() - aFace.NbRefinedTris;
+        aFace.NbRefinedTris = aJob.Triangulation->NbTriangles();
+        aPart.IsDirty = true;
+    }
+    myReady.clear();
+
+    // presentations are rebuilt from ready triangulations, spreading large batches over several frames
+    bool isRecomputed = false;
+    for (PartEntry& aPart : myParts)
+    {
+        if (!aPart.IsDirty)
+        {
+            continue;
+        }
+        if (isRecomputed
+         && aTimer.ElapsedTime() * 1000.0 > myBudgetMs)
+        {
+            break;
+        }
+
+        myContext->RecomputePrsOnly(aPart.Object, Standard_False);
+        aPart.IsDirty = false;
+        isRecomputed = true;
+    }
+    if (isRecomputed)
+    {
+        aTimer.Stop();
+        mySwapMs = aTimer.ElapsedTime() * 1000.0;
+        myView->Invalidate();
+    }
+}
+
+// ================================================================
+// Function : Update
+// Purpose  :
+// ================================================================
+void OcctRefinementService::Update(bool theIsNavigating, bool theIsLocked)
+{
+    // finished triangulations wait until no other job reads displayed shapes
+    if (myContext.IsNull()
+     || theIsLocked)
+    {
+        return;
+    }
+
+    applyResults();
+    if (myIsRunning)
+    {
+        return;
+    }
+
+    releaseHidden();
+    if (!myIsEnabled
+      || theIsNavigating)
+    {
+        return;
+    }
+
+    const Graphic3d_WorldViewProjState& aState = myView->Camera()->WorldViewProjState();
+    if (aState != myCheckedState)
+    {
+        myCheckedState = aState;
+        checkView();
+    }
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctRefinementService::RenderGui()
+{
+    ImGui::Begin("Refinement");
+    if (ImGui::Checkbox("Refine on zoom", &myIsEnabled)
+    && !myIsEnabled)
+    {
+        Restore();
+    }
+    if (ImGui::SliderFloat("Tolerance, px", &myTolerancePx, 0.25f, 8.0f, "%.2f"))
+    {
+        // force a new check with the changed tolerance
+        myCheckedState = Graphic3d_WorldViewProjState();
+    }
+    ImGui::SliderFloat("Swap budget, ms", &myBudgetMs, 1.0f, 32.0f, "%.0f");
+
+    ImGui::SeparatorText("Statistics");
+    ImGui::Text("Parts: %d  refined faces: %d  released: %d", (int)myParts.size(), myNbRefined, myNbReleased);
+    ImGui::Text("Refined triangles: %zu", myRefinedTris);
+    ImGui::Text("Check: %.2f ms  mesh job: %.1f ms%s", myCheckMs, (double)myJobMs, myIsRunning ? " (running)" : "");
+    ImGui::Text("Last swap: %.2f ms", mySwapMs);
+    ImGui::End();
+}
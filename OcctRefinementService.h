@@ -0,0 +1,158 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctRefinementService_Header
+#define _OcctRefinementService_Header
+
+#include <AIS_InteractiveContext.hxx>
+#include <AIS_Shape.hxx>
+#include <Bnd_Box.hxx>
+#include <Graphic3d_WorldViewProjState.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TopoDS_Face.hxx>
+#include <V3d_View.hxx>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//! View-dependent refinement of face triangulations.
+//! Once the camera settles, visible faces of displayed shapes are checked for the on-screen size of their chord error;
+//! faces exceeding the pixel tolerance are re-meshed at finer deflection on a background job (a topological copy
+//! of each face is meshed, so the displayed shape is never touched off the GUI thread).
+//! Refined triangulations are never put into document shapes: on the first refinement, the presentation gets
+//! its own topological copy of the part shape (sharing geometry), and triangulations are swapped on faces of that copy.
+//! Finished triangulations are swapped in within a per-frame time budget, and refined faces leaving the view
+//! get their coarse triangulation back, releasing the refined one.
+//! Hidden parts give their presentation copy back, and parts removed from the context are forgotten.
+//! Swaps are postponed while other background jobs may read triangulations of displayed shapes.
+class OcctRefinementService
+{
+public:
+    //! Default constructor.
+    OcctRefinementService();
+
+    //! Destructor, cancels the running job.
+    ~OcctRefinementService();
+
+    //! Attach the service to the interactive context and view.
+    void Init(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theView);
+
+    //! Request the running job to stop and wait for it.
+    void Cancel();
+
+    //! Swap finished triangulations and check the view once the camera settles; should be called before the view redraw.
+    //! @param theIsNavigating [in] camera is being moved
+    //! @param theIsLocked     [in] background jobs read displayed shapes, so that triangulations should not be swapped
+    void Update(bool theIsNavigating, bool theIsLocked);
+
+    //! Give presentations back their document shapes, releasing all refined triangulations.
+    void Restore();
+
+    //! Render the refinement panel.
+    void RenderGui();
+
+private:
+    //! Face of a displayed shape.
+    struct FaceEntry
+    {
+        TopoDS_Face                Face;         //!< document face, never modified
+        TopoDS_Face                PrsFace;      //!< face of the presentation copy, NULL until the part is copied
+        int                        Index;        //!< index within the face map of the part shape
+        Bnd_Box                    Box;          //!< box in shape coordinates
+        Handle(Poly_Triangulation) Coarse;       //!< original triangulation
+        double                     Deflection;   //!< deflection of the active triangulation
+        int                        NbRefinedTris; //!< triangles of the refined triangulation, 0 if not refined
+        bool                       IsPending;
+    };
+
+    //! Displayed shape.
+    struct PartEntry
+    {
+        Handle(AIS_Shape)      Object;
+        TopoDS_Shape           Original;         //!< document shape of the presentation
+        bool                   HasCopy;          //!< presentation displays its own copy of the shape
+        std::vector<FaceEntry> Faces;
+        bool                   IsDirty;          //!< presentation should be recomputed
+    };
+
+    //! Face to re-mesh; also used for the job result.
+    struct Job
+    {
+        int                        Part;
+        int                        Face;
+        TopoDS_Face                Shape;
+        double                     Deflection;
+        Handle(Poly_Triangulation) Triangulation;
+    };
+
+private:
+    //! Collect displayed shapes not yet known.
+    void syncParts();
+
+    //! Find faces to refine or release for the current camera.
+    void checkView();
+
+    //! Replace the shape of the presentation by a copy holding its own triangulations.
+    void copyPart(PartEntry& thePart);
+
+    //! Give the presentation back its document shape, releasing refined triangulations of the part.
+    void releasePart(PartEntry& thePart);
+
+    //! Release parts which are no longer displayed and forget parts removed from the context.
+    void releaseHidden();
+
+    //! Apply finished triangulations and recompute presentations within the budget.
+    void applyResults();
+
+    //! Job entry point.
+    void perform();
+
+private:
+    Handle(AIS_InteractiveContext)                        myContext;
+    Handle(V3d_View)                                      myView;
+    std::vector<PartEntry>                                myParts;
+    std::unordered_map<const AIS_InteractiveObject*, int> myPartIndices;
+    std::vector<Job>                                      myJobs;        //!< faces meshed by the running job
+    std::vector<Job>                                      myResults;     //!< finished faces, guarded by myMutex
+    std::vector<Job>                                      myReady;       //!< finished faces taken by the GUI thread
+    std::mutex                                            myMutex;
+    std::thread                                           myThread;
+    std::atomic<bool>                                     myIsRunning;
+    std::atomic<bool>                                     myToCancel;
+    Graphic3d_WorldViewProjState                          myCheckedState; //!< camera state of the last check
+    bool                                                  myIsEnabled;
+    float                                                 myTolerancePx;  //!< allowed chord error on screen
+    float                                                 myBudgetMs;     //!< per-frame swap budget
+    int                                                   myNbRefined;    //!< faces holding refined triangulation
+    int                                                   myNbReleased;
+    size_t                                                myRefinedTris;  //!< triangles held by refined faces
+    std::atomic<double>                                   myJobMs;
+    double                                                myCheckMs;
+    double                                                mySwapMs;
+};
+
+#endif // _OcctRefinementService_Header
@@ -0,0 +1,233 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctResolutionScaler.h"
+
+#include "imgui/imgui.h"
+
+#include <algorithm>
+#include <cmath>
+
+// ================================================================
+// Function : OcctResolutionScaler
+// Purpose  :
+// ================================================================
+OcctResolutionScaler::OcctResolutionScaler()
+    : myIsEnabled(true),
+    myIsFrameStarted(false),
+    myIsMoving(false),
+    myToFinish(false),
+    myQueryIndex(0),
+    myScale(1.0f),
+    myTargetScale(1.0f),
+    myMinScale(0.25f),
+    myTargetMs(12.0f),
+    myFrameMs(0.0)
+{
+    myQueries[0] = myQueries[1] = 0;
+    myIsQueryPending[0] = myIsQueryPending[1] = false;
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctResolutionScaler::Init(const Handle(V3d_View)& theView)
+{
+    myView = theView;
+}
+
+// ================================================================
+// Function : Release
+// Purpose  :
+// ================================================================
+void OcctResolutionScaler::Release(const Handle(OpenGl_Context)& theGlCtx)
+{
+    if (myQueries[0] != 0
+    && !theGlCtx.IsNull())
+    {
+        theGlCtx->core33->glDeleteQueries(2, myQueries);
+    }
+    myQueries[0] = myQueries[1] = 0;
+    myIsQueryPending[0] = myIsQueryPending[1] = false;
+}
+
+// ================================================================
+// Function : SetEnabled
+// Purpose  :
+// ================================================================
+void OcctResolutionScaler::SetEnabled(bool theIsEnabled)
+{
+    myIsEnabled = theIsEnabled;
+    if (!myIsEnabled)
+    {
+        myTargetScale = 1.0f;
+        applyScale(1.0f);
+    }
+}
+
+// ================================================================
+// Function : applyScale
+// Purpose  :
+// ================================================================
+void OcctResolutionScaler::applyScale(float theScale)
+{
+    if (myScale == theScale || myView.IsNull())
+    {
+        return;
+    }
+
+    myScale = theScale;
+    myView->ChangeRenderingParams().RenderResolutionScale = theScale;
+    myView->Invalidate();
+}
+
+// ================================================================
+// Function : BeginFrame
+// Purpose  :
+// ================================================================
+void OcctResolutionScaler::BeginFrame(bool theIsNavigating)
+{
+    if (myView.IsNull())
+    {
+        return;
+    }
+
+    myIsMoving = theIsNavigating;
+
+    if (!myIsEnabled)
+    {
+        return;
+    }
+    if (!myIsMoving)
+    {
+        // re-render at full resolution once the interaction is over
+        myTargetScale = 1.0f;
+        applyScale(1.0f);
+        return;
+    }
+
+    // the number of pixels is proportional to the square of the scale;
+    // the scale is rounded to 0.05 steps to avoid reallocating the FBO on every frame
+    if (myFrameMs > 0.0)
+    {
+        const float aRatio = std::sqrt(myTargetMs / float(myFrameMs));
+        myTargetScale = std::min(std::max(myTargetScale * std::min(std::max(aRatio, 0.5f), 1.25f), myMinScale), 1.0f);
+    }
+    applyScale(std::max(std::round(myTargetScale * 20.0f) / 20.0f, myMinScale));
+}
+
+// ================================================================
+// Function : BeginRedraw
+// Purpose  :
+// ================================================================
+void OcctResolutionScaler::BeginRedraw(const Handle(OpenGl_Context)& theGlCtx)
+{
+    myFrameTimer.Reset();
+    myFrameTimer.Start();
+    myIsFrameStarted = true;
+    if (!myIsMoving
+     || !myIsEnabled)
+    {
+        // results of the previous interaction are outdated
+        myIsQueryPending[0] = myIsQueryPending[1] = false;
+        return;
+    }
+
+    if (isQueryMode(theGlCtx))
+    {
+        if (myQueries[0] == 0)
+        {
+            theGlCtx->core33->glGenQueries(2, myQueries);
+        }
+        // a query not read back in time is simply restarted
+        myIsQueryPending[myQueryIndex] = false;
+        theGlCtx->core33->glBeginQuery(GL_TIME_ELAPSED, myQueries[myQueryIndex]);
+    }
+}
+
+// ================================================================
+// Function : EndRedraw
+// Purpose  :
+// ================================================================
+void OcctResolutionScaler::EndRedraw(const Handle(OpenGl_Context)& theGlCtx)
+{
+    if (!myIsFrameStarted)
+    {
+        return;
+    }
+
+    myIsFrameStarted = false;
+    if (!myIsMoving
+     || !myIsEnabled)
+    {
+        return;
+    }
+
+    if (!isQueryMode(theGlCtx)
+     || myQueries[0] == 0)
+    {
+        // glFinish() makes the measurement account GPU time instead of queued commands
+        theGlCtx->core11fwd->glFinish();
+        myFrameMs = myFrameTimer.ElapsedTime() * 1000.0;
+        return;
+    }
+
+    theGlCtx->core33->glEndQuery(GL_TIME_ELAPSED);
+    myIsQueryPending[myQueryIndex] = true;
+
+    // read the query of the previous frame, which is usually complete by now, without stalling
+    myQueryIndex = 1 - myQueryIndex;
+    if (myIsQueryPending[myQueryIndex])
+    {
+        GLint isAvailable = GL_FALSE;
+        theGlCtx->core33->glGetQueryObjectiv(myQueries[myQueryIndex], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        if (isAvailable == GL_TRUE)
+        {
+            GLuint64 aTimeNs = 0;
+            theGlCtx->core33->glGetQueryObjectui64v(myQueries[myQueryIndex], GL_QUERY_RESULT, &aTimeNs);
+            myFrameMs = double(aTimeNs) / 1000000.0;
+            myIsQueryPending[myQueryIndex] = false;
+        }
+    }
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctResolutionScaler::RenderGui()
+{
+    ImGui::SetNextWindowBgAlpha(0.6f);
+    ImGui::Begin("Resolution", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+    bool isEnabled = myIsEnabled;
+    if (ImGui::Checkbox("Dynamic resolution", &isEnabled))
+    {
+        SetEnabled(isEnabled);
+    }
+    ImGui::SliderFloat("Target 3D ms", &myTargetMs, 4.0f, 50.0f, "%.1f");
+    ImGui::SliderFloat("Min scale", &myMinScale, 0.1f, 1.0f, "%.2f");
+    ImGui::Checkbox("Wait for GPU (glFinish)", &myToFinish);
+    ImGui::Text("Scale: %.2f  3D redraw: %.2f ms%s", myScale, myFrameMs, myIsMoving ? "  (moving)" : "");
+    ImGui::End();
+}
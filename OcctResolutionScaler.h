@@ -0,0 +1,98 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctResolutionScaler_Header
+#define _OcctResolutionScaler_Header
+
+#include <OpenGl_Context.hxx>
+#include <OSD_Timer.hxx>
+#include <V3d_View.hxx>
+
+//! Dynamic resolution scaling while the camera moves.
+//! The scale is applied through Graphic3d_RenderingParams::RenderResolutionScale,
+//! so that OpenGl_View renders the scene into an offscreen FBO of reduced size and upscales it into the window,
+//! while ImGui is drawn afterwards at native resolution.
+//! The scale follows the redraw time target during navigation and returns to 1 once navigation is over.
+//! Only the 3D redraw is measured, ImGui rendering and buffers swap (bound to vsync) are excluded.
+//! GPU time is measured by GL_TIME_ELAPSED queries read back one frame later, so that CPU and GPU keep overlapping;
+//! glFinish() is used instead when timer queries are unavailable or explicitly requested.
+class OcctResolutionScaler
+{
+public:
+    //! Default constructor.
+    OcctResolutionScaler();
+
+    //! Attach the scaler to the view.
+    void Init(const Handle(V3d_View)& theView);
+
+    //! Release timer queries.
+    void Release(const Handle(OpenGl_Context)& theGlCtx);
+
+    //! Return true if scaling is enabled.
+    bool IsEnabled() const { return myIsEnabled; }
+
+    //! Enable or disable scaling.
+    void SetEnabled(bool theIsEnabled);
+
+    //! Return true if the full resolution frame is still pending,
+    //! so that the event loop should wake up without new input.
+    bool IsRefreshPending() const { return myIsEnabled && myScale < 1.0f; }
+
+    //! Update the scale before the view redraw.
+    void BeginFrame(bool theIsNavigating);
+
+    //! Start measuring the 3D redraw.
+    void BeginRedraw(const Handle(OpenGl_Context)& theGlCtx);
+
+    //! Finish measuring the 3D redraw during navigation,
+    //! so that the measured time includes the rendering cost and not only command submission.
+    void EndRedraw(const Handle(OpenGl_Context)& theGlCtx);
+
+    //! Render the overlay with the scale and the achieved frame time.
+    void RenderGui();
+
+private:
+    //! Apply the scale to the view rendering parameters.
+    void applyScale(float theScale);
+
+    //! Return true if the redraw should be measured by timer queries rather than glFinish().
+    bool isQueryMode(const Handle(OpenGl_Context)& theGlCtx) const { return !myToFinish && theGlCtx->core33 != NULL; }
+
+private:
+    Handle(V3d_View)             myView;
+    OSD_Timer                    myFrameTimer;    //!< measures the current 3D redraw
+    bool                         myIsEnabled;
+    bool                         myIsFrameStarted;
+    bool                         myIsMoving;
+    bool                         myToFinish;      //!< wait for the GPU by glFinish() instead of timer queries
+    unsigned int                 myQueries[2];    //!< GL_TIME_ELAPSED queries of the current and previous frames
+    bool                         myIsQueryPending[2];
+    int                          myQueryIndex;    //!< query of the current frame
+    float                        myScale;         //!< applied scale
+    float                        myTargetScale;   //!< unquantized scale driven by frame time
+    float                        myMinScale;
+    float                        myTargetMs;      //!< redraw time target during navigation
+    double                       myFrameMs;       //!< achieved redraw time
+};
+
+#endif // _OcctResolutionScaler_Header
@@ -0,0 +1,825 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctResultViewer.h"
+
+#include "OcctAnalysisEngine.h"
+
+#include "imgui/imgui.h"
+
+#include <Graphic3d_AspectFillArea3d.hxx>
+#include <Graphic3d_AttribBuffer.hxx>
+#include <Message.hxx>
+#include <Message_Messenger.hxx>
+#include <MeshVS_DataSource.hxx>
+#include <MeshVS_DisplayModeFlags.hxx>
+#include <MeshVS_PrsBuilder.hxx>
+#include <OSD_Parallel.hxx>
+#include <Prs3d_Presentation.hxx>
+#include <TColStd_PackedMapOfInteger.hxx>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    //! Size of the file header in bytes.
+    const size_t THE_HEADER_SIZE = 32;
+
+    //! Number of steps prepared ahead of the current one.
+    const int THE_CACHE_SIZE = 8;
+
+    //! Number of values converted by one parallel task.
+    const int THE_CHUNK_SIZE = 65536;
+
+    //! Data source over the mapped nodes and triangles; IDs are 1-based.
+    class OcctResultDataSource : public MeshVS_DataSource
+    {
+        DEFINE_STANDARD_RTTI_INLINE(OcctResultDataSource, MeshVS_DataSource)
+    public:
+        OcctResultDataSource(const float* theNodes, int theNbNodes,
+                             const unsigned int* theTris, int theNbTris)
+            : myNodes(theNodes),
+            myTris(theTris)
+        {
+            for (int aNodeIter = 1; aNodeIter <= theNbNodes; ++aNodeIter)
+            {
+                myNodeIds.Add(aNodeIter);
+                myBox.Add(gp_Pnt(theNodes[aNodeIter * 3 - 3], theNodes[aNodeIter * 3 - 2], theNodes[aNodeIter * 3 - 1]));
+            }
+            for (int aTriIter = 1; aTriIter <= theNbTris; ++aTriIter)
+            {
+                myTriIds.Add(aTriIter);
+            }
+        }
+
+        virtual Standard_Boolean GetGeom(const Standard_Integer theId, const Standard_Boolean theIsElement,
+                                         TColStd_Array1OfReal& theCoords, Standard_Integer& theNbNodes,
+                                         MeshVS_EntityType& theType) const Standard_OVERRIDE
+        {
+            if (!theIsElement)
+            {
+                if (!myNodeIds.Contains(theId))
+                {
+                    return Standard_False;
+                }
+                for (int aComp = 0; aComp < 3; ++aComp)
+                {
+                    theCoords(theCoords.Lower() + aComp) = myNodes[(theId - 1) * 3 + aComp];
+                }
+                theNbNodes = 1;
+                theType = MeshVS_ET_Node;
+                return Standard_True;
+            }
+
+            if (!myTriIds.Contains(theId))
+            {
+                return Standard_False;
+            }
+            for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+            {
+                const unsigned int aNode = myTris[(theId - 1) * 3 + aNodeIter];
+                for (int aComp = 0; aComp < 3; ++aComp)
+                {
+                    theCoords(theCoords.Lower() + aNodeIter * 3 + aComp) = myNodes[aNode * 3 + aComp];
+                }
+            }
+            theNbNodes = 3;
+            theType = MeshVS_ET_Face;
+            return Standard_True;
+        }
+
+        virtual Standard_Boolean GetGeomType(const Standard_Integer theId, const Standard_Boolean theIsElement,
+                                             MeshVS_EntityType& theType) const Standard_OVERRIDE
+        {
+            theType = theIsElement ? MeshVS_ET_Face : MeshVS_ET_Node;
+            return theIsElement ? myTriIds.Contains(theId) : myNodeIds.Contains(theId);
+        }
+
+        virtual Standard_Address GetAddr(const Standard_Integer , const Standard_Boolean ) const Standard_OVERRIDE { return NULL; }
+
+        virtual Standard_Boolean GetNodesByElement(const Standard_Integer theId, TColStd_Array1OfInteger& theNodeIds,
+                                                   Standard_Integer& theNbNodes) const Standard_OVERRIDE
+        {
+            if (!myTriIds.Contains(theId))
+            {
+                return Standard_False;
+            }
+            for (int aNodeIter = 0; aNodeIter < 3; ++aNodeIter)
+            {
+                theNodeIds(theNodeIds.Lower() + aNodeIter) = (int)myTris[(theId - 1) * 3 + aNodeIter] + 1;
+            }
+            theNbNodes = 3;
+            return Standard_True;
+        }
+
+        virtual const TColStd_PackedMapOfInteger& GetAllNodes() const Standard_OVERRIDE { return myNodeIds; }
+
+        virtual const TColStd_PackedMapOfInteger& GetAllElements() const Standard_OVERRIDE { return myTriIds; }
+
+        virtual Bnd_Box GetBoundingBox() const Standard_OVERRIDE { return myBox; }
+
+    private:
+        const float*               myNodes;
+        const unsigned int*        myTris;
+        TColStd_PackedMapOfInteger myNodeIds;
+        TColStd_PackedMapOfInteger myTriIds;
+        Bnd_Box                    myBox;
+    };
+
+    //! Shading builder adding the prepared triangle array, so that MeshVS never rebuilds geometry per step.
+    class OcctResultPrsBuilder : public MeshVS_PrsBuilder
+    {
+        DEFINE_STANDARD_RTTI_INLINE(OcctResultPrsBuilder, MeshVS_PrsBuilder)
+    public:
+        OcctResultPrsBuilder(const Handle(MeshVS_Mesh)& theMesh,
+                             const Handle(MeshVS_DataSource)& theSource,
+                             const Handle(Graphic3d_ArrayOfTriangles)& theTriangles)
+            : MeshVS_PrsBuilder(theMesh, MeshVS_DMF_Shading, theSource, -1, MeshVS_BP_Mesh),
+            myTriangles(theTriangles)
+        {
+        }
+
+        virtual void Build(const Handle(Prs3d_Presentation)& thePrs,
+                           const TColStd_PackedMapOfInteger& ,
+                           TColStd_PackedMapOfInteger& ,
+                           const Standard_Boolean theIsElement,
+                           const Standard_Integer theDisplayMode) const Standard_OVERRIDE
+        {
+            if (!theIsElement
+             || (theDisplayMode & MeshVS_DMF_Shading) == 0)
+            {
+                return;
+            }
+
+            Handle(Graphic3d_AspectFillArea3d) anAspect = new Graphic3d_AspectFillArea3d();
+            anAspect->SetInteriorStyle(Aspect_IS_SOLID);
+            anAspect->SetFrontMaterial(Graphic3d_MaterialAspect(Graphic3d_NameOfMaterial_Plastified));
+            anAspect->SetBackMaterial(Graphic3d_MaterialAspect(Graphic3d_NameOfMaterial_Plastified));
+            Handle(Graphic3d_Group) aGroup = thePrs->NewGroup();
+            aGroup->SetGroupPrimitivesAspect(anAspect);
+            aGroup->AddPrimitiveArray(myTriangles);
+        }
+
+    private:
+        Handle(Graphic3d_ArrayOfTriangles) myTriangles;
+    };
+
+    //! Return normalized position of the value within the range.
+    float rangePosition(float theValue, const float theRange[2])
+    {
+        const float aSpan = theRange[1] - theRange[0];
+        return aSpan > FLT_EPSILON ? (theValue - theRange[0]) / aSpan : 0.5f;
+    }
+}
+
+// ================================================================
+// Function : OcctResultViewer
+// Purpose  :
+// ================================================================
+OcctResultViewer::OcctResultViewer()
+    : myNodes(NULL),
+    myConnectivity(NULL),
+    myNbNodes(0),
+    myNbTris(0),
+    myNbSteps(0),
+    myIsElemental(false),
+    myToStop(false),
+    myTargetStep(0),
+    myGeneration(0),
+    myIsStepRange(false),
+    myColorMs(0.0),
+    myStep(0),
+    myShownStep(-1),
+    myShownGeneration(0),
+    myIsPlaying(false),
+    myToLoop(true),
+    myStepsPerSecond(30.0f),
+    myClockStep(0),
+    myNbShownInRate(0),
+    myShownRate(0.0),
+    myNbStalls(0),
+    myNbSkipped(0),
+    myUploadMs(0.0)
+{
+    myGlobalRange[0] = myRange[0] = 0.0f;
+    myGlobalRange[1] = myRange[1] = 1.0f;
+    strcpy(myPathBuffer, "results.ocrf");
+}
+
+// ================================================================
+// Function : ~OcctResultViewer
+// Purpose  :
+// ================================================================
+OcctResultViewer::~OcctResultViewer()
+{
+    stopPrefetch();
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctResultViewer::Init(const Handle(AIS_InteractiveContext)& theCtx,
+                            const Handle(V3d_View)& theView)
+{
+    myContext = theCtx;
+    myView = theView;
+}
+
+// ================================================================
+// Function : stepOffset
+// Purpose  :
+// ================================================================
+size_t OcctResultViewer::stepOffset(int theStep) const
+{
+    const size_t aNbValues = myIsElemental ? (size_t)myNbTris : (size_t)myNbNodes;
+    return THE_HEADER_SIZE + (size_t)myNbNodes * 12 + (size_t)myNbTris * 12 + (size_t)theStep * (16 + aNbValues * 4);
+}
+
+// ================================================================
+// Function : Open
+// Purpose  :
+// ================================================================
+bool OcctResultViewer::Open(const TCollection_AsciiString& thePath)
+{
+    Close();
+    if (!myFile.Open(thePath))
+    {
+        Message::DefaultMessenger()->Send(TCollection_AsciiString("Unable to map results file '") + thePath + "'", Message_Fail);
+        return false;
+    }
+
+    uint32_t aHeader[8] = {};
+    if (myFile.Size() >= THE_HEADER_SIZE)
+    {
+        memcpy(aHeader, myFile.Data(), THE_HEADER_SIZE);
+    }
+    myNbNodes     = (int)aHeader[2];
+    myNbTris      = (int)aHeader[3];
+    myNbSteps     = (int)aHeader[4];
+    myIsElemental = aHeader[5] == 1;
+    if (memcmp(myFile.Data(), "OCRF", 4) != 0
+     || aHeader[1] != 1
+     || aHeader[5] > 1
+     || myNbNodes <= 0 || myNbTris <= 0 || myNbSteps <= 0
+     || myFile.Size() < stepOffset(myNbSteps))
+    {
+        Message::DefaultMessenger()->Send(TCollection_AsciiString("Invalid results file '") + thePath + "'", Message_Fail);
+        myFile.Close();
+        return false;
+    }
+
+    myNodes        = reinterpret_cast<const float*>(myFile.Data() + THE_HEADER_SIZE);
+    myConnectivity = reinterpret_cast<const unsigned int*>(myFile.Data() + THE_HEADER_SIZE + (size_t)myNbNodes * 12);
+    for (int anIndexIter = 0; anIndexIter < myNbTris * 3; ++anIndexIter)
+    {
+        if (myConnectivity[anIndexIter] >= (unsigned int)myNbNodes)
+        {
+            Message::DefaultMessenger()->Send(TCollection_AsciiString("Invalid triangle in results file '") + thePath + "'", Message_Fail);
+            myFile.Close();
+            return false;
+        }
+    }
+
+    // the global range is read from step records only, without touching the scalars
+    myGlobalRange[0] = FLT_MAX;
+    myGlobalRange[1] = -FLT_MAX;
+    for (int aStepIter = 0; aStepIter < myNbSteps; ++aStepIter)
+    {
+        const float* aRecord = stepRecord(aStepIter);
+        myGlobalRange[0] = std::min(myGlobalRange[0], aRecord[1]);
+        myGlobalRange[1] = std::max(myGlobalRange[1], aRecord[2]);
+    }
+
+    buildTriangles();
+    Handle(OcctResultDataSource) aSource = new OcctResultDataSource(myNodes, myNbNodes, myConnectivity, myNbTris);
+    myMesh = new MeshVS_Mesh();
+    myMesh->SetDataSource(aSource);
+    myMesh->AddBuilder(new OcctResultPrsBuilder(myMesh, aSource, myTriangles), Standard_False);
+    myMesh->SetDisplayMode(MeshVS_DMF_Shading);
+
+    myCache.assign(THE_CACHE_SIZE, StepColors());
+    for (StepColors& aSlot : myCache)
+    {
+        aSlot.Step = -1;
+        aSlot.Generation = 0;
+    }
+    myRange[0] = myGlobalRange[0];
+    myRange[1] = myGlobalRange[1];
+    ++myGeneration;
+    myStep = 0;
+    myTargetStep = 0;
+    myShownStep = -1;
+    myIsPlaying = false;
+    myNbStalls = 0;
+    myNbSkipped = 0;
+    myToStop = false;
+    myThread = std::thread(&OcctResultViewer::prefetchLoop, this);
+
+    myContext->Display(myMesh, MeshVS_DMF_Shading, -1, false);
+    myView->FitAll(0.01, false);
+    myView->Invalidate();
+    return true;
+}
+
+// ================================================================
+// Function : Close
+// Purpose  :
+// ================================================================
+void OcctResultViewer::Close()
+{
+    stopPrefetch();
+    if (!myMesh.IsNull())
+    {
+        myContext->Remove(myMesh, false);
+        myView->Invalidate();
+    }
+    myMesh.Nullify();
+    myTriangles.Nullify();
+    myCache.clear();
+    myNodes = NULL;
+    myConnectivity = NULL;
+    myIsPlaying = false;
+    myFile.Close();
+}
+
+// ================================================================
+// Function : buildTriangles
+// Purpose  :
+// ================================================================
+void OcctResultViewer::buildTriangles()
+{
+    // only colors change between steps, so keep them mutable and apart from positions and normals
+    const Graphic3d_ArrayFlags aFlags = Graphic3d_ArrayFlags_VertexNormal
+                                      | Graphic3d_ArrayFlags_VertexColor
+                                      | Graphic3d_ArrayFlags_AttribsMutable
+                                      | Graphic3d_ArrayFlags_AttribsDeinterleaved;
+    auto aNode = [this](unsigned int theNode)
+    {
+        return Graphic3d_Vec3(myNodes[theNode * 3], myNodes[theNode * 3 + 1], myNodes[theNode * 3 + 2]);
+    };
+    if (myIsElemental)
+    {
+        // elemental values need flat colors, so vertices are not shared between triangles
+        myTriangles = new Graphic3d_ArrayOfTriangles(myNbTris * 3, 0, aFlags);
+        for (int aTriIter = 0; aTriIter < myNbTris; ++aTriIter)
+        {
+            const unsigned int* aTri = myConnectivity + aTriIter * 3;
+            const Graphic3d_Vec3 aP1 = aNode(aTri[0]), aP2 = aNode(aTri[1]), aP3 = aNode(aTri[2]);
+            Graphic3d_Vec3 aNorm = Graphic3d_Vec3::Cross(aP2 - aP1, aP3 - aP1);
+            if (aNorm.SquareModulus() > 0.0f)
+            {
+                aNorm.Normalize();
+            }
+            myTriangles->AddVertex(aP1, aNorm);
+            myTriangles->AddVertex(aP2, aNorm);
+            myTriangles->AddVertex(aP3, aNorm);
+        }
+        return;
+    }
+
+    // area-weighted nodal normals
+    std::vector<Graphic3d_Vec3> aNormals(myNbNodes, Graphic3d_Vec3(0.0f));
+    for (int aTriIter = 0; aTriIter < myNbTris; ++aTriIter)
+    {
+        const unsigned int* aTri = myConnectivity + aTriIter * 3;
+        const Graphic3d_Vec3 aP1 = aNode(aTri[0]);
+        const Graphic3d_Vec3 aNorm = Graphic3d_Vec3::Cross(aNode(aTri[1]) - aP1, aNode(aTri[2]) - aP1);
+        aNormals[aTri[0]] += aNorm;
+        aNormals[aTri[1]] += aNorm;
+        aNormals[aTri[2]] += aNorm;
+    }
+
+    myTriangles = new Graphic3d_ArrayOfTriangles(myNbNodes, myNbTris * 3, aFlags);
+    for (int aNodeIter = 0; aNodeIter < myNbNodes; ++aNodeIter)
+    {
+        Graphic3d_Vec3& aNorm = aNormals[aNodeIter];
+        if (aNorm.SquareModulus() > 0.0f)
+        {
+            aNorm.Normalize();
+        }
+        myTriangles->AddVertex(aNode(aNodeIter), aNorm);
+    }
+    for (int aTriIter = 0; aTriIter < myNbTris; ++aTriIter)
+    {
+        const unsigned int* aTri = myConnectivity + aTriIter * 3;
+        myTriangles->AddEdges((int)aTri[0] + 1, (int)aTri[1] + 1, (int)aTri[2] + 1);
+    }
+}
+
+// ================================================================
+// Function : computeColors
+// Purpose  :
+// ================================================================
+void OcctResultViewer::computeColors(int theStep, bool theIsStepRange, const float theRange[2],
+                                     std::vector<Graphic3d_Vec4ub>& theColors) const
+{
+    const float* aRecord = stepRecord(theStep);
+    const float* aValues = aRecord + 4;
+    const float aRange[2] = { theIsStepRange ? aRecord[1] : theRange[0], theIsStepRange ? aRecord[2] : theRange[1] };
+    const int aNbValues = myIsElemental ? myNbTris : myNbNodes;
+    const int aNbVertsPerValue = myIsElemental ? 3 : 1;
+    theColors.resize((size_t)aNbValues * aNbVertsPerValue);
+
+    const int aNbChunks = (aNbValues + THE_CHUNK_SIZE - 1) / THE_CHUNK_SIZE;
+    OSD_Parallel::For(0, aNbChunks, [&](int theChunk)
+    {
+        const int anEnd = std::min((theChunk + 1) * THE_CHUNK_SIZE, aNbValues);
+        for (int aValueIter = theChunk * THE_CHUNK_SIZE; aValueIter < anEnd; ++aValueIter)
+        {
+            const Graphic3d_Vec4ub aColor = OcctAnalysisEngine::PaletteColor(rangePosition(aValues[aValueIter], aRange));
+            for (int aVertIter = 0; aVertIter < aNbVertsPerValue; ++aVertIter)
+            {
+                theColors[(size_t)aValueIter * aNbVertsPerValue + aVertIter] = aColor;
+            }
+        }
+    });
+}
+
+// ================================================================
+// Function : prefetchLoop
+// Purpose  :
+// ================================================================
+void OcctResultViewer::prefetchLoop()
+{
+    std::vector<Graphic3d_Vec4ub> aColors;
+    std::unique_lock<std::mutex> aLock(myMutex);
+    while (!myToStop)
+    {
+        // the nearest step ahead of the target missing in the cache
+        int aStep = -1;
+        for (int anAhead = 0; anAhead < THE_CACHE_SIZE && anAhead < myNbSteps; ++anAhead)
+        {
+            const int aCandidate = (myTargetStep + anAhead) % myNbSteps;
+            const StepColors& aSlot = myCache[aCandidate % THE_CACHE_SIZE];
+            if (aSlot.Step != aCandidate
+             || aSlot.Generation != myGeneration)
+            {
+                aStep = aCandidate;
+                break;
+            }
+        }
+        if (aStep < 0)
+        {
+            myCond.wait(aLock);
+            continue;
+        }
+
+        const unsigned int aGeneration = myGeneration;
+        const bool isStepRange = myIsStepRange;
+        const float aRange[2] = { myRange[0], myRange[1] };
+        aLock.unlock();
+
+        // let the OS read the step behind the prefetch window while colors of this one are computed
+        const int aNextStep = (aStep + THE_CACHE_SIZE) % myNbSteps;
+        myFile.WillNeed(stepOffset(aNextStep), stepOffset(aNextStep + 1) - stepOffset(aNextStep));
+
+        OSD_Timer aTimer;
+        aTimer.Start();
+        computeColors(aStep, isStepRange, aRange, aColors);
+        aTimer.Stop();
+        myColorMs = aTimer.ElapsedTime() * 1000.0;
+
+        aLock.lock();
+        if (aGeneration == myGeneration)
+        {
+            StepColors& aSlot = myCache[aStep % THE_CACHE_SIZE];
+            aSlot.Step = aStep;
+            aSlot.Generation = aGeneration;
+            aSlot.Colors.swap(aColors);
+        }
+    }
+}
+
+// ================================================================
+// Function : stopPrefetch
+// Purpose  :
+// ================================================================
+void OcctResultViewer::stopPrefetch()
+{
+    if (!myThread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> aLock(myMutex);
+        myToStop = true;
+    }
+    myCond.notify_one();
+    myThread.join();
+}
+
+// ================================================================
+// Function : restartClock
+// Purpose  :
+// ================================================================
+void OcctResultViewer::restartClock()
+{
+    myClockStep = myStep;
+    myClock.Reset();
+    myClock.Start();
+}
+
+// ================================================================
+// Function : Update
+// Purpose  :
+// ================================================================
+void OcctResultViewer::Update()
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+
+    if (myIsPlaying)
+    {
+        int aStep = myClockStep + (int)(myClock.ElapsedTime() * myStepsPerSecond);
+        if (aStep >= myNbSteps)
+        {
+            if (myToLoop)
+            {
+                aStep %= myNbSteps;
+            }
+            else
+            {
+                aStep = myNbSteps - 1;
+                myIsPlaying = false;
+            }
+        }
+        myStep = aStep;
+    }
+
+    std::lock_guard<std::mutex> aLock(myMutex);
+    if (myTargetStep != myStep)
+    {
+        myTargetStep = myStep;
+        myCond.notify_one();
+    }
+    if (myShownStep == myStep
+     && myShownGeneration == myGeneration)
+    {
+        return;
+    }
+
+    const StepColors& aSlot = myCache[myStep % THE_CACHE_SIZE];
+    if (aSlot.Step != myStep
+     || aSlot.Generation != myGeneration)
+    {
+        ++myNbStalls;
+        return;
+    }
+
+    OSD_Timer aTimer;
+    aTimer.Start();
+    const Handle(Graphic3d_Buffer)& anAttribs = myTriangles->Attributes();
+    Standard_Integer aColorAttrib = -1;
+    Standard_Size aStride = 0;
+    if (Standard_Byte* aColorData = anAttribs->ChangeAttributeData(Graphic3d_TOA_COLOR, aColorAttrib, aStride))
+    {
+        if (aStride == sizeof(Graphic3d_Vec4ub))
+        {
+            memcpy(aColorData, aSlot.Colors.data(), aSlot.Colors.size() * sizeof(Graphic3d_Vec4ub));
+        }
+        else
+        {
+            for (size_t aVertIter = 0; aVertIter < aSlot.Colors.size(); ++aVertIter)
+            {
+                *reinterpret_cast<Graphic3d_Vec4ub*>(aColorData + aStride * aVertIter) = aSlot.Colors[aVertIter];
+            }
+        }
+
+        // only the color range is uploaded on the next redraw
+        if (Handle(Graphic3d_AttribBuffer) aMutable = Handle(Graphic3d_AttribBuffer)::DownCast(anAttribs))
+        {
+            aMutable->Invalidate(aColorAttrib);
+        }
+        myView->Invalidate();
+    }
+    aTimer.Stop();
+    myUploadMs = aTimer.ElapsedTime() * 1000.0;
+
+    if (myIsPlaying
+     && myShownStep >= 0)
+    {
+        myNbSkipped += std::max((myStep - myShownStep + myNbSteps) % myNbSteps - 1, 0);
+    }
+    myShownStep = myStep;
+    myShownGeneration = myGeneration;
+
+    ++myNbShownInRate;
+    if (!myRateTimer.IsStarted())
+    {
+        myRateTimer.Start();
+    }
+    else if (myRateTimer.ElapsedTime() >= 1.0)
+    {
+        myShownRate = myNbShownInRate / myRateTimer.ElapsedTime();
+        myNbShownInRate = 0;
+        myRateTimer.Reset();
+        myRateTimer.Start();
+    }
+}
+
+// ================================================================
+// Function : WriteSample
+// Purpose  :
+// ================================================================
+bool OcctResultViewer::WriteSample(const TCollection_AsciiString& thePath,
+                                   int theNbX, int theNbY, int theNbSteps)
+{
+    std::ofstream aFile(thePath.ToCString(), std::ios::binary);
+    if (!aFile)
+    {
+        return false;
+    }
+
+    const uint32_t aNbNodes = (uint32_t)(theNbX * theNbY);
+    const uint32_t aNbTris  = (uint32_t)((theNbX - 1) * (theNbY - 1) * 2);
+    const uint32_t aHeader[7] = { 1, aNbNodes, aNbTris, (uint32_t)theNbSteps, 0, 0, 0 };
+    aFile.write("OCRF", 4);
+    aFile.write(reinterpret_cast<const char*>(aHeader), sizeof(aHeader));
+
+    std::vector<float> aNodes;
+    aNodes.reserve(aNbNodes * 3);
+    for (int aY = 0; aY < theNbY; ++aY)
+    {
+        for (int aX = 0; aX < theNbX; ++aX)
+        {
+            aNodes.push_back((float)aX);
+            aNodes.push_back((float)aY);
+            aNodes.push_back(0.0f);
+        }
+    }
+    aFile.write(reinterpret_cast<const char*>(aNodes.data()), aNodes.size() * sizeof(float));
+
+    std::vector<uint32_t> aTris;
+    aTris.reserve(aNbTris * 3);
+    for (int aY = 0; aY + 1 < theNbY; ++aY)
+    {
+        for (int aX = 0; aX + 1 < theNbX; ++aX)
+        {
+            const uint32_t aCorner = (uint32_t)(aY * theNbX + aX);
+            const uint32_t aQuad[6] = { aCorner, aCorner + 1, aCorner + theNbX + 1, aCorner, aCorner + theNbX + 1, aCorner + theNbX };
+            aTris.insert(aTris.end(), aQuad, aQuad + 6);
+        }
+    }
+    aFile.write(reinterpret_cast<const char*>(aTris.data()), aTris.size() * sizeof(uint32_t));
+
+    // damped circular wave running from the plate center
+    std::vector<float> aValues(aNbNodes);
+    for (int aStepIter = 0; aStepIter < theNbSteps; ++aStepIter)
+    {
+        const float aTime = (float)aStepIter * 0.1f;
+        float aMin = FLT_MAX, aMax = -FLT_MAX;
+        for (uint32_t aNodeIter = 0; aNodeIter < aNbNodes; ++aNodeIter)
+        {
+            const float aDX = aNodes[aNodeIter * 3] - 0.5f * theNbX;
+            const float aDY = aNodes[aNodeIter * 3 + 1] - 0.5f * theNbY;
+            const float aRadius = std::sqrt(aDX * aDX + aDY * aDY);
+            aValues[aNodeIter] = std::sin(aRadius * 0.15f - aTime * 2.0f) * std::exp(-aRadius * 0.01f);
+            aMin = std::min(aMin, aValues[aNodeIter]);
+            aMax = std::max(aMax, aValues[aNodeIter]);
+        }
+        const float aRecord[4] = { aTime, aMin, aMax, 0.0f };
+        aFile.write(reinterpret_cast<const char*>(aRecord), sizeof(aRecord));
+        aFile.write(reinterpret_cast<const char*>(aValues.data()), aValues.size() * sizeof(float));
+    }
+    return aFile.good();
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctResultViewer::RenderGui()
+{
+    ImGui::Begin("Results");
+    ImGui::InputText("File", myPathBuffer, sizeof(myPathBuffer));
+    if (ImGui::Button("Open"))
+    {
+        Open(myPathBuffer);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Write sample"))
+    {
+        Close();
+        if (!WriteSample(myPathBuffer, 500, 500, 120))
+        {
+            Message::DefaultMessenger()->Send(TCollection_AsciiString("Unable to write '") + myPathBuffer + "'", Message_Fail);
+        }
+    }
+    if (IsOpen())
+    {
+        ImGui::SameLine();
+        if (ImGui::Button("Close"))
+        {
+            Close();
+        }
+    }
+    if (!IsOpen())
+    {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text("Nodes: %d  triangles: %d  steps: %d  (%s)", myNbNodes, myNbTris, myNbSteps,
+                myIsElemental ? "elemental" : "nodal");
+
+    ImGui::SeparatorText("Timeline");
+    if (ImGui::Button(myIsPlaying ? "Pause" : "Play", ImVec2(64.0f, 0.0f)))
+    {
+        myIsPlaying = !myIsPlaying;
+        if (myIsPlaying)
+        {
+            restartClock();
+        }
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Loop", &myToLoop);
+    ImGui::SameLine();
+    ImGui::Text("t = %.4g", stepRecord(myStep)[0]);
+    if (ImGui::SliderInt("Step", &myStep, 0, myNbSteps - 1))
+    {
+        restartClock();
+    }
+    if (ImGui::SliderFloat("Steps per second", &myStepsPerSecond, 1.0f, 120.0f, "%.0f"))
+    {
+        restartClock();
+    }
+
+    ImGui::SeparatorText("Legend");
+    {
+        std::lock_guard<std::mutex> aLock(myMutex);
+        bool isChanged = ImGui::Checkbox("Per-step range", &myIsStepRange);
+        ImGui::BeginDisabled(myIsStepRange);
+        isChanged |= ImGui::DragFloat2("Range", myRange, 0.001f * std::max(std::abs(myGlobalRange[1] - myGlobalRange[0]), 1.0f), 0.0f, 0.0f, "%.4g");
+        ImGui::SameLine();
+        if (ImGui::Button("Reset"))
+        {
+            myRange[0] = myGlobalRange[0];
+            myRange[1] = myGlobalRange[1];
+            isChanged = true;
+        }
+        ImGui::EndDisabled();
+        if (isChanged)
+        {
+            ++myGeneration;
+            myCond.notify_one();
+        }
+    }
+    {
+        const float aWidth = ImGui::GetContentRegionAvail().x;
+        const float aHeight = ImGui::GetFrameHeight();
+        const ImVec2 aMin = ImGui::GetCursorScreenPos();
+        ImDrawList* aDrawList = ImGui::GetWindowDrawList();
+        const int aNbSteps = 64;
+        for (int aStepIter = 0; aStepIter < aNbSteps; ++aStepIter)
+        {
+            const Graphic3d_Vec4ub aColor = OcctAnalysisEngine::PaletteColor(((float)aStepIter + 0.5f) / (float)aNbSteps);
+            aDrawList->AddRectFilled(ImVec2(aMin.x + aWidth * aStepIter / aNbSteps, aMin.y),
+                                     ImVec2(aMin.x + aWidth * (aStepIter + 1) / aNbSteps, aMin.y + aHeight),
+                                     IM_COL32(aColor.r(), aColor.g(), aColor.b(), 255));
+        }
+        ImGui::Dummy(ImVec2(aWidth, aHeight));
+    }
+
+    ImGui::SeparatorText("Statistics");
+    int aNbReady = 0;
+    {
+        std::lock_guard<std::mutex> aLock(myMutex);
+        for (const StepColors& aSlot : myCache)
+        {
+            aNbReady += (aSlot.Step >= 0 && aSlot.Generation == myGeneration) ? 1 : 0;
+        }
+    }
+    ImGui::Text("Shown: %.1f steps/s  prefetched: %d/%d", myShownRate, aNbReady, THE_CACHE_SIZE);
+    ImGui::Text("Colors: %.2f ms/step (worker)  upload: %.2f ms", (double)myColorMs, myUploadMs);
+    ImGui::Text("Stalled frames: %d  skipped steps: %d", myNbStalls, myNbSkipped);
+    ImGui::End();
+}
@@ -0,0 +1,164 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctResultViewer_Header
+#define _OcctResultViewer_Header
+
+#include "OcctMappedFile.h"
+
+#include <AIS_InteractiveContext.hxx>
+#include <Graphic3d_ArrayOfTriangles.hxx>
+#include <MeshVS_Mesh.hxx>
+#include <OSD_Timer.hxx>
+#include <V3d_View.hxx>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! Time-dependent FEM result viewer on top of MeshVS.
+//! The results file is memory-mapped and has the following little-endian layout:
+//! @code
+//!   char[4]  "OCRF", uint32 version (1), uint32 nbNodes, uint32 nbTriangles,
+//!   uint32   nbSteps, uint32 location (0 nodal, 1 elemental), uint32[2] reserved
+//!   float32  x, y, z                         x nbNodes
+//!   uint32   node1, node2, node3 (0-based)   x nbTriangles
+//!   { float32 time, min, max, reserved; float32 value x (nbNodes or nbTriangles) } x nbSteps
+//! @endcode
+//! Geometry is built once into a triangle array with mutable colors, shown through a MeshVS builder.
+//! A worker thread converts scalars of upcoming steps into vertex colors ahead of playback,
+//! so that switching the step only copies prepared colors into the color attribute.
+class OcctResultViewer
+{
+public:
+    //! Default constructor.
+    OcctResultViewer();
+
+    //! Destructor, stops the prefetch thread.
+    ~OcctResultViewer();
+
+    //! Attach the viewer to the interactive context and view.
+    void Init(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theView);
+
+    //! Open the results file and display its mesh; returns false if the file is invalid.
+    bool Open(const TCollection_AsciiString& thePath);
+
+    //! Remove the mesh and unmap the file.
+    void Close();
+
+    //! Return true if results are loaded.
+    bool IsOpen() const { return !myMesh.IsNull(); }
+
+    //! Return true if the playback is running or the requested step is not shown yet.
+    bool IsAnimating() const { return IsOpen() && (myIsPlaying || myShownStep != myStep); }
+
+    //! Advance the playback and upload colors of the current step when they are ready.
+    //! Should be called before redrawing the view.
+    void Update();
+
+    //! Render the timeline panel.
+    void RenderGui();
+
+    //! Write a synthetic wave over a plate of theNbX x theNbY nodes.
+    static bool WriteSample(const TCollection_AsciiString& thePath,
+                            int theNbX, int theNbY, int theNbSteps);
+
+private:
+    //! Colors of one time step prepared by the prefetch thread.
+    struct StepColors
+    {
+        int                           Step;
+        unsigned int                  Generation;  //!< legend generation the colors were computed for
+        std::vector<Graphic3d_Vec4ub> Colors;      //!< per vertex of the triangle array
+    };
+
+private:
+    //! Return byte offset of the step record within the mapped file.
+    size_t stepOffset(int theStep) const;
+
+    //! Return the step record: time, min, max, reserved, followed by the scalars.
+    const float* stepRecord(int theStep) const { return reinterpret_cast<const float*>(myFile.Data() + stepOffset(theStep)); }
+
+    //! Build the triangle array with vertex normals.
+    void buildTriangles();
+
+    //! Convert scalars of the step into vertex colors.
+    //! @param theRange [in] legend range, ignored if theIsStepRange is true
+    void computeColors(int theStep, bool theIsStepRange, const float theRange[2],
+                       std::vector<Graphic3d_Vec4ub>& theColors) const;
+
+    //! Prefetch thread entry point.
+    void prefetchLoop();
+
+    //! Stop the prefetch thread.
+    void stopPrefetch();
+
+    //! Restart the playback clock from the current step.
+    void restartClock();
+
+private:
+    Handle(AIS_InteractiveContext)     myContext;
+    Handle(V3d_View)                   myView;
+    OcctMappedFile                     myFile;
+    Handle(MeshVS_Mesh)                myMesh;
+    Handle(Graphic3d_ArrayOfTriangles) myTriangles;
+    const float*                       myNodes;        //!< mapped node coordinates
+    const unsigned int*                myConnectivity; //!< mapped triangle nodes
+    int                                myNbNodes;
+    int                                myNbTris;
+    int                                myNbSteps;
+    bool                               myIsElemental;
+    float                              myGlobalRange[2];
+
+    std::vector<StepColors>            myCache;        //!< ring of prepared steps indexed by step modulo size, guarded by myMutex
+    std::thread                        myThread;
+    std::mutex                         myMutex;
+    std::condition_variable            myCond;         //!< signals a new target step, legend change or stop request
+    bool                               myToStop;
+    int                                myTargetStep;   //!< first step to prefetch, guarded by myMutex
+    unsigned int                       myGeneration;   //!< incremented on legend changes, guarded by myMutex
+    float                              myRange[2];     //!< legend range, guarded by myMutex
+    bool                               myIsStepRange;  //!< use per-step range instead of myRange, guarded by myMutex
+    std::atomic<double>                myColorMs;      //!< prefetch time of the last step
+
+    int                                myStep;         //!< requested step
+    int                                myShownStep;    //!< step which colors are uploaded, -1 if none
+    unsigned int                       myShownGeneration;
+    bool                               myIsPlaying;
+    bool                               myToLoop;
+    float                              myStepsPerSecond;
+    int                                myClockStep;    //!< step at the playback clock start
+    OSD_Timer                          myClock;
+    OSD_Timer                          myRateTimer;    //!< measures shown steps per second
+    int                                myNbShownInRate;
+    double                             myShownRate;
+    int                                myNbStalls;     //!< frames which had to wait for the prefetch thread
+    int                                myNbSkipped;    //!< steps skipped during playback
+    double                             myUploadMs;
+    char                               myPathBuffer[512];
+};
+
+#endif // _OcctResultViewer_Header
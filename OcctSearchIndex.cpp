@@ -0,0 +1,396 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctSearchIndex.h"
+
+#include "imgui/imgui.h"
+
+#include <OSD_Timer.hxx>
+#include <TColStd_HSequenceOfExtendedString.hxx>
+#include <TDataStd_NamedData.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_LayerTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace
+{
+    //! Append lower-case copy of the string.
+    static void appendLower(std::string& theText, const TCollection_AsciiString& theStr)
+    {
+        for (int aCharIter = 1; aCharIter <= theStr.Length(); ++aCharIter)
+        {
+            const char aChar = theStr.Value(aCharIter);
+            theText.push_back(aChar >= 'A' && aChar <= 'Z' ? char(aChar - 'A' + 'a') : aChar);
+        }
+    }
+
+    //! Append layers and named properties of the label.
+    static void appendAttributes(std::string& theText, const TDF_Label& theLabel, const Handle(XCAFDoc_LayerTool)& theLayerTool)
+    {
+        Handle(TColStd_HSequenceOfExtendedString) aLayers = theLayerTool->GetLayers(theLabel);
+        for (int aLayerIter = 1; !aLayers.IsNull() && aLayerIter <= aLayers->Length(); ++aLayerIter)
+        {
+            theText.push_back('\n');
+            appendLower(theText, TCollection_AsciiString(aLayers->Value(aLayerIter)));
+        }
+
+        Handle(TDataStd_NamedData) aProps;
+        if (!theLabel.FindAttribute(TDataStd_NamedData::GetID(), aProps))
+        {
+            return;
+        }
+        for (TDataStd_DataMapOfStringString::Iterator aPropIter(aProps->GetStringsContainer()); aPropIter.More(); aPropIter.Next())
+        {
+            theText.push_back('\n');
+            appendLower(theText, TCollection_AsciiString(aPropIter.Key()) + "=" + TCollection_AsciiString(aPropIter.Value()));
+        }
+        for (TColStd_DataMapOfStringInteger::Iterator aPropIter(aProps->GetIntegersContainer()); aPropIter.More(); aPropIter.Next())
+        {
+            theText.push_back('\n');
+            appendLower(theText, TCollection_AsciiString(aPropIter.Key()) + "=" + aPropIter.Value());
+        }
+    }
+
+    //! Split the filter into trimmed lower-case include and exclude terms.
+    static void splitFilter(const char* theFilter, std::vector<std::string>& theIncludes, std::vector<std::string>& theExcludes)
+    {
+        std::string aTerm;
+        for (const char* aChar = theFilter; ; ++aChar)
+        {
+            if (*aChar != ',' && *aChar != '\0')
+            {
+                aTerm.push_back(*aChar >= 'A' && *aChar <= 'Z' ? char(*aChar - 'A' + 'a') : *aChar);
+                continue;
+            }
+
+            const size_t aFirst = aTerm.find_first_not_of(' ');
+            const size_t aLast = aTerm.find_last_not_of(' ');
+            if (aFirst != std::string::npos)
+            {
+                const std::string aTrimmed = aTerm.substr(aFirst, aLast - aFirst + 1);
+                if (aTrimmed[0] != '-')
+                {
+                    theIncludes.push_back(aTrimmed);
+                }
+                else if (aTrimmed.size() > 1)
+                {
+                    theExcludes.push_back(aTrimmed.substr(1));
+                }
+            }
+            aTerm.clear();
+            if (*aChar == '\0')
+            {
+                break;
+            }
+        }
+    }
+}
+
+// ================================================================
+// Function : OcctSearchIndex
+// Purpose  :
+// ================================================================
+OcctSearchIndex::OcctSearchIndex()
+    : myBuildMs(0.0),
+    myQueryMs(0.0)
+{
+    myFilter[0] = '\0';
+}
+
+// ================================================================
+// Function : Build
+// Purpose  :
+// ================================================================
+void OcctSearchIndex::Build(const OcctOutliner& theOutliner)
+{
+    OSD_Timer aTimer;
+    aTimer.Start();
+
+    const std::vector<OcctOutliner::Node>& aNodes = theOutliner.Nodes();
+    myText.clear();
+    myOffsets.clear();
+    myTrigrams.clear();
+    myBigrams.clear();
+    myLastTerm.clear();
+    myLastNodes.clear();
+    myResults.clear();
+    myFilter[0] = '\0';
+    if (aNodes.empty())
+    {
+        return;
+    }
+
+    Handle(XCAFDoc_LayerTool) aLayerTool = XCAFDoc_DocumentTool::LayerTool(aNodes.front().Label);
+    myOffsets.reserve(aNodes.size());
+    std::string aText;
+    for (int aNodeIter = 0; aNodeIter < (int)aNodes.size(); ++aNodeIter)
+    {
+        const OcctOutliner::Node& aNode = aNodes[aNodeIter];
+        aText.clear();
+        appendLower(aText, aNode.Name);
+
+        appendAttributes(aText, aNode.Label, aLayerTool);
+        TDF_Label aShapeLabel;
+        if (XCAFDoc_ShapeTool::GetReferredShape(aNode.Label, aShapeLabel))
+        {
+            appendAttributes(aText, aShapeLabel, aLayerTool);
+        }
+
+        // nodes are visited in ascending order, so posting lists stay sorted
+        for (size_t aCharIter = 0; aCharIter + 2 <= aText.size(); ++aCharIter)
+        {
+            if (std::memchr(aText.data() + aCharIter, '\n', 2) != nullptr)
+            {
+                continue;
+            }
+
+            std::vector<int>& aBigrams = myBigrams[bigramKey(aText.data() + aCharIter)];
+            if (aBigrams.empty() || aBigrams.back() != aNodeIter)
+            {
+                aBigrams.push_back(aNodeIter);
+            }
+            if (aCharIter + 3 > aText.size()
+             || aText[aCharIter + 2] == '\n')
+            {
+                continue;
+            }
+
+            std::vector<int>& aTrigrams = myTrigrams[trigramKey(aText.data() + aCharIter)];
+            if (aTrigrams.empty() || aTrigrams.back() != aNodeIter)
+            {
+                aTrigrams.push_back(aNodeIter);
+            }
+        }
+
+        myOffsets.push_back(myText.size());
+        myText.insert(myText.end(), aText.begin(), aText.end());
+        myText.push_back('\0');
+    }
+    myBuildMs = aTimer.ElapsedTime() * 1000.0;
+}
+
+// ================================================================
+// Function : queryTerm
+// Purpose  :
+// ================================================================
+void OcctSearchIndex::queryTerm(const std::string& theTerm, std::vector<int>& theNodes) const
+{
+    theNodes.clear();
+
+    // short terms follow the same substring rule over the same text as longer ones
+    if (theTerm.size() == 1)
+    {
+        for (int aNode = 0; aNode < (int)myOffsets.size(); ++aNode)
+        {
+            if (std::strchr(nodeText(aNode), theTerm[0]) != nullptr)
+            {
+                theNodes.push_back(aNode);
+            }
+        }
+        return;
+    }
+    else if (theTerm.size() == 2)
+    {
+        std::unordered_map<uint32_t, std::vector<int> >::const_iterator aFound = myBigrams.find(bigramKey(theTerm.data()));
+        if (aFound != myBigrams.end())
+        {
+            theNodes = aFound->second;
+        }
+        return;
+    }
+
+    std::vector<const std::vector<int>*> aLists;
+    for (size_t aCharIter = 0; aCharIter + 3 <= theTerm.size(); ++aCharIter)
+    {
+        std::unordered_map<uint32_t, std::vector<int> >::const_iterator aFound = myTrigrams.find(trigramKey(theTerm.data() + aCharIter));
+        if (aFound == myTrigrams.end())
+        {
+            return;
+        }
+        aLists.push_back(&aFound->second);
+    }
+    std::sort(aLists.begin(), aLists.end(), [](const std::vector<int>* theLeft, const std::vector<int>* theRight)
+    {
+        return theLeft->size() < theRight->size();
+    });
+
+    // intersect a few shortest lists, then verify remaining candidates directly
+    std::vector<int> aCandidates = *aLists.front();
+    for (size_t aListIter = 1; aListIter < aLists.size() && aListIter < 4 && aCandidates.size() > 64; ++aListIter)
+    {
+        std::vector<int> anIntersection;
+        std::set_intersection(aCandidates.begin(), aCandidates.end(),
+                              aLists[aListIter]->begin(), aLists[aListIter]->end(),
+                              std::back_inserter(anIntersection));
+        aCandidates.swap(anIntersection);
+    }
+    for (int aNode : aCandidates)
+    {
+        if (std::strstr(nodeText(aNode), theTerm.c_str()) != nullptr)
+        {
+            theNodes.push_back(aNode);
+        }
+    }
+}
+
+// ================================================================
+// Function : Query
+// Purpose  :
+// ================================================================
+void OcctSearchIndex::Query(const char* theFilter, std::vector<int>& theNodes)
+{
+    std::vector<std::string> anIncludes, anExcludes;
+    splitFilter(theFilter, anIncludes, anExcludes);
+    theNodes.clear();
+
+    // typing more characters of a single term only narrows the previous result
+    if (anIncludes.size() == 1
+     && anExcludes.empty()
+     && !myLastTerm.empty()
+     && anIncludes.front().compare(0, myLastTerm.size(), myLastTerm) == 0)
+    {
+        for (int aNode : myLastNodes)
+        {
+            if (std::strstr(nodeText(aNode), anIncludes.front().c_str()) != nullptr)
+            {
+                theNodes.push_back(aNode);
+            }
+        }
+    }
+    else if (anIncludes.empty())
+    {
+        if (anExcludes.empty())
+        {
+            myLastTerm.clear();
+            myLastNodes.clear();
+            return;
+        }
+        for (int aNode = 0; aNode < (int)myOffsets.size(); ++aNode)
+        {
+            theNodes.push_back(aNode);
+        }
+    }
+    else
+    {
+        std::vector<int> aTermNodes, aUnion;
+        for (const std::string& aTerm : anIncludes)
+        {
+            queryTerm(aTerm, aTermNodes);
+            aUnion.clear();
+            std::set_union(theNodes.begin(), theNodes.end(), aTermNodes.begin(), aTermNodes.end(), std::back_inserter(aUnion));
+            theNodes.swap(aUnion);
+        }
+    }
+
+    if (!anExcludes.empty())
+    {
+        theNodes.erase(std::remove_if(theNodes.begin(), theNodes.end(), [&](int theNode)
+        {
+            for (const std::string& aTerm : anExcludes)
+            {
+                if (std::strstr(nodeText(theNode), aTerm.c_str()) != nullptr)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }), theNodes.end());
+    }
+
+    const bool isSingleTerm = anIncludes.size() == 1 && anExcludes.empty();
+    myLastTerm = isSingleTerm ? anIncludes.front() : std::string();
+    if (isSingleTerm)
+    {
+        myLastNodes = theNodes;
+    }
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctSearchIndex::RenderGui(OcctOutliner& theOutliner)
+{
+    ImGui::Begin("Search");
+    if (ImGui::InputTextWithHint("##filter", "name, layer, property (incl,-excl)", myFilter, sizeof(myFilter)))
+    {
+        OSD_Timer aTimer;
+        aTimer.Start();
+        Query(myFilter, myResults);
+        myQueryMs = aTimer.ElapsedTime() * 1000.0;
+    }
+    ImGui::Text("Matches: %d  query: %.3f ms  index: %.1f ms", (int)myResults.size(), myQueryMs, myBuildMs);
+
+    ImGui::BeginDisabled(myResults.empty());
+    if (ImGui::Button("Select"))
+    {
+        theOutliner.SelectNodes(myResults);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Isolate"))
+    {
+        theOutliner.IsolateNodes(myResults);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Zoom"))
+    {
+        theOutliner.FitNodes(myResults);
+    }
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    if (ImGui::Button("Show all"))
+    {
+        theOutliner.ShowAll();
+    }
+
+    ImGui::BeginChild("##results");
+    const std::vector<OcctOutliner::Node>& aNodes = theOutliner.Nodes();
+    int aPicked = -1;
+    ImGuiListClipper aClipper;
+    aClipper.Begin((int)myResults.size());
+    while (aClipper.Step())
+    {
+        for (int aRow = aClipper.DisplayStart; aRow < aClipper.DisplayEnd; ++aRow)
+        {
+            const int aNode = myResults[aRow];
+            ImGui::PushID(aNode);
+            if (ImGui::Selectable(aNodes[aNode].Name.ToCString(), aNodes[aNode].IsSelected))
+            {
+                aPicked = aNode;
+            }
+            ImGui::PopID();
+        }
+    }
+    ImGui::EndChild();
+    ImGui::End();
+
+    if (aPicked >= 0)
+    {
+        theOutliner.SelectNode(aPicked);
+        theOutliner.RevealNode(aPicked);
+    }
+}
@@ -0,0 +1,87 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctSearchIndex_Header
+#define _OcctSearchIndex_Header
+
+#include "OcctOutliner.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//! Incremental search over part names, layers and properties of the outliner nodes.
+//! Each node is indexed as lower-case text, and every term matches as a substring of names and attributes.
+//! Terms of 3+ characters go through a trigram index, posting lists are intersected from the shortest one
+//! and candidates are verified by substring match; two-character terms use a bigram index,
+//! and single characters are searched by a direct scan over node texts.
+//! The filter syntax follows ImGuiTextFilter: "aaa,bbb" matches either term, "-ccc" excludes.
+class OcctSearchIndex
+{
+public:
+    //! Default constructor.
+    OcctSearchIndex();
+
+    //! Build the index over outliner nodes.
+    void Build(const OcctOutliner& theOutliner);
+
+    //! Find nodes matching the filter.
+    void Query(const char* theFilter, std::vector<int>& theNodes);
+
+    //! Render the search panel.
+    void RenderGui(OcctOutliner& theOutliner);
+
+private:
+    //! Find nodes containing the term (lower-case) in ascending order.
+    void queryTerm(const std::string& theTerm, std::vector<int>& theNodes) const;
+
+    //! Return searchable text of the node.
+    const char* nodeText(int theNode) const { return myText.data() + myOffsets[theNode]; }
+
+    //! Pack two characters into bigram key.
+    static uint32_t bigramKey(const char* theStr)
+    {
+        return (uint32_t(uint8_t(theStr[0])) << 8) | uint32_t(uint8_t(theStr[1]));
+    }
+
+    //! Pack three characters into trigram key.
+    static uint32_t trigramKey(const char* theStr)
+    {
+        return (uint32_t(uint8_t(theStr[0])) << 16) | (uint32_t(uint8_t(theStr[1])) << 8) | uint32_t(uint8_t(theStr[2]));
+    }
+
+private:
+    std::vector<char>                               myText;      //!< zero-terminated lower-case texts of nodes
+    std::vector<size_t>                             myOffsets;   //!< text offset per node
+    std::unordered_map<uint32_t, std::vector<int> > myTrigrams;  //!< trigram -> ascending node indices
+    std::unordered_map<uint32_t, std::vector<int> > myBigrams;   //!< bigram  -> ascending node indices
+    std::string                                     myLastTerm;  //!< last single-term query, for incremental refinement
+    std::vector<int>                                myLastNodes;
+    char                                            myFilter[256];
+    std::vector<int>                                myResults;
+    double                                          myBuildMs;
+    double                                          myQueryMs;
+};
+
+#endif // _OcctSearchIndex_Header
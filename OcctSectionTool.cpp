@@ -0,0 +1,362 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctSectionTool.h"
+
+#include "imgui/imgui.h"
+
+#include <OSD_Timer.hxx>
+#include <gp_Pln.hxx>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+    //! Capping and handle colors per plane.
+    const float THE_PLANE_COLORS[3][3] =
+    {
+        { 0.9f, 0.3f, 0.3f },
+        { 0.3f, 0.8f, 0.3f },
+        { 0.3f, 0.5f, 0.9f }
+    };
+}
+
+// ================================================================
+// Function : OcctSectionTool
+// Purpose  :
+// ================================================================
+OcctSectionTool::OcctSectionTool()
+    : myDragPlane(-1),
+    myHoverPlane(-1),
+    myIsCapping(true),
+    myIsHatched(false),
+    myFrameMs(0.0),
+    myNoCapFrameMs(0.0)
+{
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctSectionTool::Init(const Handle(AIS_InteractiveContext)& theCtx,
+                           const Handle(V3d_View)& theView)
+{
+    myContext = theCtx;
+    myView = theView;
+}
+
+// ================================================================
+// Function : normal
+// Purpose  :
+// ================================================================
+gp_Dir OcctSectionTool::normal(const SectionPlane& thePlane)
+{
+    switch (thePlane.Axis)
+    {
+        case 0: return gp::DX();
+        case 1: return gp::DY();
+        case 2: return gp::DZ();
+    }
+    const double aYaw   = thePlane.Yaw   * M_PI / 180.0;
+    const double aPitch = thePlane.Pitch * M_PI / 180.0;
+    return gp_Dir(std::cos(aPitch) * std::cos(aYaw), std::cos(aPitch) * std::sin(aYaw), std::sin(aPitch));
+}
+
+// ================================================================
+// Function : applyPlane
+// Purpose  :
+// ================================================================
+void OcctSectionTool::applyPlane(SectionPlane& thePlane)
+{
+    // only the equation uniform changes, presentations and caps are not recomputed
+    const gp_Dir aNormal = normal(thePlane);
+    const gp_Pnt aPnt = gp::Origin().Translated(gp_Vec(aNormal) * thePlane.Offset);
+    thePlane.Plane->SetEquation(gp_Pln(aPnt, thePlane.IsFlipped ? aNormal.Reversed() : aNormal));
+    thePlane.Plane->SetCapping(myIsCapping);
+    if (myIsHatched)
+    {
+        thePlane.Plane->SetCappingHatch(Aspect_HS_DIAGONAL_45);
+        thePlane.Plane->SetCappingHatchOn();
+    }
+    else
+    {
+        thePlane.Plane->SetCappingHatchOff();
+    }
+    myView->Invalidate();
+}
+
+// ================================================================
+// Function : updateBounds
+// Purpose  :
+// ================================================================
+void OcctSectionTool::updateBounds()
+{
+    myBounds = myView->View()->MinMaxValues();
+}
+
+// ================================================================
+// Function : handlePoints
+// Purpose  :
+// ================================================================
+bool OcctSectionTool::handlePoints(const SectionPlane& thePlane, Graphic3d_Vec2& theBase, Graphic3d_Vec2& theTip) const
+{
+    if (myBounds.IsVoid())
+    {
+        return false;
+    }
+
+    // the handle starts at the scene center projected onto the plane
+    const gp_Dir aNormal = normal(thePlane);
+    const gp_Dir aDir = thePlane.IsFlipped ? aNormal.Reversed() : aNormal;
+    const gp_Pnt aCenter = (myBounds.CornerMin().XYZ() + myBounds.CornerMax().XYZ()) * 0.5;
+    const double aDist = gp_Vec(aCenter.XYZ()).Dot(gp_Vec(aNormal)) - thePlane.Offset;
+    const gp_Pnt aBase = aCenter.Translated(gp_Vec(aNormal) * -aDist);
+    const gp_Pnt aTip  = aBase.Translated(gp_Vec(aDir) * (0.15 * std::sqrt(myBounds.SquareExtent())));
+
+    Standard_Integer aX = 0, aY = 0;
+    myView->Convert(aBase.X(), aBase.Y(), aBase.Z(), aX, aY);
+    theBase.SetValues((float)aX, (float)aY);
+    myView->Convert(aTip.X(), aTip.Y(), aTip.Z(), aX, aY);
+    theTip.SetValues((float)aX, (float)aY);
+    return true;
+}
+
+// ================================================================
+// Function : RenderOverlay
+// Purpose  :
+// ================================================================
+void OcctSectionTool::RenderOverlay(ImDrawList* theDrawList, const Graphic3d_Vec2& theOrigin, float thePixelRatio, bool theIsHovered)
+{
+    const ImGuiIO& aIO = ImGui::GetIO();
+    myHoverPlane = -1;
+    for (int aPlaneIter = 0; aPlaneIter < (int)myPlanes.size(); ++aPlaneIter)
+    {
+        const SectionPlane& aPlane = myPlanes[aPlaneIter];
+        Graphic3d_Vec2 aBase, aTip;
+        if (!aPlane.Plane->IsOn()
+         || !handlePoints(aPlane, aBase, aTip))
+        {
+            continue;
+        }
+
+        const ImVec2 aBasePos(theOrigin.x() + aBase.x() / thePixelRatio, theOrigin.y() + aBase.y() / thePixelRatio);
+        const ImVec2 aTipPos (theOrigin.x() + aTip.x()  / thePixelRatio, theOrigin.y() + aTip.y()  / thePixelRatio);
+        const float aDx = aIO.MousePos.x - aTipPos.x, aDy = aIO.MousePos.y - aTipPos.y;
+        if (myDragPlane < 0
+         && theIsHovered
+         && aDx * aDx + aDy * aDy < 64.0f)
+        {
+            myHoverPlane = aPlaneIter;
+        }
+
+        const float* aRgb = THE_PLANE_COLORS[aPlaneIter % 3];
+        const bool isActive = aPlaneIter == myDragPlane || aPlaneIter == myHoverPlane;
+        const ImU32 aColor = ImGui::ColorConvertFloat4ToU32(ImVec4(aRgb[0], aRgb[1], aRgb[2], isActive ? 1.0f : 0.8f));
+        theDrawList->AddLine(aBasePos, aTipPos, aColor, 2.0f);
+        theDrawList->AddCircleFilled(aBasePos, 3.0f, aColor);
+        theDrawList->AddCircleFilled(aTipPos, isActive ? 8.0f : 6.0f, aColor);
+    }
+
+    if (myHoverPlane >= 0
+     && ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+    {
+        myDragPlane = myHoverPlane;
+    }
+    if (myDragPlane < 0)
+    {
+        return;
+    }
+    if (!ImGui::IsMouseDown(ImGuiMouseButton_Left))
+    {
+        myDragPlane = -1;
+        return;
+    }
+
+    // mouse motion is projected onto the arrow on screen, the arrow length corresponds to the handle length in model space
+    SectionPlane& aPlane = myPlanes[myDragPlane];
+    Graphic3d_Vec2 aBase, aTip;
+    if ((aIO.MouseDelta.x != 0.0f || aIO.MouseDelta.y != 0.0f)
+      && handlePoints(aPlane, aBase, aTip))
+    {
+        const Graphic3d_Vec2 anArrow = aTip - aBase;
+        const float aLen2 = anArrow.Dot(anArrow);
+        if (aLen2 > 1.0f)
+        {
+            const Graphic3d_Vec2 aDelta(aIO.MouseDelta.x * thePixelRatio, aIO.MouseDelta.y * thePixelRatio);
+            const float aShift = aDelta.Dot(anArrow) / aLen2 * float(0.15 * std::sqrt(myBounds.SquareExtent()));
+            aPlane.Offset += aPlane.IsFlipped ? -aShift : aShift;
+            applyPlane(aPlane);
+        }
+    }
+}
+
+// ================================================================
+// Function : measureFrame
+// Purpose  :
+// ================================================================
+double OcctSectionTool::measureFrame(const Handle(OpenGl_Context)& theGlCtx,
+                                     const Handle(OpenGl_FrameBuffer)& theViewFbo,
+                                     int theNbFrames)
+{
+    // the view is redrawn into its FBO as within GlfwOcctView::renderView(), not into the window back buffer
+    theGlCtx->SetDefaultFrameBuffer(theViewFbo);
+    theGlCtx->core11fwd->glFinish();
+    OSD_Timer aTimer;
+    aTimer.Start();
+    for (int aFrameIter = 0; aFrameIter < theNbFrames; ++aFrameIter)
+    {
+        myView->Redraw();
+        theGlCtx->core11fwd->glFinish();
+    }
+    aTimer.Stop();
+    theGlCtx->SetDefaultFrameBuffer(Handle(OpenGl_FrameBuffer)());
+    theViewFbo->UnbindBuffer(theGlCtx);
+    return aTimer.ElapsedTime() * 1000.0 / theNbFrames;
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctSectionTool::RenderGui(const Handle(OpenGl_Context)& theGlCtx,
+                                const Handle(OpenGl_FrameBuffer)& theViewFbo)
+{
+    ImGui::Begin("Section");
+    if (myPlanes.size() < 3
+     && ImGui::Button("Add plane"))
+    {
+        updateBounds();
+        SectionPlane aPlane;
+        aPlane.Plane     = new Graphic3d_ClipPlane();
+        aPlane.Axis      = (int)myPlanes.size();
+        aPlane.Yaw       = 45.0f;
+        aPlane.Pitch     = 30.0f;
+        aPlane.IsFlipped = false;
+        const float* aRgb = THE_PLANE_COLORS[myPlanes.size()];
+        aPlane.Plane->SetCappingColor(Quantity_Color(aRgb[0], aRgb[1], aRgb[2], Quantity_TOC_RGB));
+        const gp_Pnt aCenter = myBounds.IsVoid() ? gp::Origin() : gp_Pnt((myBounds.CornerMin().XYZ() + myBounds.CornerMax().XYZ()) * 0.5);
+        aPlane.Offset = (float)gp_Vec(aCenter.XYZ()).Dot(gp_Vec(normal(aPlane)));
+        myPlanes.push_back(aPlane);
+        myView->AddClipPlane(aPlane.Plane);
+        applyPlane(myPlanes.back());
+    }
+
+    bool isChanged = ImGui::Checkbox("Capping", &myIsCapping);
+    ImGui::SameLine();
+    isChanged = ImGui::Checkbox("Hatch", &myIsHatched) || isChanged;
+    if (isChanged)
+    {
+        for (SectionPlane& aPlane : myPlanes)
+        {
+            applyPlane(aPlane);
+        }
+    }
+
+    const char* anAxes[] = { "X", "Y", "Z", "Custom" };
+    int aRemoved = -1;
+    for (int aPlaneIter = 0; aPlaneIter < (int)myPlanes.size(); ++aPlaneIter)
+    {
+        SectionPlane& aPlane = myPlanes[aPlaneIter];
+        ImGui::PushID(aPlaneIter);
+        char aTitle[32];
+        std::snprintf(aTitle, sizeof(aTitle), "Plane %d", aPlaneIter + 1);
+        ImGui::SeparatorText(aTitle);
+
+        bool isOn = aPlane.Plane->IsOn() == Standard_True;
+        if (ImGui::Checkbox("On", &isOn))
+        {
+            aPlane.Plane->SetOn(isOn);
+            myView->Invalidate();
+        }
+        ImGui::SameLine();
+        bool isPlaneChanged = ImGui::Checkbox("Flip", &aPlane.IsFlipped);
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Remove"))
+        {
+            aRemoved = aPlaneIter;
+        }
+        ImGui::SetNextItemWidth(100.0f);
+        isPlaneChanged = ImGui::Combo("Axis", &aPlane.Axis, anAxes, 4) || isPlaneChanged;
+        if (aPlane.Axis == 3)
+        {
+            isPlaneChanged = ImGui::SliderFloat("Yaw", &aPlane.Yaw, -180.0f, 180.0f, "%.0f deg") || isPlaneChanged;
+            isPlaneChanged = ImGui::SliderFloat("Pitch", &aPlane.Pitch, -90.0f, 90.0f, "%.0f deg") || isPlaneChanged;
+        }
+
+        // slider range spans the scene bounds along the plane normal
+        float aMin = -1.0f, aMax = 1.0f;
+        if (!myBounds.IsVoid())
+        {
+            const gp_Vec aNormal(normal(aPlane));
+            const gp_XYZ aCorners[2] = { myBounds.CornerMin().XYZ(), myBounds.CornerMax().XYZ() };
+            aMin = FLT_MAX;
+            aMax = -FLT_MAX;
+            for (int aCornerIter = 0; aCornerIter < 8; ++aCornerIter)
+            {
+                const gp_Vec aCorner(aCorners[aCornerIter & 1].X(), aCorners[(aCornerIter >> 1) & 1].Y(), aCorners[(aCornerIter >> 2) & 1].Z());
+                const float aProj = (float)aCorner.Dot(aNormal);
+                aMin = std::min(aMin, aProj);
+                aMax = std::max(aMax, aProj);
+            }
+        }
+        isPlaneChanged = ImGui::SliderFloat("Offset", &aPlane.Offset, aMin, aMax) || isPlaneChanged;
+        if (isPlaneChanged)
+        {
+            applyPlane(aPlane);
+        }
+        ImGui::PopID();
+    }
+    if (aRemoved >= 0)
+    {
+        myView->RemoveClipPlane(myPlanes[aRemoved].Plane);
+        myPlanes.erase(myPlanes.begin() + aRemoved);
+        myDragPlane = -1;
+        myView->Invalidate();
+    }
+
+    // capping is done by stencil passes within the redraw, so its cost is the difference of frame times
+    ImGui::SeparatorText("Capping cost");
+    ImGui::BeginDisabled(myPlanes.empty() || theViewFbo.IsNull());
+    if (ImGui::Button("Measure"))
+    {
+        updateBounds();
+        myFrameMs = measureFrame(theGlCtx, theViewFbo, 10);
+        for (SectionPlane& aPlane : myPlanes)
+        {
+            aPlane.Plane->SetCapping(Standard_False);
+        }
+        myNoCapFrameMs = measureFrame(theGlCtx, theViewFbo, 10);
+        for (SectionPlane& aPlane : myPlanes)
+        {
+            applyPlane(aPlane);
+        }
+    }
+    ImGui::EndDisabled();
+    ImGui::Text("Frame: %.2f ms, without caps: %.2f ms, caps: %.2f ms",
+                myFrameMs, myNoCapFrameMs, std::max(myFrameMs - myNoCapFrameMs, 0.0));
+    ImGui::End();
+}
@@ -0,0 +1,114 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctSectionTool_Header
+#define _OcctSectionTool_Header
+
+#include <AIS_InteractiveContext.hxx>
+#include <Bnd_Box.hxx>
+#include <Graphic3d_ClipPlane.hxx>
+#include <Graphic3d_Vec2.hxx>
+#include <OpenGl_Context.hxx>
+#include <OpenGl_FrameBuffer.hxx>
+#include <V3d_View.hxx>
+
+#include <vector>
+
+struct ImDrawList;
+
+//! Interactive section planes with capping.
+//! Planes are global Graphic3d_ClipPlane objects of the view, so moving a plane only changes
+//! the plane equation uniform and never recomputes presentations.
+//! Caps are produced in screen space by the stencil-based capping of OpenGl_View during the redraw,
+//! so no cap geometry is built or cached per object.
+//! Planes are moved by sliders or by dragging the normal arrow drawn over the viewport.
+class OcctSectionTool
+{
+public:
+    //! Default constructor.
+    OcctSectionTool();
+
+    //! Attach the tool to the interactive context and view.
+    void Init(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theView);
+
+    //! Return true if a plane handle is hovered or dragged, so that mouse input should not reach the view.
+    bool IsHandleActive() const { return myDragPlane >= 0 || myHoverPlane >= 0; }
+
+    //! Draw plane handles over the viewport image and drag them.
+    //! @param theDrawList   [in] draw list of the viewport window
+    //! @param theOrigin     [in] screen position of the viewport image
+    //! @param thePixelRatio [in] ratio between view pixels and screen units
+    //! @param theIsHovered  [in] the viewport image is hovered
+    void RenderOverlay(ImDrawList* theDrawList, const Graphic3d_Vec2& theOrigin, float thePixelRatio, bool theIsHovered);
+
+    //! Render the section panel.
+    //! @param theGlCtx   [in] OpenGL context
+    //! @param theViewFbo [in] offscreen FBO the view is rendered into
+    void RenderGui(const Handle(OpenGl_Context)& theGlCtx,
+                   const Handle(OpenGl_FrameBuffer)& theViewFbo);
+
+private:
+    //! Section plane state.
+    struct SectionPlane
+    {
+        Handle(Graphic3d_ClipPlane) Plane;
+        int                         Axis;       //!< 0, 1, 2 for X, Y, Z; 3 for custom direction
+        float                       Yaw;        //!< custom direction azimuth, degrees
+        float                       Pitch;      //!< custom direction elevation, degrees
+        float                       Offset;     //!< plane position along its normal
+        bool                        IsFlipped;
+    };
+
+private:
+    //! Return the plane normal.
+    static gp_Dir normal(const SectionPlane& thePlane);
+
+    //! Push the plane state into its equation.
+    void applyPlane(SectionPlane& thePlane);
+
+    //! Update scene bounds used for slider range and handle placement.
+    void updateBounds();
+
+    //! Return the handle base and tip in view pixels.
+    bool handlePoints(const SectionPlane& thePlane, Graphic3d_Vec2& theBase, Graphic3d_Vec2& theTip) const;
+
+    //! Redraw the view into its offscreen FBO several times and return average frame time.
+    double measureFrame(const Handle(OpenGl_Context)& theGlCtx,
+                        const Handle(OpenGl_FrameBuffer)& theViewFbo,
+                        int theNbFrames);
+
+private:
+    Handle(AIS_InteractiveContext) myContext;
+    Handle(V3d_View)               myView;
+    std::vector<SectionPlane>      myPlanes;
+    Bnd_Box                        myBounds;        //!< scene bounds
+    int                            myDragPlane;     //!< plane being dragged or -1
+    int                            myHoverPlane;    //!< plane with hovered handle or -1
+    bool                           myIsCapping;
+    bool                           myIsHatched;
+    double                         myFrameMs;       //!< frame time with capping
+    double                         myNoCapFrameMs;  //!< frame time without capping
+};
+
+#endif // _OcctSectionTool_Header
@@ -0,0 +1,167 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctShaderCache.h"
+
+#include "imgui/imgui.h"
+#include "imgui/imgui_impl_opengl3.h"
+
+#include <OSD_Directory.hxx>
+#include <OSD_Environment.hxx>
+#include <OSD_Path.hxx>
+#include <OSD_Protection.hxx>
+
+// ================================================================
+// Function : OcctShaderCache
+// Purpose  :
+// ================================================================
+OcctShaderCache::OcctShaderCache()
+    : myFirstFrameMs(0.0)
+{
+}
+
+// ================================================================
+// Function : setDefaultEnv
+// Purpose  :
+// ================================================================
+TCollection_AsciiString OcctShaderCache::setDefaultEnv(const TCollection_AsciiString& theName,
+                                                       const TCollection_AsciiString& theValue)
+{
+    OSD_Environment anEnv(theName);
+    const TCollection_AsciiString aValue = anEnv.Value();
+    if (!aValue.IsEmpty())
+    {
+        return aValue;
+    }
+
+    anEnv.SetValue(theValue);
+    anEnv.Build();
+    return theValue;
+}
+
+// ================================================================
+// Function : buildFolder
+// Purpose  :
+// ================================================================
+bool OcctShaderCache::buildFolder(const TCollection_AsciiString& thePath)
+{
+    // OSD_Directory::Build() creates a single level
+    for (int aCharIter = 2; aCharIter <= thePath.Length() + 1; ++aCharIter)
+    {
+        if (aCharIter <= thePath.Length()
+         && thePath.Value(aCharIter) != '/'
+         && thePath.Value(aCharIter) != '\\')
+        {
+            continue;
+        }
+
+        OSD_Directory aDir(OSD_Path(thePath.SubString(1, aCharIter - 1)));
+        if (!aDir.Exists())
+        {
+            aDir.Build(OSD_Protection());
+            if (aDir.Failed())
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctShaderCache::Init(const TCollection_AsciiString& theFolder)
+{
+    myFolder = theFolder;
+    if (myFolder.IsEmpty())
+    {
+        myFolder = OSD_Environment("OCCT_IMGUI_SHADER_CACHE").Value();
+    }
+    if (myFolder.IsEmpty())
+    {
+#ifdef _WIN32
+        const TCollection_AsciiString aUserCache = OSD_Environment("LOCALAPPDATA").Value();
+#else
+        TCollection_AsciiString aUserCache = OSD_Environment("XDG_CACHE_HOME").Value();
+        if (aUserCache.IsEmpty()
+        && !OSD_Environment("HOME").Value().IsEmpty())
+        {
+            aUserCache = OSD_Environment("HOME").Value() + "/.cache";
+        }
+#endif
+        if (!aUserCache.IsEmpty())
+        {
+            myFolder = aUserCache + "/OcctImgui/ShaderCache";
+        }
+    }
+    if (myFolder.IsEmpty()
+    || !buildFolder(myFolder + "/driver"))
+    {
+        myFolder.Clear();
+        return;
+    }
+
+    // drivers read these variables when the GL context is created
+    myMesaFolder   = setDefaultEnv("MESA_SHADER_CACHE_DIR", myFolder + "/driver");
+    setDefaultEnv("__GL_SHADER_DISK_CACHE", "1");
+    myNvidiaFolder = setDefaultEnv("__GL_SHADER_DISK_CACHE_PATH", myFolder + "/driver");
+}
+
+// ================================================================
+// Function : InitGui
+// Purpose  :
+// ================================================================
+void OcctShaderCache::InitGui() const
+{
+    ImGui_ImplOpenGL3_SetProgramBinaryCache(myFolder.IsEmpty() ? nullptr : myFolder.ToCString());
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctShaderCache::RenderGui()
+{
+    ImGui::Begin("Shader Cache");
+    if (myFolder.IsEmpty())
+    {
+        ImGui::TextUnformatted("Disabled: no writable cache folder");
+    }
+    else
+    {
+        ImGui::TextWrapped("Folder: %s", myFolder.ToCString());
+    }
+
+    ImGui::SeparatorText("ImGui program");
+    bool isFromCache = false;
+    const double aProgramMs = ImGui_ImplOpenGL3_GetProgramBuildTime(&isFromCache) * 1000.0;
+    ImGui::Text("%s in %.2f ms", isFromCache ? "Loaded from binary cache" : "Compiled", aProgramMs);
+
+    ImGui::SeparatorText("OCCT programs");
+    ImGui::Text("First 3D frame: %.1f ms", myFirstFrameMs);
+    ImGui::TextWrapped("Mesa cache: %s", myMesaFolder.IsEmpty() ? "-" : myMesaFolder.ToCString());
+    ImGui::TextWrapped("NVIDIA cache: %s", myNvidiaFolder.IsEmpty() ? "-" : myNvidiaFolder.ToCString());
+    ImGui::End();
+}
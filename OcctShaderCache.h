@@ -0,0 +1,72 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctShaderCache_Header
+#define _OcctShaderCache_Header
+
+#include <TCollection_AsciiString.hxx>
+
+//! Persistent cache of linked GLSL programs, so that startup and first use of shading modes skip compilation after the first run.
+//! The ImGui program is stored by the OpenGL3 backend through glGetProgramBinary(), keyed by driver strings and source hash.
+//! OCCT programs are built within OpenGl_ShaderManager, which has no program binary hook,
+//! so the on-disk shader caches of Mesa and NVIDIA drivers are enabled within the same folder instead
+//! (other drivers keep their own built-in caches).
+class OcctShaderCache
+{
+public:
+    //! Default constructor.
+    OcctShaderCache();
+
+    //! Select and create the cache folder and configure driver caches; should be called before creating the GL context.
+    //! Environment variables already set by the user are kept.
+    //! @param theFolder [in] cache folder; when empty, OCCT_IMGUI_SHADER_CACHE or the user cache folder is used
+    void Init(const TCollection_AsciiString& theFolder = TCollection_AsciiString());
+
+    //! Pass the cache folder to the ImGui backend; should be called after ImGui_ImplOpenGL3_Init() and before the first frame.
+    void InitGui() const;
+
+    //! Return the cache folder, empty if caching is disabled.
+    const TCollection_AsciiString& Folder() const { return myFolder; }
+
+    //! Store the time of the first 3D frame, which compiles OCCT programs of the initial shading modes.
+    void SetFirstFrameTime(double theMs) { myFirstFrameMs = theMs; }
+
+    //! Render the cache status window.
+    void RenderGui();
+
+private:
+    //! Set the environment variable unless it is already defined; return its value.
+    static TCollection_AsciiString setDefaultEnv(const TCollection_AsciiString& theName,
+                                                 const TCollection_AsciiString& theValue);
+
+    //! Create the folder with missing parent folders; return false on failure.
+    static bool buildFolder(const TCollection_AsciiString& thePath);
+
+private:
+    TCollection_AsciiString myFolder;
+    TCollection_AsciiString myMesaFolder;   //!< MESA_SHADER_CACHE_DIR in effect
+    TCollection_AsciiString myNvidiaFolder; //!< __GL_SHADER_DISK_CACHE_PATH in effect
+    double                  myFirstFrameMs;
+};
+
+#endif // _OcctShaderCache_Header
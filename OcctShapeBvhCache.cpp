@@ -0,0 +1,292 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctShapeBvhCache.h"
+
+#include <BRep_Tool.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <OSD_Parallel.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    //! Return square distance from the point to the axis-aligned box.
+    static Standard_Real squareDistanceToBox(const BVH_Vec3d& thePnt,
+                                             const BVH_Vec3d& theMin,
+                                             const BVH_Vec3d& theMax)
+    {
+        const Standard_Real aDX = std::max(std::max(theMin.x() - thePnt.x(), thePnt.x() - theMax.x()), 0.0);
+        const Standard_Real aDY = std::max(std::max(theMin.y() - thePnt.y(), thePnt.y() - theMax.y()), 0.0);
+        const Standard_Real aDZ = std::max(std::max(theMin.z() - thePnt.z(), thePnt.z() - theMax.z()), 0.0);
+        return aDX * aDX + aDY * aDY + aDZ * aDZ;
+    }
+
+    //! Return square distance from the point to the bounding box.
+    static Standard_Real squareDistanceToBox(const BVH_Vec3d& thePnt, const Bnd_Box& theBox)
+    {
+        if (theBox.IsVoid())
+        {
+            return RealLast();
+        }
+        const gp_Pnt aMin = theBox.CornerMin();
+        const gp_Pnt aMax = theBox.CornerMax();
+        return squareDistanceToBox(thePnt, BVH_Vec3d(aMin.X(), aMin.Y(), aMin.Z()), BVH_Vec3d(aMax.X(), aMax.Y(), aMax.Z()));
+    }
+
+    //! Return the point of triangle (A, B, C) nearest to P (Ericson, Real-Time Collision Detection 5.1.5).
+    static BVH_Vec3d nearestPointOnTriangle(const BVH_Vec3d& theP,
+                                            const BVH_Vec3d& theA,
+                                            const BVH_Vec3d& theB,
+                                            const BVH_Vec3d& theC)
+    {
+        const BVH_Vec3d anAB = theB - theA;
+        const BVH_Vec3d anAC = theC - theA;
+        const BVH_Vec3d anAP = theP - theA;
+        const Standard_Real aD1 = anAB.Dot(anAP);
+        const Standard_Real aD2 = anAC.Dot(anAP);
+        if (aD1 <= 0.0 && aD2 <= 0.0)
+        {
+            return theA;
+        }
+
+        const BVH_Vec3d aBP = theP - theB;
+        const Standard_Real aD3 = anAB.Dot(aBP);
+        const Standard_Real aD4 = anAC.Dot(aBP);
+        if (aD3 >= 0.0 && aD4 <= aD3)
+        {
+            return theB;
+        }
+
+        const Standard_Real aVC = aD1 * aD4 - aD3 * aD2;
+        if (aVC <= 0.0 && aD1 >= 0.0 && aD3 <= 0.0)
+        {
+            return theA + anAB * (aD1 / (aD1 - aD3));
+        }
+
+        const BVH_Vec3d aCP = theP - theC;
+        const Standard_Real aD5 = anAB.Dot(aCP);
+        const Standard_Real aD6 = anAC.Dot(aCP);
+        if (aD6 >= 0.0 && aD5 <= aD6)
+        {
+            return theC;
+        }
+
+        const Standard_Real aVB = aD5 * aD2 - aD1 * aD6;
+        if (aVB <= 0.0 && aD2 >= 0.0 && aD6 <= 0.0)
+        {
+            return theA + anAC * (aD2 / (aD2 - aD6));
+        }
+
+        const Standard_Real aVA = aD3 * aD6 - aD5 * aD4;
+        if (aVA <= 0.0 && (aD4 - aD3) >= 0.0 && (aD5 - aD6) >= 0.0)
+        {
+            return theB + (theC - theB) * ((aD4 - aD3) / ((aD4 - aD3) + (aD5 - aD6)));
+        }
+
+        const Standard_Real aDenom = 1.0 / (aVA + aVB + aVC);
+        return theA + anAB * (aVB * aDenom) + anAC * (aVC * aDenom);
+    }
+}
+
+// ================================================================
+// Function : Faces
+// Purpose  :
+// ================================================================
+const NCollection_Vector<OcctShapeBvhCache::FaceEntry>& OcctShapeBvhCache::Faces(const TopoDS_Shape& theShape)
+{
+    if (const NCollection_Vector<FaceEntry>* aCached = myShapes.Seek(theShape))
+    {
+        if (validate(theShape, *aCached))
+        {
+            return *aCached;
+        }
+    }
+
+    // collect faces which have not been seen yet
+    NCollection_Vector<TopoDS_Face> aNewFaces;
+    bool toMesh = false;
+    for (TopExp_Explorer anExp(theShape, TopAbs_FACE); anExp.More(); anExp.Next())
+    {
+        const TopoDS_Face& aFace = TopoDS::Face(anExp.Current());
+        if (!myFaces.IsBound(aFace))
+        {
+            TopLoc_Location aLoc;
+            toMesh = toMesh || BRep_Tool::Triangulation(aFace, aLoc).IsNull();
+            aNewFaces.Append(aFace);
+        }
+    }
+    if (toMesh)
+    {
+        Bnd_Box aShapeBox;
+        BRepBndLib::Add(theShape, aShapeBox);
+        const Standard_Real aDeflection = aShapeBox.IsVoid() ? 0.1 : 0.001 * std::sqrt(aShapeBox.SquareExtent());
+        BRepMesh_IncrementalMesh aMesher(theShape, aDeflection, Standard_False, 0.5, Standard_True);
+    }
+
+    // triangle sets build their BVH lazily - force it here so that queries are read-only
+    NCollection_Array1<FaceEntry> aBuilt(0, std::max(aNewFaces.Length() - 1, 0));
+    OSD_Parallel::For(0, aNewFaces.Length(), [&](int theIndex)
+    {
+        FaceEntry& anEntry = aBuilt.ChangeValue(theIndex);
+        anEntry.Face = aNewFaces.Value(theIndex);
+        TopLoc_Location aLoc;
+        anEntry.Triangulation = BRep_Tool::Triangulation(anEntry.Face, aLoc);
+
+        BRepExtrema_ShapeList aList;
+        aList.Append(anEntry.Face);
+        anEntry.Triangles = new BRepExtrema_TriangleSet(aList);
+        if (anEntry.Triangles->Size() == 0)
+        {
+            anEntry.Triangles.Nullify();
+            return;
+        }
+        anEntry.Triangles->BVH();
+        BRepBndLib::Add(anEntry.Face, anEntry.Box);
+    });
+    for (int anIter = 0; anIter < aNewFaces.Length(); ++anIter)
+    {
+        myFaces.Bind(aBuilt.Value(anIter).Face, aBuilt.Value(anIter));
+    }
+
+    NCollection_Vector<FaceEntry> anEntries;
+    for (TopExp_Explorer anExp(theShape, TopAbs_FACE); anExp.More(); anExp.Next())
+    {
+        const FaceEntry& anEntry = myFaces.Find(anExp.Current());
+        if (!anEntry.Triangles.IsNull())
+        {
+            anEntries.Append(anEntry);
+        }
+    }
+    return *myShapes.Bound(theShape, anEntries);
+}
+
+// ================================================================
+// Function : validate
+// Purpose  :
+// ================================================================
+bool OcctShapeBvhCache::validate(const TopoDS_Shape& theShape, const NCollection_Vector<FaceEntry>& theEntries)
+{
+    // triangulations may be swapped in place (e.g. by view-dependent refinement)
+    bool isValid = true;
+    for (NCollection_Vector<FaceEntry>::Iterator aFaceIter(theEntries); aFaceIter.More(); aFaceIter.Next())
+    {
+        TopLoc_Location aLoc;
+        if (BRep_Tool::Triangulation(aFaceIter.Value().Face, aLoc) != aFaceIter.Value().Triangulation)
+        {
+            myFaces.UnBind(aFaceIter.Value().Face);
+            isValid = false;
+        }
+    }
+    if (!isValid)
+    {
+        myShapes.UnBind(theShape);
+    }
+    return isValid;
+}
+
+// ================================================================
+// Function : NearestPoint
+// Purpose  :
+// ================================================================
+bool OcctShapeBvhCache::NearestPoint(const TopoDS_Shape& theShape,
+                                     const gp_Pnt& thePnt,
+                                     gp_Pnt& theNearest,
+                                     Standard_Real& theDistance)
+{
+    const NCollection_Vector<FaceEntry>& aFaces = Faces(theShape);
+    const BVH_Vec3d aPnt(thePnt.X(), thePnt.Y(), thePnt.Z());
+
+    Standard_Real aBestSqDist = RealLast();
+    BVH_Vec3d aBestPnt;
+    for (NCollection_Vector<FaceEntry>::Iterator aFaceIter(aFaces); aFaceIter.More(); aFaceIter.Next())
+    {
+        const FaceEntry& anEntry = aFaceIter.Value();
+        if (squareDistanceToBox(aPnt, anEntry.Box) >= aBestSqDist)
+        {
+            continue;
+        }
+
+        const opencascade::handle<BVH_Tree<Standard_Real, 3> >& aBvh = anEntry.Triangles->BVH();
+        int aStack[64];
+        int aHead = -1;
+        int aNode = 0;
+        for (;;)
+        {
+            if (aBvh->IsOuter(aNode))
+            {
+                for (int anElem = aBvh->BegPrimitive(aNode); anElem <= aBvh->EndPrimitive(aNode); ++anElem)
+                {
+                    BVH_Vec3d aV1, aV2, aV3;
+                    anEntry.Triangles->GetVertices(anElem, aV1, aV2, aV3);
+                    const BVH_Vec3d aCandidate = nearestPointOnTriangle(aPnt, aV1, aV2, aV3);
+                    const Standard_Real aSqDist = (aCandidate - aPnt).SquareModulus();
+                    if (aSqDist < aBestSqDist)
+                    {
+                        aBestSqDist = aSqDist;
+                        aBestPnt = aCandidate;
+                    }
+                }
+            }
+            else
+            {
+                const int aLeft  = aBvh->template Child<0>(aNode);
+                const int aRight = aBvh->template Child<1>(aNode);
+                const Standard_Real aDistLeft  = squareDistanceToBox(aPnt, aBvh->MinPoint(aLeft),  aBvh->MaxPoint(aLeft));
+                const Standard_Real aDistRight = squareDistanceToBox(aPnt, aBvh->MinPoint(aRight), aBvh->MaxPoint(aRight));
+                const bool toVisitLeft  = aDistLeft  < aBestSqDist;
+                const bool toVisitRight = aDistRight < aBestSqDist;
+                if (toVisitLeft && toVisitRight)
+                {
+                    // visit the nearer child first to tighten the bound early
+                    aNode = aDistLeft <= aDistRight ? aLeft : aRight;
+                    aStack[++aHead] = aDistLeft <= aDistRight ? aRight : aLeft;
+                    continue;
+                }
+                if (toVisitLeft || toVisitRight)
+                {
+                    aNode = toVisitLeft ? aLeft : aRight;
+                    continue;
+                }
+            }
+
+            if (aHead < 0)
+            {
+                break;
+            }
+            aNode = aStack[aHead--];
+        }
+    }
+
+    if (aBestSqDist == RealLast())
+    {
+        return false;
+    }
+    theNearest.SetCoord(aBestPnt.x(), aBestPnt.y(), aBestPnt.z());
+    theDistance = std::sqrt(aBestSqDist);
+    return true;
+}
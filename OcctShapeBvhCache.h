@@ -0,0 +1,82 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctShapeBvhCache_Header
+#define _OcctShapeBvhCache_Header
+
+#include <BRepExtrema_TriangleSet.hxx>
+#include <Bnd_Box.hxx>
+#include <NCollection_DataMap.hxx>
+#include <NCollection_Vector.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopTools_ShapeMapHasher.hxx>
+#include <gp_Pnt.hxx>
+
+//! Cache of per-face triangle BVHs used for fast nearest point queries.
+//! Face sets are shared between shapes referring to the same located face.
+//! Entries remember the triangulation they were built from and are rebuilt once the face triangulation is replaced.
+class OcctShapeBvhCache
+{
+public:
+    //! Cached face: triangle set with its BVH and bounding box.
+    struct FaceEntry
+    {
+        TopoDS_Face                     Face;
+        Handle(Poly_Triangulation)      Triangulation; //!< triangulation the set has been built from
+        Handle(BRepExtrema_TriangleSet) Triangles;
+        Bnd_Box                         Box;
+    };
+
+public:
+    //! Default constructor.
+    OcctShapeBvhCache() {}
+
+    //! Return faces of the shape, building missing face BVHs in parallel.
+    //! Shapes without triangulation are meshed on the first request.
+    const NCollection_Vector<FaceEntry>& Faces(const TopoDS_Shape& theShape);
+
+    //! Find the point of the shape nearest to thePnt.
+    //! Returns false if the shape has no triangles.
+    bool NearestPoint(const TopoDS_Shape& theShape,
+                      const gp_Pnt& thePnt,
+                      gp_Pnt& theNearest,
+                      Standard_Real& theDistance);
+
+    //! Release all cached data.
+    void Clear()
+    {
+        myShapes.Clear();
+        myFaces.Clear();
+    }
+
+private:
+    //! Drop cached entries of the shape whose faces got another triangulation; return false if some were dropped.
+    bool validate(const TopoDS_Shape& theShape, const NCollection_Vector<FaceEntry>& theEntries);
+
+private:
+    NCollection_DataMap<TopoDS_Shape, NCollection_Vector<FaceEntry>, TopTools_ShapeMapHasher> myShapes;
+    NCollection_DataMap<TopoDS_Shape, FaceEntry, TopTools_ShapeMapHasher> myFaces;
+};
+
+#endif // _OcctShapeBvhCache_Header
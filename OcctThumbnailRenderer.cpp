@@ -0,0 +1,539 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctThumbnailRenderer.h"
+
+#include "imgui/imgui.h"
+
+#include <AIS_Shape.hxx>
+#include <Message.hxx>
+#include <Message_Messenger.hxx>
+#include <OSD_Directory.hxx>
+#include <OSD_Path.hxx>
+#include <OSD_Protection.hxx>
+#include <V3d_ImageDumpOptions.hxx>
+#include <V3d_Viewer.hxx>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+// ================================================================
+// Function : OcctThumbnailRenderer
+// Purpose  :
+// ================================================================
+OcctThumbnailRenderer::OcctThumbnailRenderer()
+    : myNextPart(0),
+    myToRenderAll(false),
+    mySize(128),
+    myGallerySize(96.0f),
+    myToStop(false),
+    myNbQueued(0),
+    myNbWritten(0),
+    myNbFailed(0),
+    myNbRendered(0),
+    myRenderMs(0.0),
+    myBatchSeconds(0.0)
+{
+    std::strcpy(myOutDirBuffer, "thumbnails");
+}
+
+// ================================================================
+// Function : ~OcctThumbnailRenderer
+// Purpose  :
+// ================================================================
+OcctThumbnailRenderer::~OcctThumbnailRenderer()
+{
+    Release(Handle(OpenGl_Context)());
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctThumbnailRenderer::Init(const Handle(AIS_InteractiveContext)& theCtx,
+                                 const Handle(V3d_View)& theMainView,
+                                 Aspect_RenderingContext theGlContext)
+{
+    // a private viewer on the same driver keeps thumbnail parts out of the main scene
+    // while sharing GL resources with it
+    Handle(V3d_Viewer) aViewer = new V3d_Viewer(theCtx->CurrentViewer()->Driver());
+    aViewer->SetDefaultLights();
+    aViewer->SetLightOn();
+    myContext = new AIS_InteractiveContext(aViewer);
+
+    myWindow = new Aspect_NeutralWindow();
+    myWindow->SetVirtual(Standard_True);
+    myWindow->SetNativeHandle(theMainView->Window()->NativeHandle());
+    myWindow->SetSize(mySize, mySize);
+
+    myView = aViewer->CreateView();
+    myView->SetImmediateUpdate(Standard_False);
+    myView->SetWindow(myWindow, theGlContext);
+    myView->SetBackgroundColor(theMainView->BackgroundColor());
+}
+
+// ================================================================
+// Function : SetAssembly
+// Purpose  :
+// ================================================================
+void OcctThumbnailRenderer::SetAssembly(const OcctOutliner& theOutliner)
+{
+    myAssembly.clear();
+    myNextPart = 0;
+    for (const OcctOutliner::Node& aNode : theOutliner.Nodes())
+    {
+        Handle(AIS_Shape) aPrs = Handle(AIS_Shape)::DownCast(aNode.Object);
+        if (aPrs.IsNull())
+        {
+            continue;
+        }
+
+        // instances differ only by location, the part shape itself is the cache key
+        const TopoDS_Shape aShape = aPrs->Shape().Located(TopLoc_Location());
+        int anIndex = 0;
+        if (!myPartIndices.Find(aShape, anIndex))
+        {
+            anIndex = (int)myParts.size();
+            Thumbnail aThumb;
+            aThumb.Name      = aNode.Name;
+            aThumb.Shape     = aShape;
+            aThumb.Size      = 0;
+            aThumb.IsTopDown = false;
+            myParts.push_back(aThumb);
+            myPartIndices.Bind(aShape, anIndex);
+            myAssembly.push_back(anIndex);
+        }
+        else if (std::find(myAssembly.begin(), myAssembly.end(), anIndex) == myAssembly.end())
+        {
+            myAssembly.push_back(anIndex);
+        }
+    }
+    myNextPart = (int)myAssembly.size();
+}
+
+// ================================================================
+// Function : startWorkers
+// Purpose  :
+// ================================================================
+void OcctThumbnailRenderer::startWorkers()
+{
+    if (!myWorkers.empty())
+    {
+        return;
+    }
+
+    // the GL thread renders, so the encoders take the remaining cores
+    const int aNbWorkers = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+    myToStop = false;
+    for (int aWorkerIter = 0; aWorkerIter < aNbWorkers; ++aWorkerIter)
+    {
+        myWorkers.emplace_back([this]() { encodeLoop(); });
+    }
+}
+
+// ================================================================
+// Function : Start
+// Purpose  :
+// ================================================================
+bool OcctThumbnailRenderer::Start(const TCollection_AsciiString& theOutDir)
+{
+    if (IsRunning())
+    {
+        return false;
+    }
+
+    if (!theOutDir.IsEmpty())
+    {
+        myExtension = buildFolder(theOutDir)
+                    ? probeExtension(theOutDir)
+                    : TCollection_AsciiString();
+        if (myExtension.IsEmpty())
+        {
+            Message::DefaultMessenger()->Send(TCollection_AsciiString("Unable to write thumbnails into '") + theOutDir + "'", Message_Fail);
+            return false;
+        }
+        if (myExtension != ".png")
+        {
+            Message::DefaultMessenger()->Send("OCCT is built without image library, thumbnails are written as PPM", Message_Warning);
+        }
+    }
+
+    myOutDir      = theOutDir;
+    myToRenderAll = !theOutDir.IsEmpty();
+    myNextPart    = 0;
+    myNbRendered  = 0;
+    myRenderMs    = 0.0;
+    myNbWritten   = 0;
+    myNbFailed    = 0;
+    myBatchSeconds = 0.0;
+    myBatchTimer.Reset();
+    myBatchTimer.Start();
+    if (!myOutDir.IsEmpty())
+    {
+        startWorkers();
+    }
+    return true;
+}
+
+// ================================================================
+// Function : buildFolder
+// Purpose  :
+// ================================================================
+bool OcctThumbnailRenderer::buildFolder(const TCollection_AsciiString& thePath)
+{
+    // OSD_Directory::Build() creates a single level
+    for (int aCharIter = 2; aCharIter <= thePath.Length() + 1; ++aCharIter)
+    {
+        if (aCharIter <= thePath.Length()
+         && thePath.Value(aCharIter) != '/'
+         && thePath.Value(aCharIter) != '\\')
+        {
+            continue;
+        }
+
+        OSD_Directory aDir(OSD_Path(thePath.SubString(1, aCharIter - 1)));
+        if (!aDir.Exists())
+        {
+            aDir.Build(OSD_Protection());
+            if (aDir.Failed())
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// ================================================================
+// Function : probeExtension
+// Purpose  :
+// ================================================================
+TCollection_AsciiString OcctThumbnailRenderer::probeExtension(const TCollection_AsciiString& theOutDir)
+{
+    Image_AlienPixMap aProbe;
+    if (!aProbe.InitZero(Image_Format_RGB, 1, 1))
+    {
+        return TCollection_AsciiString();
+    }
+
+    // without FreeImage or WIC the image is saved as PPM whatever the extension is
+    const TCollection_AsciiString aPath = theOutDir + "/.thumbnail_probe.png";
+    if (!aProbe.Save(aPath))
+    {
+        return TCollection_AsciiString();
+    }
+
+    char aSignature[4] = {};
+    {
+        std::ifstream aFile(aPath.ToCString(), std::ios::binary);
+        aFile.read(aSignature, sizeof(aSignature));
+    }
+    std::remove(aPath.ToCString());
+    return std::memcmp(aSignature, "\x89PNG", 4) == 0 ? ".png" : ".ppm";
+}
+
+// ================================================================
+// Function : Step
+// Purpose  :
+// ================================================================
+void OcctThumbnailRenderer::Step(const Handle(OpenGl_Context)& theGlCtx, double theBudgetMs)
+{
+    if (myNextPart >= (int)myAssembly.size())
+    {
+        return;
+    }
+
+    OSD_Timer aTimer;
+    aTimer.Start();
+    while (myNextPart < (int)myAssembly.size()
+        && aTimer.ElapsedTime() * 1000.0 < theBudgetMs)
+    {
+        const int aPart = myAssembly[myNextPart++];
+        if (myToRenderAll
+         || myParts[aPart].Texture.IsNull()
+         || myParts[aPart].Size != mySize)
+        {
+            renderPart(theGlCtx, aPart);
+        }
+    }
+    aTimer.Stop();
+    myRenderMs += aTimer.ElapsedTime() * 1000.0;
+
+    if (myOutDir.IsEmpty())
+    {
+        std::lock_guard<std::mutex> aLock(myMutex);
+        myBatchSeconds = myBatchTimer.ElapsedTime();
+    }
+}
+
+// ================================================================
+// Function : Finish
+// Purpose  :
+// ================================================================
+void OcctThumbnailRenderer::Finish(const Handle(OpenGl_Context)& theGlCtx)
+{
+    Step(theGlCtx, 1.0e+12);
+
+    std::unique_lock<std::mutex> aLock(myMutex);
+    myDoneCond.wait(aLock, [this]() { return myNbQueued == 0; });
+}
+
+// ================================================================
+// Function : ThumbnailsPerSecond
+// Purpose  :
+// ================================================================
+double OcctThumbnailRenderer::ThumbnailsPerSecond() const
+{
+    std::lock_guard<std::mutex> aLock(myMutex);
+    const int aNbDone = myOutDir.IsEmpty() ? myNbRendered : (int)myNbWritten;
+    return myBatchSeconds > 0.0 ? aNbDone / myBatchSeconds : 0.0;
+}
+
+// ================================================================
+// Function : renderPart
+// Purpose  :
+// ================================================================
+void OcctThumbnailRenderer::renderPart(const Handle(OpenGl_Context)& theGlCtx, int thePart)
+{
+    Thumbnail& aThumb = myParts[thePart];
+    Standard_Integer aWidth = 0, aHeight = 0;
+    myWindow->Size(aWidth, aHeight);
+    if (aWidth != mySize)
+    {
+        myWindow->SetSize(mySize, mySize);
+        myView->MustBeResized();
+    }
+
+    Handle(AIS_Shape) aPrs = new AIS_Shape(aThumb.Shape);
+    myContext->Display(aPrs, AIS_Shaded, -1, Standard_False);
+    myView->SetProj(V3d_XposYnegZpos, Standard_False);
+    myView->FitAll(0.05, Standard_False);
+
+    Handle(Image_AlienPixMap) anImage = new Image_AlienPixMap();
+    V3d_ImageDumpOptions aParams;
+    aParams.Width          = mySize;
+    aParams.Height         = mySize;
+    aParams.BufferType     = Graphic3d_BT_RGB;
+    aParams.ToAdjustAspect = Standard_True;
+    const bool isRendered = myView->ToPixMap(*anImage, aParams);
+    myContext->Remove(aPrs, Standard_False);
+    if (!isRendered)
+    {
+        ++myNbFailed;
+        return;
+    }
+    ++myNbRendered;
+
+    // the gallery texture is uploaded before the image is handed over to the encoder
+    if (!aThumb.Texture.IsNull())
+    {
+        aThumb.Texture->Release(theGlCtx.get());
+    }
+    aThumb.Texture = new OpenGl_Texture();
+    aThumb.Texture->Init(theGlCtx, *anImage, Graphic3d_TOT_2D, Standard_True);
+    aThumb.Size      = mySize;
+    aThumb.IsTopDown = anImage->IsTopDown();
+    if (myOutDir.IsEmpty())
+    {
+        return;
+    }
+
+    TCollection_AsciiString aFileName = aThumb.Name;
+    for (int aCharIter = 1; aCharIter <= aFileName.Length(); ++aCharIter)
+    {
+        if (!IsAlphanumeric(aFileName.Value(aCharIter)))
+        {
+            aFileName.SetValue(aCharIter, '_');
+        }
+    }
+    EncodeJob aJob;
+    aJob.Image = anImage;
+    aJob.Path  = myOutDir + "/" + thePart + "_" + aFileName + myExtension;
+
+    // the queue is bounded, so that rendering stalls instead of piling up images when encoders fall behind
+    std::unique_lock<std::mutex> aLock(myMutex);
+    myDoneCond.wait(aLock, [this]() { return myQueue.size() < 2 * myWorkers.size(); });
+    myQueue.push_back(aJob);
+    ++myNbQueued;
+    aLock.unlock();
+    myQueueCond.notify_one();
+}
+
+// ================================================================
+// Function : encodeLoop
+// Purpose  :
+// ================================================================
+void OcctThumbnailRenderer::encodeLoop()
+{
+    for (;;)
+    {
+        EncodeJob aJob;
+        {
+            std::unique_lock<std::mutex> aLock(myMutex);
+            myQueueCond.wait(aLock, [this]() { return myToStop || !myQueue.empty(); });
+            if (myQueue.empty())
+            {
+                return;
+            }
+            aJob = myQueue.front();
+            myQueue.pop_front();
+        }
+
+        if (aJob.Image->Save(aJob.Path))
+        {
+            ++myNbWritten;
+        }
+        else
+        {
+            ++myNbFailed;
+        }
+        aJob.Image.Nullify();
+
+        {
+            std::lock_guard<std::mutex> aLock(myMutex);
+            myBatchSeconds = myBatchTimer.ElapsedTime();
+            --myNbQueued;
+        }
+        myDoneCond.notify_all();
+    }
+}
+
+// ================================================================
+// Function : Release
+// Purpose  :
+// ================================================================
+void OcctThumbnailRenderer::Release(const Handle(OpenGl_Context)& theGlCtx)
+{
+    {
+        std::lock_guard<std::mutex> aLock(myMutex);
+        myToStop = true;
+    }
+    myQueueCond.notify_all();
+    for (std::thread& aWorker : myWorkers)
+    {
+        aWorker.join();
+    }
+    myWorkers.clear();
+
+    if (theGlCtx.IsNull())
+    {
+        return;
+    }
+    for (Thumbnail& aThumb : myParts)
+    {
+        if (!aThumb.Texture.IsNull())
+        {
+            aThumb.Texture->Release(theGlCtx.get());
+            aThumb.Texture.Nullify();
+        }
+    }
+    if (!myView.IsNull())
+    {
+        myView->Remove();
+        myView.Nullify();
+    }
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctThumbnailRenderer::RenderGui(const Handle(OpenGl_Context)& theGlCtx)
+{
+    // a slice of the batch per frame keeps the UI responsive
+    Step(theGlCtx, 8.0);
+
+    ImGui::Begin("Thumbnails");
+    const bool isRunning = IsRunning();
+    ImGui::BeginDisabled(isRunning);
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::SliderInt("Size", &mySize, 32, 512);
+    ImGui::SetNextItemWidth(200.0f);
+    ImGui::InputText("Folder", myOutDirBuffer, sizeof(myOutDirBuffer));
+    if (ImGui::Button("Render missing"))
+    {
+        Start(TCollection_AsciiString());
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Export all"))
+    {
+        Start(TCollection_AsciiString(myOutDirBuffer));
+    }
+    ImGui::EndDisabled();
+
+    ImGui::Text("Rendered: %d  Written: %d  Failed: %d  Queued: %d",
+                myNbRendered, (int)myNbWritten, (int)myNbFailed, (int)myNbQueued);
+    ImGui::Text("%.1f thumbnails/s, GL %.2f ms/thumbnail",
+                ThumbnailsPerSecond(), myNbRendered > 0 ? myRenderMs / myNbRendered : 0.0);
+
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::SliderFloat("Tile", &myGallerySize, 32.0f, 256.0f, "%.0f");
+    ImGui::Separator();
+
+    // gallery rows are clipped, so only visible tiles are submitted
+    ImGui::BeginChild("##gallery");
+    const float aSpacing = ImGui::GetStyle().ItemSpacing.x;
+    const int aNbColumns = std::max(1, int((ImGui::GetContentRegionAvail().x + aSpacing) / (myGallerySize + aSpacing)));
+    const int aNbRows = ((int)myAssembly.size() + aNbColumns - 1) / aNbColumns;
+    ImGuiListClipper aClipper;
+    aClipper.Begin(aNbRows, myGallerySize + ImGui::GetStyle().ItemSpacing.y);
+    while (aClipper.Step())
+    {
+        for (int aRow = aClipper.DisplayStart; aRow < aClipper.DisplayEnd; ++aRow)
+        {
+            for (int aColumn = 0; aColumn < aNbColumns; ++aColumn)
+            {
+                const int anItem = aRow * aNbColumns + aColumn;
+                if (anItem >= (int)myAssembly.size())
+                {
+                    break;
+                }
+                if (aColumn > 0)
+                {
+                    ImGui::SameLine();
+                }
+
+                const Thumbnail& aThumb = myParts[myAssembly[anItem]];
+                if (aThumb.Texture.IsNull())
+                {
+                    ImGui::Dummy(ImVec2(myGallerySize, myGallerySize));
+                }
+                else
+                {
+                    ImGui::Image((ImTextureID)(intptr_t)aThumb.Texture->TextureId(),
+                                 ImVec2(myGallerySize, myGallerySize),
+                                 ImVec2(0.0f, aThumb.IsTopDown ? 0.0f : 1.0f),
+                                 ImVec2(1.0f, aThumb.IsTopDown ? 1.0f : 0.0f));
+                }
+                if (ImGui::IsItemHovered())
+                {
+                    ImGui::SetTooltip("%s", aThumb.Name.ToCString());
+                }
+            }
+        }
+    }
+    ImGui::EndChild();
+    ImGui::End();
+}
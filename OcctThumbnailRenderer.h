@@ -0,0 +1,165 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctThumbnailRenderer_Header
+#define _OcctThumbnailRenderer_Header
+
+#include "OcctOutliner.h"
+
+#include <AIS_InteractiveContext.hxx>
+#include <Aspect_NeutralWindow.hxx>
+#include <Image_AlienPixMap.hxx>
+#include <NCollection_DataMap.hxx>
+#include <OpenGl_Context.hxx>
+#include <OpenGl_Texture.hxx>
+#include <OSD_Timer.hxx>
+#include <TCollection_AsciiString.hxx>
+#include <TopTools_ShapeMapHasher.hxx>
+#include <V3d_View.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! Batch thumbnail generator for parts.
+//! A single offscreen V3d_View of a private viewer on the shared graphic driver renders each part
+//! through V3d_View::ToPixMap() on the GL thread, while images are encoded and written by worker threads,
+//! so that GPU rendering of the next part overlaps with encoding of the previous ones.
+//! Rendered thumbnails are cached per part shape and shown in the ImGui gallery.
+class OcctThumbnailRenderer
+{
+public:
+    //! Default constructor.
+    OcctThumbnailRenderer();
+
+    //! Destructor, stops worker threads.
+    ~OcctThumbnailRenderer();
+
+    //! Create the offscreen view on the graphic driver of the context.
+    void Init(const Handle(AIS_InteractiveContext)& theCtx,
+              const Handle(V3d_View)& theMainView,
+              Aspect_RenderingContext theGlContext);
+
+    //! Collect parts of the loaded assembly; instances sharing the same part shape are rendered once.
+    void SetAssembly(const OcctOutliner& theOutliner);
+
+    //! Return thumbnail size in pixels.
+    int Size() const { return mySize; }
+
+    //! Set thumbnail size in pixels, clamped to [16, 4096]; applied to the next batch.
+    void SetSize(int theSize) { mySize = std::min(std::max(theSize, 16), 4096); }
+
+    //! Start rendering of the assembly parts.
+    //! The output folder is created when missing; images are written as PNG when OCCT has an image library
+    //! (FreeImage or WIC), and as PPM otherwise, as Image_AlienPixMap falls back to PPM regardless of the file extension.
+    //! @param theOutDir [in] folder for image files; when empty, only parts missing in the cache are rendered
+    //! @return FALSE if the folder cannot be created or written to
+    bool Start(const TCollection_AsciiString& theOutDir);
+
+    //! Render thumbnails within the time budget; should be called from the GL thread.
+    void Step(const Handle(OpenGl_Context)& theGlCtx, double theBudgetMs);
+
+    //! Render all pending thumbnails and wait for the encoders.
+    void Finish(const Handle(OpenGl_Context)& theGlCtx);
+
+    //! Return true if some thumbnails are being rendered or encoded.
+    bool IsRunning() const { return myNextPart < (int)myAssembly.size() || myNbQueued > 0; }
+
+    //! Return the number of thumbnails per second of the last batch.
+    double ThumbnailsPerSecond() const;
+
+    //! Release GL textures and stop worker threads.
+    void Release(const Handle(OpenGl_Context)& theGlCtx);
+
+    //! Render the gallery panel.
+    void RenderGui(const Handle(OpenGl_Context)& theGlCtx);
+
+private:
+    //! Cached thumbnail.
+    struct Thumbnail
+    {
+        TCollection_AsciiString Name;
+        TopoDS_Shape            Shape;
+        Handle(OpenGl_Texture)  Texture;   //!< gallery texture, NULL until rendered
+        int                     Size;
+        bool                    IsTopDown;
+    };
+
+    //! Image waiting for encoding.
+    struct EncodeJob
+    {
+        Handle(Image_AlienPixMap) Image;
+        TCollection_AsciiString   Path;
+    };
+
+private:
+    //! Render one thumbnail and queue it for encoding.
+    void renderPart(const Handle(OpenGl_Context)& theGlCtx, int thePart);
+
+    //! Worker thread entry point.
+    void encodeLoop();
+
+    //! Start worker threads if not yet started.
+    void startWorkers();
+
+    //! Create the folder with missing parent folders; return false on failure.
+    static bool buildFolder(const TCollection_AsciiString& thePath);
+
+    //! Save a probe image into the folder and return the extension matching the written format, or empty string on failure.
+    static TCollection_AsciiString probeExtension(const TCollection_AsciiString& theOutDir);
+
+private:
+    Handle(AIS_InteractiveContext) myContext;       //!< private context of the thumbnail viewer
+    Handle(V3d_View)               myView;
+    Handle(Aspect_NeutralWindow)   myWindow;
+    std::vector<Thumbnail>         myParts;         //!< thumbnail cache
+    NCollection_DataMap<TopoDS_Shape, int, TopTools_ShapeMapHasher> myPartIndices;
+    std::vector<int>               myAssembly;      //!< cached parts of the loaded assembly
+    TCollection_AsciiString        myOutDir;
+    TCollection_AsciiString        myExtension;     //!< image file extension supported by Image_AlienPixMap
+    int                            myNextPart;      //!< next position within myAssembly to render
+    bool                           myToRenderAll;   //!< re-render cached parts as well
+    int                            mySize;          //!< thumbnail size in pixels
+    float                          myGallerySize;   //!< gallery tile size
+
+    std::vector<std::thread>       myWorkers;
+    std::deque<EncodeJob>          myQueue;         //!< images to encode, guarded by myMutex
+    mutable std::mutex             myMutex;
+    std::condition_variable        myQueueCond;     //!< signals new jobs or stop request to workers
+    std::condition_variable        myDoneCond;      //!< signals finished jobs to the renderer
+    bool                           myToStop;
+    std::atomic<int>               myNbQueued;      //!< queued or being encoded
+    std::atomic<int>               myNbWritten;
+    std::atomic<int>               myNbFailed;
+    int                            myNbRendered;
+    double                         myRenderMs;      //!< GL thread time of the batch
+    OSD_Timer                      myBatchTimer;    //!< wall clock since the batch start
+    double                         myBatchSeconds;  //!< time of the last finished thumbnail, guarded by myMutex
+    char                           myOutDirBuffer[512];
+};
+
+#endif // _OcctThumbnailRenderer_Header
@@ -0,0 +1,328 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "OcctViewSet.h"
+
+#include "imgui/imgui.h"
+
+#include <OSD_Timer.hxx>
+#include <V3d_Viewer.hxx>
+
+#include <algorithm>
+
+// ================================================================
+// Function : OcctViewSet
+// Purpose  :
+// ================================================================
+OcctViewSet::OcctViewSet()
+    : myToFinish(false)
+{
+}
+
+// ================================================================
+// Function : Init
+// Purpose  :
+// ================================================================
+void OcctViewSet::Init(const Handle(AIS_InteractiveContext)& theContext,
+                       const Handle(V3d_View)& theMainView,
+                       Aspect_RenderingContext theGlContext)
+{
+    myContext = theContext;
+
+    struct Preset { const char* Name; V3d_TypeOfOrientation Orientation; bool IsRotatable; };
+    const Preset aPresets[3] =
+    {
+        { "Front", V3d_Yneg,           false },
+        { "Top",   V3d_Zpos,           false },
+        { "Iso",   V3d_XposYnegZpos,   true  }
+    };
+    for (const Preset& aPreset : aPresets)
+    {
+        SubView aSub;
+        aSub.Name        = aPreset.Name;
+        aSub.Orientation = aPreset.Orientation;
+        aSub.IsRotatable = aPreset.IsRotatable;
+        aSub.Size.SetValues(256, 256);
+        aSub.ToFit       = true;
+        aSub.IsDragging  = false;
+        aSub.NbFrames    = 0;
+        aSub.LastMs      = 0.0;
+        aSub.AvgMs       = 0.0;
+
+        // the same native GL context is wrapped by each view, so GL resources are shared by the driver
+        aSub.Window = new Aspect_NeutralWindow();
+        aSub.Window->SetVirtual(Standard_True);
+        aSub.Window->SetNativeHandle(theMainView->Window()->NativeHandle());
+        aSub.Window->SetSize(aSub.Size.x(), aSub.Size.y());
+
+        aSub.View = theContext->CurrentViewer()->CreateView();
+        aSub.View->SetImmediateUpdate(Standard_False);
+        aSub.View->SetWindow(aSub.Window, theGlContext);
+        aSub.View->SetProj(aSub.Orientation, Standard_False);
+        aSub.View->Camera()->SetProjectionType(Graphic3d_Camera::Projection_Orthographic);
+        myViews.push_back(aSub);
+    }
+}
+
+// ================================================================
+// Function : Release
+// Purpose  :
+// ================================================================
+void OcctViewSet::Release(const Handle(OpenGl_Context)& theGlCtx)
+{
+    for (SubView& aSub : myViews)
+    {
+        if (!aSub.Fbo.IsNull())
+        {
+            aSub.Fbo->Release(theGlCtx.get());
+        }
+        aSub.View->Remove();
+    }
+    myViews.clear();
+}
+
+// ================================================================
+// Function : IsRedrawPending
+// Purpose  :
+// ================================================================
+bool OcctViewSet::IsRedrawPending() const
+{
+    for (const SubView& aSub : myViews)
+    {
+        if (aSub.ToFit
+         || aSub.View->Camera()->WorldViewProjState() != aSub.CameraState
+         || aSub.Fbo.IsNull()
+         || aSub.Fbo->GetVPSizeX() != aSub.Size.x()
+         || aSub.Fbo->GetVPSizeY() != aSub.Size.y())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ================================================================
+// Function : Redraw
+// Purpose  :
+// ================================================================
+void OcctViewSet::Redraw(const Handle(OpenGl_Context)& theGlCtx,
+                         bool theIsSceneChanged,
+                         bool theIsHiliteChanged)
+{
+    const Handle(OpenGl_FrameBuffer) aPrevFbo = theGlCtx->DefaultFrameBuffer();
+    for (SubView& aSub : myViews)
+    {
+        if (theIsSceneChanged)
+        {
+            aSub.View->Invalidate();
+        }
+        else if (theIsHiliteChanged)
+        {
+            aSub.View->InvalidateImmediate();
+        }
+        redrawView(theGlCtx, aSub);
+    }
+    theGlCtx->SetDefaultFrameBuffer(aPrevFbo);
+}
+
+// ================================================================
+// Function : redrawView
+// Purpose  :
+// ================================================================
+void OcctViewSet::redrawView(const Handle(OpenGl_Context)& theGlCtx, SubView& theView)
+{
+    if (theView.Fbo.IsNull())
+    {
+        theView.Fbo = new OpenGl_FrameBuffer();
+    }
+    if (theView.Fbo->GetVPSizeX() != theView.Size.x()
+     || theView.Fbo->GetVPSizeY() != theView.Size.y())
+    {
+        theView.Fbo->Init(theGlCtx, theView.Size, GL_RGBA8, GL_DEPTH24_STENCIL8);
+        theView.Window->SetSize(theView.Size.x(), theView.Size.y());
+        theView.View->MustBeResized();
+        theView.View->Invalidate();
+    }
+    if (theView.ToFit)
+    {
+        theView.ToFit = false;
+        theView.View->FitAll(0.01, Standard_False);
+    }
+    if (theView.View->Camera()->WorldViewProjState() != theView.CameraState)
+    {
+        theView.CameraState = theView.View->Camera()->WorldViewProjState();
+        theView.View->Invalidate();
+    }
+    if (!theView.View->IsInvalidated()
+     && !theView.View->IsInvalidatedImmediate())
+    {
+        return;
+    }
+
+    OSD_Timer aTimer;
+    aTimer.Start();
+    theGlCtx->SetDefaultFrameBuffer(theView.Fbo);
+    if (theView.View->IsInvalidated())
+    {
+        theView.View->Redraw();
+    }
+    else
+    {
+        theView.View->RedrawImmediate();
+    }
+    if (myToFinish)
+    {
+        theGlCtx->core11fwd->glFinish();
+    }
+    aTimer.Stop();
+
+    theView.LastMs = aTimer.ElapsedTime() * 1000.0;
+    theView.AvgMs  = theView.NbFrames == 0 ? theView.LastMs : theView.AvgMs * 0.9 + theView.LastMs * 0.1;
+    ++theView.NbFrames;
+}
+
+// ================================================================
+// Function : handleInput
+// Purpose  :
+// ================================================================
+void OcctViewSet::handleInput(SubView& theView, const Graphic3d_Vec2i& theMousePos)
+{
+    const ImGuiIO& aIO = ImGui::GetIO();
+    const float aRatio = aIO.DisplayFramebufferScale.x;
+    if (ImGui::IsItemHovered())
+    {
+        if (aIO.MouseWheel != 0.0f)
+        {
+            theView.View->SetZoom(aIO.MouseWheel > 0.0f ? 1.1 : 1.0 / 1.1);
+        }
+        if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+        {
+            theView.ToFit = true;
+        }
+    }
+
+    if (!ImGui::IsItemActive())
+    {
+        theView.IsDragging = false;
+        return;
+    }
+
+    // orthographic views are only panned, the iso view is rotated by the left button
+    if (theView.IsRotatable
+     && ImGui::IsMouseDown(ImGuiMouseButton_Left))
+    {
+        if (!theView.IsDragging)
+        {
+            theView.View->StartRotation(theMousePos.x(), theMousePos.y());
+            theView.IsDragging = true;
+        }
+        else
+        {
+            theView.View->Rotation(theMousePos.x(), theMousePos.y());
+        }
+    }
+    else if (aIO.MouseDelta.x != 0.0f
+          || aIO.MouseDelta.y != 0.0f)
+    {
+        theView.View->Pan(int(aIO.MouseDelta.x * aRatio), -int(aIO.MouseDelta.y * aRatio), 1.0, Standard_True);
+    }
+}
+
+// ================================================================
+// Function : RenderGui
+// Purpose  :
+// ================================================================
+void OcctViewSet::RenderGui()
+{
+    const float aRatio = ImGui::GetIO().DisplayFramebufferScale.x;
+    for (SubView& aSub : myViews)
+    {
+        ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0.0f, 0.0f));
+        ImGui::SetNextWindowSize(ImVec2(256.0f, 256.0f), ImGuiCond_FirstUseEver);
+        const bool isVisible = ImGui::Begin(aSub.Name);
+        ImGui::PopStyleVar();
+        if (!isVisible)
+        {
+            ImGui::End();
+            continue;
+        }
+
+        const ImVec2 aSize(std::max(ImGui::GetContentRegionAvail().x, 1.0f), std::max(ImGui::GetContentRegionAvail().y, 1.0f));
+        const ImVec2 anOrigin = ImGui::GetCursorScreenPos();
+        aSub.Size.SetValues(std::max(int(aSize.x * aRatio), 1), std::max(int(aSize.y * aRatio), 1));
+
+        ImGui::InvisibleButton("##view", aSize, ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonRight | ImGuiButtonFlags_MouseButtonMiddle);
+        const ImVec2 aMouse = ImGui::GetIO().MousePos;
+        handleInput(aSub, Graphic3d_Vec2i(int((aMouse.x - anOrigin.x) * aRatio), int((aMouse.y - anOrigin.y) * aRatio)));
+
+        if (!aSub.Fbo.IsNull()
+          && aSub.Fbo->ColorTexture()->IsValid())
+        {
+            // FBO rows go bottom-up
+            ImGui::GetWindowDrawList()->AddImage((ImTextureID)(intptr_t)aSub.Fbo->ColorTexture()->TextureId(),
+                                                 anOrigin, ImVec2(anOrigin.x + aSize.x, anOrigin.y + aSize.y),
+                                                 ImVec2(0.0f, 1.0f), ImVec2(1.0f, 0.0f));
+        }
+        ImGui::End();
+    }
+
+    ImGui::Begin("Views");
+    ImGui::Checkbox("Wait for GPU (glFinish)", &myToFinish);
+    ImGui::SameLine();
+    if (ImGui::Button("Fit all"))
+    {
+        for (SubView& aSub : myViews)
+        {
+            aSub.ToFit = true;
+        }
+    }
+    if (ImGui::BeginTable("##views", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+    {
+        ImGui::TableSetupColumn("View");
+        ImGui::TableSetupColumn("Size");
+        ImGui::TableSetupColumn("Frames");
+        ImGui::TableSetupColumn("Last, ms");
+        ImGui::TableSetupColumn("Avg, ms");
+        ImGui::TableHeadersRow();
+        for (const SubView& aSub : myViews)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(aSub.Name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%dx%d", aSub.Size.x(), aSub.Size.y());
+            ImGui::TableNextColumn();
+            ImGui::Text("%d", aSub.NbFrames);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", aSub.LastMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", aSub.AvgMs);
+        }
+        ImGui::EndTable();
+    }
+    if (!myToFinish)
+    {
+        ImGui::TextDisabled("Frame cost is CPU submission time only.");
+    }
+    ImGui::End();
+}
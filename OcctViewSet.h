@@ -0,0 +1,101 @@
+// MIT License
+// 
+// Copyright(c) 2023 Shing Liu
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _OcctViewSet_Header
+#define _OcctViewSet_Header
+
+#include <AIS_InteractiveContext.hxx>
+#include <Aspect_NeutralWindow.hxx>
+#include <OpenGl_Context.hxx>
+#include <OpenGl_FrameBuffer.hxx>
+#include <V3d_View.hxx>
+
+#include <vector>
+
+//! Set of secondary views (front, top, iso) sharing the viewer, interactive context and GL context of the main view.
+//! Each view has its own virtual window and offscreen FBO shown in a dockable ImGui window,
+//! while presentations and their vertex buffers are shared through the single OpenGl_GraphicDriver.
+//! A view is redrawn only when its own camera or the shared scene changes.
+class OcctViewSet
+{
+public:
+    //! Default constructor.
+    OcctViewSet();
+
+    //! Create the views on the viewer of the main view.
+    void Init(const Handle(AIS_InteractiveContext)& theContext,
+              const Handle(V3d_View)& theMainView,
+              Aspect_RenderingContext theGlContext);
+
+    //! Remove the views and release their FBOs.
+    void Release(const Handle(OpenGl_Context)& theGlCtx);
+
+    //! Return true if some view should be redrawn without new input.
+    bool IsRedrawPending() const;
+
+    //! Redraw the views that are dirty.
+    //! Should be called before the main view redraw, as AIS_ViewController redraws all invalidated views of the viewer
+    //! into the current default FBO.
+    //! @param theGlCtx            [in] shared GL context
+    //! @param theIsSceneChanged   [in] presentations have been modified
+    //! @param theIsHiliteChanged  [in] dynamic highlighting has been modified
+    void Redraw(const Handle(OpenGl_Context)& theGlCtx,
+                bool theIsSceneChanged,
+                bool theIsHiliteChanged);
+
+    //! Render one window per view and the frame cost table.
+    void RenderGui();
+
+private:
+
+    //! Secondary view with its offscreen target.
+    struct SubView
+    {
+        const char*                  Name;
+        V3d_TypeOfOrientation        Orientation;
+        bool                         IsRotatable;    //!< rotation is allowed by mouse
+        Handle(V3d_View)             View;
+        Handle(Aspect_NeutralWindow) Window;
+        Handle(OpenGl_FrameBuffer)   Fbo;
+        Graphic3d_WorldViewProjState CameraState;    //!< camera state of the last redraw
+        Graphic3d_Vec2i              Size;           //!< image size requested by GUI
+        bool                         ToFit;
+        bool                         IsDragging;
+        int                          NbFrames;
+        double                       LastMs;
+        double                       AvgMs;
+    };
+
+    //! Redraw one view into its FBO.
+    void redrawView(const Handle(OpenGl_Context)& theGlCtx, SubView& theView);
+
+    //! Handle mouse input over the view image, which should be the last ImGui item.
+    void handleInput(SubView& theView, const Graphic3d_Vec2i& theMousePos);
+
+private:
+    Handle(AIS_InteractiveContext) myContext;
+    std::vector<SubView>           myViews;
+    bool                           myToFinish;  //!< call glFinish() so that frame cost includes GPU time
+};
+
+#endif // _OcctViewSet_Header
@@ -2966,6 +2966,7 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
     ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory, allow support for point/nearest filtering). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_PackBestFit        = 1 << 3,   // Pack glyphs of all fonts together with the best-fit skyline heuristic and pick the texture width giving the smallest texture (when TexDesiredWidth is 0). Slower to build, tighter for large glyph ranges (e.g. CJK).
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -2434,6 +2434,42 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
+// Return the height needed to pack the custom rectangles then the glyph rectangles with the best-fit skyline heuristic into a texture of given width, or 0 if they don't fit.
+// Used by ImFontAtlasFlags_PackBestFit to compare texture widths, the actual packing is done afterwards with the selected one.
+static int ImFontAtlasBuildPackBestFitHeight(ImFontAtlas* atlas, const stbrp_rect* glyph_rects, int glyph_count, int tex_width, int tex_height_max)
+{
+    // Same target as setup by stbtt_PackBegin()
+    const int padding = atlas->TexGlyphPadding;
+    ImVector<stbrp_node> nodes;
+    nodes.resize(tex_width - padding);
+    stbrp_context pack_context;
+    stbrp_init_target(&pack_context, tex_width - padding, tex_height_max - padding, nodes.Data, nodes.Size);
+    stbrp_setup_heuristic(&pack_context, STBRP_HEURISTIC_Skyline_BF_sortHeight);
+
+    const int custom_count = atlas->CustomRects.Size;
+    ImVector<stbrp_rect> rects;
+    rects.resize(custom_count + glyph_count, stbrp_rect());
+    for (int i = 0; i < custom_count; i++)
+    {
+        rects[i].w = atlas->CustomRects[i].Width;
+        rects[i].h = atlas->CustomRects[i].Height;
+    }
+    for (int i = 0; i < glyph_count; i++)
+    {
+        rects[custom_count + i].w = glyph_rects[i].w;
+        rects[custom_count + i].h = glyph_rects[i].h;
+    }
+    const int custom_packed = stbrp_pack_rects(&pack_context, rects.Data, custom_count);
+    const int glyphs_packed = stbrp_pack_rects(&pack_context, rects.Data + custom_count, glyph_count);
+    if (!custom_packed || !glyphs_packed)
+        return 0;
+
+    int tex_height = 0;
+    for (int i = 0; i < rects.Size; i++)
+        tex_height = ImMax(tex_height, rects[i].y + rects[i].h);
+    return tex_height;
+}
+
 static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -2584,28 +2620,58 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     // We need a width for the skyline algorithm, any width!
     // The exact width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
     // User can override TexDesiredWidth and TexGlyphPadding if they wish, otherwise we use a simple heuristic to select the width based on expected surface.
+    // With ImFontAtlasFlags_PackBestFit, every width the heuristic may select is tried and the one giving a strictly smaller final texture is kept.
+    // (Rounding the height to a power of two quantizes the area, so that best-fit gains mostly show with ImFontAtlasFlags_NoPowerOfTwoHeight)
+    const int TEX_HEIGHT_MAX = 1024 * 32;
+    const bool pack_best_fit = (atlas->Flags & ImFontAtlasFlags_PackBestFit) != 0;
     const int surface_sqrt = (int)ImSqrt((float)total_surface) + 1;
     atlas->TexHeight = 0;
     if (atlas->TexDesiredWidth > 0)
         atlas->TexWidth = atlas->TexDesiredWidth;
     else
         atlas->TexWidth = (surface_sqrt >= 4096 * 0.7f) ? 4096 : (surface_sqrt >= 2048 * 0.7f) ? 2048 : (surface_sqrt >= 1024 * 0.7f) ? 1024 : 512;
+    if (pack_best_fit && atlas->TexDesiredWidth <= 0)
+    {
+        const int default_width = atlas->TexWidth;
+        int best_area = 0;
+        for (int n = -1; n < 4; n++)
+        {
+            // Start with the default width, so that another one (512 to 4096) is only selected when strictly better
+            const int tex_width = (n < 0) ? default_width : (512 << n);
+            if (n >= 0 && tex_width == default_width)
+                continue;
+            int tex_height = ImFontAtlasBuildPackBestFitHeight(atlas, buf_rects.Data, buf_rects.Size, tex_width, TEX_HEIGHT_MAX);
+            if (tex_height == 0)
+                continue;
+            tex_height = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (tex_height + 1) : ImUpperPowerOfTwo(tex_height);
+            if (best_area == 0 || tex_width * tex_height < best_area)
+            {
+                best_area = tex_width * tex_height;
+                atlas->TexWidth = tex_width;
+            }
+        }
+    }
 
     // 5. Start packing
     // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
-    const int TEX_HEIGHT_MAX = 1024 * 32;
     stbtt_pack_context spc = {};
     stbtt_PackBegin(&spc, NULL, atlas->TexWidth, TEX_HEIGHT_MAX, 0, atlas->TexGlyphPadding, NULL);
+    if (pack_best_fit)
+        stbrp_setup_heuristic((stbrp_context*)spc.pack_info, STBRP_HEURISTIC_Skyline_BF_sortHeight);
     ImFontAtlasBuildPackCustomRects(atlas, spc.pack_info);
 
     // 6. Pack each source font. No rendering yet, we are working with rectangles in an infinitely tall texture at this point.
+    // With ImFontAtlasFlags_PackBestFit, glyphs of all sources are packed at once, so that they are sorted by height together (e.g. a CJK range merged into a latin font).
+    if (pack_best_fit)
+        stbrp_pack_rects((stbrp_context*)spc.pack_info, buf_rects.Data, buf_rects.Size);
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
         if (src_tmp.GlyphsCount == 0)
             continue;
 
-        stbrp_pack_rects((stbrp_context*)spc.pack_info, src_tmp.Rects, src_tmp.GlyphsCount);
+        if (!pack_best_fit)
+            stbrp_pack_rects((stbrp_context*)spc.pack_info, src_tmp.Rects, src_tmp.GlyphsCount);
 
         // Extend texture height and mark missing glyphs as non-packed so we won't render them.
         // FIXME: We are not handling packing failure here (would happen if we got off TEX_HEIGHT_MAX or if a single if larger than TexWidth?)
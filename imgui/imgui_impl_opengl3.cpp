@@ -20,6 +20,11 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2023-07-31: OpenGL: Added ImGui_ImplOpenGL3_SetProgramBinaryCache() to store the linked shader program on disk with glGetProgramBinary() and load it back with glProgramBinary() (GL 4.1+ / GL_ARB_get_program_binary / ES 3.0+).
+//  2023-07-24: OpenGL: Upload the font atlas as single channel GL_R8 expanded by texture swizzle on GL 3.3+ / ES 3.0+ (4x less memory than RGBA32). Added ImGui_ImplOpenGL3_SetFontTextureSingleChannel() and ImGui_ImplOpenGL3_GetFontTextureInfo().
+//  2023-07-17: OpenGL: Merging adjacent draw commands with the same texture and clipping rectangle into glMultiDrawElementsBaseVertex() calls when all draw lists are streamed at once. Added ImGui_ImplOpenGL3_SetDrawBatching().
+//  2023-07-10: OpenGL: Added ImGui_ImplOpenGL3_SetSharedContext() to skip GL state backup/restore and keep the VAO when the application manages the state of a shared context. Skipping redundant texture/scissor changes between commands.
+//  2023-07-03: OpenGL: Stream all draw lists at once into a persistent mapped ring buffer with fences (GL 4.4 / GL_ARB_buffer_storage) or an orphaned mapped buffer (GL 3.2). Added ImGui_ImplOpenGL3_SetUploadPath() and ImGui_ImplOpenGL3_GetUploadStats().
 //  2023-XX-XX: Platform: Added support for multiple windows via the ImGuiPlatformIO interface.
 //  2023-06-20: OpenGL: Fixed erroneous use glGetIntegerv(GL_CONTEXT_PROFILE_MASK) on contexts lower than 3.2. (#6539, #6333)
 //  2023-05-09: OpenGL: Support for glBindSampler() backup/restore on ES3. (#6375)
@@ -110,6 +115,7 @@
 #include "imgui_impl_opengl3.h"
 #include <stdio.h>
 #include <stdint.h>     // intptr_t
+#include <chrono>       // upload statistics
 #if defined(__APPLE__)
 #include <TargetConditionals.h>
 #endif
@@ -187,11 +193,29 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
 #endif
 
+// Desktop GL 3.3+ and GL ES 3.0+ have GL_R8 textures and GL_TEXTURE_SWIZZLE_x parameters, which WebGL doesn't have.
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(__EMSCRIPTEN__) && defined(GL_R8) && defined(GL_TEXTURE_SWIZZLE_A)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+#endif
+
+// Desktop GL 4.1+ (or GL_ARB_get_program_binary) and GL ES 3.0+ have glGetProgramBinary()/glProgramBinary(), which WebGL doesn't have.
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(__EMSCRIPTEN__) && defined(GL_PROGRAM_BINARY_LENGTH)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+#endif
+
 // Desktop GL 3.1+ has GL_PRIMITIVE_RESTART state
 #if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_VERSION_3_1)
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
 #endif
 
+// Desktop GL 3.2+ can write all draw lists into a single mapped buffer, GL 4.4+ or GL_ARB_buffer_storage into a persistent mapped one
+#if defined(IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET) && defined(GL_MAP_WRITE_BIT) && defined(GL_SYNC_GPU_COMMANDS_COMPLETE)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_STREAM_BUFFER
+#if defined(GL_MAP_PERSISTENT_BIT)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+#endif
+#endif
+
 // Desktop GL use extension detection
 #if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3)
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_EXTENSIONS
@@ -206,6 +230,9 @@
 #define GL_CALL(_CALL)      _CALL   // Call without error check
 #endif
 
+// Number of regions of the persistent ring buffer: the CPU writes one while the GPU may still read the two previous ones
+#define IMGUI_IMPL_OPENGL_STREAM_REGIONS 3
+
 // OpenGL Data
 struct ImGui_ImplOpenGL3_Data
 {
@@ -216,6 +243,10 @@ struct ImGui_ImplOpenGL3_Data
     bool            GlProfileIsCompat;
     GLint           GlProfileMask;
     GLuint          FontTexture;
+    int             FontTextureWidth;
+    int             FontTextureHeight;
+    int             FontTextureBytesPerPixel; // 1 for GL_R8, 4 for GL_RGBA
+    bool            UseFontTextureSingleChannel;
     GLuint          ShaderHandle;
     GLint           AttribLocationTex;       // Uniforms location
     GLint           AttribLocationProjMtx;
@@ -223,11 +254,42 @@ struct ImGui_ImplOpenGL3_Data
     GLuint          AttribLocationVtxUV;
     GLuint          AttribLocationVtxColor;
     unsigned int    VboHandle, ElementsHandle;
+    GLuint          VertexArrayObject;       // Kept for the main viewport of a shared context
+    GLuint          VertexArrayVboHandle;    // Buffers the kept VAO has been set up with
+    GLuint          VertexArrayElementsHandle;
+    GLuint          SharedVertexArrayObject; // Application VAO bound back after rendering into a shared context
+    bool            IsSharedContext;
     GLsizeiptr      VertexBufferSize;
     GLsizeiptr      IndexBufferSize;
     bool            HasClipOrigin;
+    bool            HasBufferStorage;        // GL 4.4 or GL_ARB_buffer_storage
+    bool            HasTextureSwizzle;       // GL 3.3 or GL ES 3.0
+    bool            HasProgramBinary;        // GL 4.1, GL_ARB_get_program_binary or GL ES 3.0, with at least one binary format
     bool            UseBufferSubData;
 
+    // Streaming of vertex/index data (see ImGui_ImplOpenGL3_UploadPath_)
+    ImGui_ImplOpenGL3_UploadPath UploadPath;
+    GLsizeiptr      StreamVtxRegionSize;     // Persistent ring: bytes per region, 0 when storage is not allocated yet
+    GLsizeiptr      StreamIdxRegionSize;
+    char*           StreamVtxMapped;         // Persistent ring: mapping of VboHandle, kept for the lifetime of the buffer
+    char*           StreamIdxMapped;
+    int             StreamRegion;            // Persistent ring: region written by the last render call
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAM_BUFFER
+    GLsync          StreamFences[IMGUI_IMPL_OPENGL_STREAM_REGIONS]; // Signaled once the GPU is done reading a region
+#endif
+    ImGui_ImplOpenGL3_UploadStats Stats;
+
+    // Program binary cache (see ImGui_ImplOpenGL3_SetProgramBinaryCache())
+    ImVector<char>  ProgramCacheFolder;      // Zero-terminated, empty when disabled
+    bool            IsProgramFromCache;
+    double          ProgramSeconds;          // CPU time spent creating the shader program
+
+    // Batching of adjacent draw commands sharing texture and scissor rectangle
+    bool            UseDrawBatching;
+    ImVector<GLsizei>     BatchCounts;
+    ImVector<const void*> BatchOffsets;
+    ImVector<GLint>       BatchBaseVertices;
+
     ImGui_ImplOpenGL3_Data() { memset((void*)this, 0, sizeof(*this)); }
 };
 
@@ -368,8 +430,39 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
         const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
         if (extension != nullptr && strcmp(extension, "GL_ARB_clip_control") == 0)
             bd->HasClipOrigin = true;
+        if (extension != nullptr && strcmp(extension, "GL_ARB_buffer_storage") == 0)
+            bd->HasBufferStorage = true;
+        if (extension != nullptr && strcmp(extension, "GL_ARB_get_program_binary") == 0)
+            bd->HasProgramBinary = true;
+    }
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (bd->GlVersion >= 440)
+        bd->HasBufferStorage = true;
+#else
+    bd->HasBufferStorage = false;
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+    bd->HasTextureSwizzle = (bd->GlVersion >= 330 || bd->GlProfileIsES3);
+#else
+    bd->HasTextureSwizzle = false;
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+    // Drivers may expose the entry points without supporting any binary format
+    if (bd->GlVersion >= 410 || bd->GlProfileIsES3)
+        bd->HasProgramBinary = true;
+    if (bd->HasProgramBinary)
+    {
+        GLint num_binary_formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_binary_formats);
+        bd->HasProgramBinary = num_binary_formats > 0;
     }
+#else
+    bd->HasProgramBinary = false;
 #endif
+    bd->UploadPath = ImGui_ImplOpenGL3_GetBestUploadPath();
+    bd->UseDrawBatching = true;
+    bd->UseFontTextureSingleChannel = true;
 
     if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
         ImGui_ImplOpenGL3_InitPlatformInterface();
@@ -400,6 +493,304 @@ void    ImGui_ImplOpenGL3_NewFrame()
         ImGui_ImplOpenGL3_CreateDeviceObjects();
 }
 
+ImGui_ImplOpenGL3_UploadPath ImGui_ImplOpenGL3_GetBestUploadPath()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAM_BUFFER
+    if (bd->HasBufferStorage && bd->GlVersion >= 320)
+        return ImGui_ImplOpenGL3_UploadPath_Persistent;
+    if (bd->GlVersion >= 320)
+        return ImGui_ImplOpenGL3_UploadPath_Orphaning;
+#endif
+    (void)bd;
+    return ImGui_ImplOpenGL3_UploadPath_BufferData;
+}
+
+ImGui_ImplOpenGL3_UploadPath ImGui_ImplOpenGL3_GetUploadPath()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+    return bd->UploadPath;
+}
+
+// Release streaming buffers and their fences. Deleted buffers are kept alive by the driver until pending draws are done.
+static void ImGui_ImplOpenGL3_DestroyStreamBuffers()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAM_BUFFER
+    for (int n = 0; n < IMGUI_IMPL_OPENGL_STREAM_REGIONS; n++)
+        if (bd->StreamFences[n]) { glDeleteSync(bd->StreamFences[n]); bd->StreamFences[n] = nullptr; }
+#endif
+    if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
+    if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
+    bd->StreamVtxRegionSize = bd->StreamIdxRegionSize = 0;
+    bd->StreamVtxMapped = bd->StreamIdxMapped = nullptr;
+    bd->StreamRegion = 0;
+}
+
+ImGui_ImplOpenGL3_UploadPath ImGui_ImplOpenGL3_SetUploadPath(ImGui_ImplOpenGL3_UploadPath path)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+    const ImGui_ImplOpenGL3_UploadPath best_path = ImGui_ImplOpenGL3_GetBestUploadPath();
+    if (path > best_path)
+        path = best_path;
+    if (path == bd->UploadPath)
+        return path;
+
+    // Buffers with immutable storage cannot be respecified by glBufferData(), so start over with new buffer objects
+    if (bd->VboHandle != 0)
+    {
+        ImGui_ImplOpenGL3_DestroyStreamBuffers();
+        glGenBuffers(1, &bd->VboHandle);
+        glGenBuffers(1, &bd->ElementsHandle);
+    }
+    bd->UploadPath = path;
+    return path;
+}
+
+void ImGui_ImplOpenGL3_SetSharedContext(bool shared)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+    bd->IsSharedContext = shared;
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+    if (shared)
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&bd->SharedVertexArrayObject);
+#endif
+}
+
+bool ImGui_ImplOpenGL3_IsSharedContext()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+    return bd->IsSharedContext;
+}
+
+void ImGui_ImplOpenGL3_SetDrawBatching(bool enabled)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+    bd->UseDrawBatching = enabled;
+}
+
+bool ImGui_ImplOpenGL3_GetDrawBatching()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+    return bd->UseDrawBatching;
+}
+
+void ImGui_ImplOpenGL3_SetFontTextureSingleChannel(bool enabled)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+    if (bd->UseFontTextureSingleChannel == enabled)
+        return;
+    bd->UseFontTextureSingleChannel = enabled;
+    if (bd->FontTexture)
+    {
+        ImGui_ImplOpenGL3_DestroyFontsTexture();
+        ImGui_ImplOpenGL3_CreateFontsTexture();
+    }
+}
+
+bool ImGui_ImplOpenGL3_GetFontTextureInfo(ImGui_ImplOpenGL3_FontTextureInfo* out_info)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+    out_info->Width = bd->FontTextureWidth;
+    out_info->Height = bd->FontTextureHeight;
+    out_info->BytesPerPixel = bd->FontTextureBytesPerPixel;
+    out_info->Bytes = (size_t)bd->FontTextureWidth * bd->FontTextureHeight * bd->FontTextureBytesPerPixel;
+    out_info->IsSingleChannel = (bd->FontTextureBytesPerPixel == 1);
+    return bd->FontTexture != 0;
+}
+
+void ImGui_ImplOpenGL3_SetProgramBinaryCache(const char* folder)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+    bd->ProgramCacheFolder.clear();
+    if (folder != nullptr && folder[0] != 0)
+    {
+        bd->ProgramCacheFolder.resize((int)strlen(folder) + 1);
+        memcpy(bd->ProgramCacheFolder.Data, folder, (size_t)bd->ProgramCacheFolder.Size);
+    }
+}
+
+double ImGui_ImplOpenGL3_GetProgramBuildTime(bool* out_from_cache)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+    if (out_from_cache != nullptr)
+        *out_from_cache = bd->IsProgramFromCache;
+    return bd->ProgramSeconds;
+}
+
+void ImGui_ImplOpenGL3_GetUploadStats(ImGui_ImplOpenGL3_UploadStats* out_stats, bool reset)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Did you call ImGui_ImplOpenGL3_Init()?");
+    if (out_stats != nullptr)
+        *out_stats = bd->Stats;
+    if (reset)
+        memset((void*)&bd->Stats, 0, sizeof(bd->Stats));
+}
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAM_BUFFER
+// Allocate immutable storage for all ring regions and map it once for the lifetime of the buffer.
+// Coherent mapping makes CPU writes visible to the next draw call without explicit flushes.
+static char* ImGui_ImplOpenGL3_CreatePersistentRing(GLuint buffer, GLsizeiptr region_size)
+{
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    // Bind to GL_ARRAY_BUFFER also for indices: binding GL_ELEMENT_ARRAY_BUFFER would modify the currently bound VAO
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, buffer));
+    GL_CALL(glBufferStorage(GL_ARRAY_BUFFER, region_size * IMGUI_IMPL_OPENGL_STREAM_REGIONS, nullptr, flags));
+    return (char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, region_size * IMGUI_IMPL_OPENGL_STREAM_REGIONS, flags);
+#else
+    (void)buffer; (void)region_size;
+    return nullptr;
+#endif
+}
+
+// Write vertex/index data of all draw lists into the next region of the persistent ring.
+// Returns false if the ring could not be mapped, the caller then falls back to orphaning.
+static bool ImGui_ImplOpenGL3_StreamPersistent(ImDrawData* draw_data, GLsizeiptr vtx_size, GLsizeiptr idx_size, GLint* out_vtx_base, GLsizeiptr* out_idx_base)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+
+    // (Re)create the ring with some headroom when the frame does not fit a region
+    if (vtx_size > bd->StreamVtxRegionSize || idx_size > bd->StreamIdxRegionSize || bd->StreamVtxMapped == nullptr)
+    {
+        GLsizeiptr vtx_region_size = vtx_size + vtx_size / 2;
+        GLsizeiptr idx_region_size = idx_size + idx_size / 2;
+        if (vtx_region_size < bd->StreamVtxRegionSize) vtx_region_size = bd->StreamVtxRegionSize;
+        if (idx_region_size < bd->StreamIdxRegionSize) idx_region_size = bd->StreamIdxRegionSize;
+        if (vtx_region_size < (GLsizeiptr)(16384 * sizeof(ImDrawVert))) vtx_region_size = (GLsizeiptr)(16384 * sizeof(ImDrawVert));
+        if (idx_region_size < (GLsizeiptr)(32768 * sizeof(ImDrawIdx))) idx_region_size = (GLsizeiptr)(32768 * sizeof(ImDrawIdx));
+        vtx_region_size = (vtx_region_size + (GLsizeiptr)sizeof(ImDrawVert) - 1) / (GLsizeiptr)sizeof(ImDrawVert) * (GLsizeiptr)sizeof(ImDrawVert); // Region starts must be whole vertices for base vertex offsets
+        idx_region_size = (idx_region_size + 3) & ~(GLsizeiptr)3;
+        ImGui_ImplOpenGL3_DestroyStreamBuffers();
+        glGenBuffers(1, &bd->VboHandle);
+        glGenBuffers(1, &bd->ElementsHandle);
+        bd->StreamVtxMapped = ImGui_ImplOpenGL3_CreatePersistentRing(bd->VboHandle, vtx_region_size);
+        bd->StreamIdxMapped = ImGui_ImplOpenGL3_CreatePersistentRing(bd->ElementsHandle, idx_region_size);
+        if (bd->StreamVtxMapped == nullptr || bd->StreamIdxMapped == nullptr)
+        {
+            ImGui_ImplOpenGL3_DestroyStreamBuffers();
+            glGenBuffers(1, &bd->VboHandle);
+            glGenBuffers(1, &bd->ElementsHandle);
+            return false;
+        }
+        bd->StreamVtxRegionSize = vtx_region_size;
+        bd->StreamIdxRegionSize = idx_region_size;
+        bd->Stats.BytesAllocated += (ImU64)(vtx_region_size + idx_region_size) * IMGUI_IMPL_OPENGL_STREAM_REGIONS;
+    }
+
+    // Wait until the GPU has consumed the region written IMGUI_IMPL_OPENGL_STREAM_REGIONS render calls ago
+    const int region = (bd->StreamRegion + 1) % IMGUI_IMPL_OPENGL_STREAM_REGIONS;
+    if (GLsync fence = bd->StreamFences[region])
+    {
+        if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+        {
+            bd->Stats.FenceStalls++;
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {}
+        }
+        glDeleteSync(fence);
+        bd->StreamFences[region] = nullptr;
+    }
+    bd->StreamRegion = region;
+
+    char* vtx_dst = bd->StreamVtxMapped + bd->StreamVtxRegionSize * region;
+    char* idx_dst = bd->StreamIdxMapped + bd->StreamIdxRegionSize * region;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        memcpy(vtx_dst, cmd_list->VtxBuffer.Data, (size_t)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+        memcpy(idx_dst, cmd_list->IdxBuffer.Data, (size_t)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+        vtx_dst += cmd_list->VtxBuffer.Size * sizeof(ImDrawVert);
+        idx_dst += cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+    }
+    *out_vtx_base = (GLint)(bd->StreamVtxRegionSize * region / (GLsizeiptr)sizeof(ImDrawVert));
+    *out_idx_base = bd->StreamIdxRegionSize * region;
+    return true;
+}
+
+// Orphan the previous storage and write all draw lists into the new one with a single unsynchronized mapping.
+static void ImGui_ImplOpenGL3_StreamOrphaning(ImDrawData* draw_data, GLuint buffer, GLsizeiptr size, bool is_index)
+{
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, buffer)); // See ImGui_ImplOpenGL3_CreatePersistentRing() regarding GL_ELEMENT_ARRAY_BUFFER
+    GL_CALL(glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW));
+    char* dst = (char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    GLintptr offset = 0;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        const void* src = is_index ? (const void*)cmd_list->IdxBuffer.Data : (const void*)cmd_list->VtxBuffer.Data;
+        const GLsizeiptr src_size = is_index ? (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx) : (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
+        if (dst != nullptr)
+            memcpy(dst + offset, src, (size_t)src_size);
+        else
+            GL_CALL(glBufferSubData(GL_ARRAY_BUFFER, offset, src_size, src)); // Mapping failed, still a single allocation
+        offset += src_size;
+    }
+    if (dst != nullptr)
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+}
+#endif // IMGUI_IMPL_OPENGL_MAY_HAVE_STREAM_BUFFER
+
+// Upload vertex/index data of all draw lists at once.
+// Returns false for ImGui_ImplOpenGL3_UploadPath_BufferData, the caller then uploads each draw list on its own.
+// On success, draw list N starts at vertex 'out_vtx_base + sum of previous VtxBuffer.Size' and index byte offset 'out_idx_base + ...'.
+static bool ImGui_ImplOpenGL3_StreamDrawData(ImDrawData* draw_data, GLint* out_vtx_base, GLsizeiptr* out_idx_base)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    *out_vtx_base = 0;
+    *out_idx_base = 0;
+    if (bd->UploadPath == ImGui_ImplOpenGL3_UploadPath_BufferData || draw_data->TotalVtxCount == 0)
+        return false;
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAM_BUFFER
+    const GLsizeiptr vtx_size = (GLsizeiptr)draw_data->TotalVtxCount * (int)sizeof(ImDrawVert);
+    const GLsizeiptr idx_size = (GLsizeiptr)draw_data->TotalIdxCount * (int)sizeof(ImDrawIdx);
+    if (bd->UploadPath == ImGui_ImplOpenGL3_UploadPath_Persistent && !ImGui_ImplOpenGL3_StreamPersistent(draw_data, vtx_size, idx_size, out_vtx_base, out_idx_base))
+        ImGui_ImplOpenGL3_SetUploadPath(ImGui_ImplOpenGL3_UploadPath_Orphaning);
+    if (bd->UploadPath == ImGui_ImplOpenGL3_UploadPath_Orphaning)
+    {
+        ImGui_ImplOpenGL3_StreamOrphaning(draw_data, bd->VboHandle, vtx_size, false);
+        ImGui_ImplOpenGL3_StreamOrphaning(draw_data, bd->ElementsHandle, idx_size, true);
+        bd->Stats.BytesAllocated += (ImU64)(vtx_size + idx_size);
+    }
+    bd->Stats.BytesUploaded += (ImU64)(vtx_size + idx_size);
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Submit the pending batch of draw commands, which share the bound texture and scissor rectangle.
+// Batches are only built over streamed draw data, so that all commands index into the same buffers (GL 3.2+).
+static void ImGui_ImplOpenGL3_FlushDrawBatch()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    if (bd->BatchCounts.Size == 0)
+        return;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAM_BUFFER
+    const GLenum idx_type = sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    if (bd->BatchCounts.Size == 1)
+        GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, bd->BatchCounts[0], idx_type, bd->BatchOffsets[0], bd->BatchBaseVertices[0]));
+    else
+        GL_CALL(glMultiDrawElementsBaseVertex(GL_TRIANGLES, bd->BatchCounts.Data, idx_type, bd->BatchOffsets.Data, (GLsizei)bd->BatchCounts.Size, bd->BatchBaseVertices.Data));
+    bd->Stats.DrawCalls++;
+#endif
+    bd->BatchCounts.resize(0);
+    bd->BatchOffsets.resize(0);
+    bd->BatchBaseVertices.resize(0);
+}
+
 static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
@@ -460,6 +851,17 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     (void)vertex_array_object;
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
     glBindVertexArray(vertex_array_object);
+
+    // The VAO kept for a shared context only needs a new setup when buffers were recreated
+    // (GL_ARRAY_BUFFER binding is not part of the VAO state, it is still needed by the per draw list upload)
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle));
+    if (vertex_array_object != 0 && vertex_array_object == bd->VertexArrayObject)
+    {
+        if (bd->VertexArrayVboHandle == bd->VboHandle && bd->VertexArrayElementsHandle == bd->ElementsHandle)
+            return;
+        bd->VertexArrayVboHandle = bd->VboHandle;
+        bd->VertexArrayElementsHandle = bd->ElementsHandle;
+    }
 #endif
 
     // Bind vertex/index buffers and setup attributes for ImDrawVert
@@ -473,6 +875,129 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col)));
 }
 
+// OpenGL state modified by RenderDrawData(), backed up and restored around it unless the context is shared (see ImGui_ImplOpenGL3_SetSharedContext())
+struct ImGui_ImplOpenGL3_StateBackup
+{
+    GLenum      ActiveTexture;
+    GLuint      Program;
+    GLuint      Texture;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+    GLuint      Sampler;
+#endif
+    GLuint      ArrayBuffer;
+#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+    // This is part of VAO on OpenGL 3.0+ and OpenGL ES 3.0+.
+    GLint       ElementArrayBuffer;
+    ImGui_ImplOpenGL3_VtxAttribState VtxAttribStatePos;
+    ImGui_ImplOpenGL3_VtxAttribState VtxAttribStateUV;
+    ImGui_ImplOpenGL3_VtxAttribState VtxAttribStateColor;
+#endif
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+    GLuint      VertexArrayObject;
+#endif
+#ifdef IMGUI_IMPL_HAS_POLYGON_MODE
+    GLint       PolygonMode[2];
+#endif
+    GLint       Viewport[4];
+    GLint       ScissorBox[4];
+    GLenum      BlendSrcRgb, BlendDstRgb, BlendSrcAlpha, BlendDstAlpha;
+    GLenum      BlendEquationRgb, BlendEquationAlpha;
+    GLboolean   EnableBlend, EnableCullFace, EnableDepthTest, EnableStencilTest, EnableScissorTest;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+    GLboolean   EnablePrimitiveRestart;
+#endif
+
+    // Also selects GL_TEXTURE0, as the texture binding is backed up for that unit
+    void Backup(ImGui_ImplOpenGL3_Data* bd)
+    {
+        glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&ActiveTexture);
+        glActiveTexture(GL_TEXTURE0);
+        glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&Program);
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&Texture);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+        if (bd->GlVersion >= 330 || bd->GlProfileIsES3) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&Sampler); } else { Sampler = 0; }
+#endif
+        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&ArrayBuffer);
+#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &ElementArrayBuffer);
+        VtxAttribStatePos.GetState(bd->AttribLocationVtxPos);
+        VtxAttribStateUV.GetState(bd->AttribLocationVtxUV);
+        VtxAttribStateColor.GetState(bd->AttribLocationVtxColor);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&VertexArrayObject);
+#endif
+#ifdef IMGUI_IMPL_HAS_POLYGON_MODE
+        glGetIntegerv(GL_POLYGON_MODE, PolygonMode);
+#endif
+        glGetIntegerv(GL_VIEWPORT, Viewport);
+        glGetIntegerv(GL_SCISSOR_BOX, ScissorBox);
+        glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&BlendSrcRgb);
+        glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&BlendDstRgb);
+        glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&BlendSrcAlpha);
+        glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&BlendDstAlpha);
+        glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&BlendEquationRgb);
+        glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&BlendEquationAlpha);
+        EnableBlend = glIsEnabled(GL_BLEND);
+        EnableCullFace = glIsEnabled(GL_CULL_FACE);
+        EnableDepthTest = glIsEnabled(GL_DEPTH_TEST);
+        EnableStencilTest = glIsEnabled(GL_STENCIL_TEST);
+        EnableScissorTest = glIsEnabled(GL_SCISSOR_TEST);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+        EnablePrimitiveRestart = (bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
+#endif
+    }
+
+    void Restore(ImGui_ImplOpenGL3_Data* bd)
+    {
+        // This "glIsProgram()" check is required because if the program is "pending deletion" at the time of binding backup, it will have been deleted by now and will cause an OpenGL error. See #6220.
+        if (Program == 0 || glIsProgram(Program)) glUseProgram(Program);
+        glBindTexture(GL_TEXTURE_2D, Texture);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+        if (bd->GlVersion >= 330 || bd->GlProfileIsES3)
+            glBindSampler(0, Sampler);
+#endif
+        glActiveTexture(ActiveTexture);
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        glBindVertexArray(VertexArrayObject);
+#endif
+        glBindBuffer(GL_ARRAY_BUFFER, ArrayBuffer);
+#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ElementArrayBuffer);
+        VtxAttribStatePos.SetState(bd->AttribLocationVtxPos);
+        VtxAttribStateUV.SetState(bd->AttribLocationVtxUV);
+        VtxAttribStateColor.SetState(bd->AttribLocationVtxColor);
+#endif
+        glBlendEquationSeparate(BlendEquationRgb, BlendEquationAlpha);
+        glBlendFuncSeparate(BlendSrcRgb, BlendDstRgb, BlendSrcAlpha, BlendDstAlpha);
+        if (EnableBlend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
+        if (EnableCullFace) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
+        if (EnableDepthTest) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
+        if (EnableStencilTest) glEnable(GL_STENCIL_TEST); else glDisable(GL_STENCIL_TEST);
+        if (EnableScissorTest) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+        if (bd->GlVersion >= 310) { if (EnablePrimitiveRestart) glEnable(GL_PRIMITIVE_RESTART); else glDisable(GL_PRIMITIVE_RESTART); }
+#endif
+
+#ifdef IMGUI_IMPL_HAS_POLYGON_MODE
+        // Desktop OpenGL 3.0 and OpenGL 3.1 had separate polygon draw modes for front-facing and back-facing faces of polygons
+        if (bd->GlVersion <= 310 || bd->GlProfileIsCompat)
+        {
+            glPolygonMode(GL_FRONT, (GLenum)PolygonMode[0]);
+            glPolygonMode(GL_BACK, (GLenum)PolygonMode[1]);
+        }
+        else
+        {
+            glPolygonMode(GL_FRONT_AND_BACK, (GLenum)PolygonMode[0]);
+        }
+#endif // IMGUI_IMPL_HAS_POLYGON_MODE
+
+        glViewport(Viewport[0], Viewport[1], (GLsizei)Viewport[2], (GLsizei)Viewport[3]);
+        glScissor(ScissorBox[0], ScissorBox[1], (GLsizei)ScissorBox[2], (GLsizei)ScissorBox[3]);
+        (void)bd; // Not all compilation paths use this
+    }
+};
+
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
@@ -485,52 +1010,40 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         return;
 
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    const std::chrono::steady_clock::time_point render_start = std::chrono::steady_clock::now();
+
+    // Backup GL state, unless the application handles it (see ImGui_ImplOpenGL3_SetSharedContext()).
+    // Secondary viewports have their own GL contexts, which are always backed up.
+    const bool is_shared_context = bd->IsSharedContext && (draw_data->OwnerViewport == nullptr || draw_data->OwnerViewport == ImGui::GetMainViewport());
+    ImGui_ImplOpenGL3_StateBackup last_state;
+    if (is_shared_context)
+        glActiveTexture(GL_TEXTURE0);
+    else
+        last_state.Backup(bd);
 
-    // Backup GL state
-    GLenum last_active_texture; glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
-    glActiveTexture(GL_TEXTURE0);
-    GLuint last_program; glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&last_program);
-    GLuint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&last_texture);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    GLuint last_sampler; if (bd->GlVersion >= 330 || bd->GlProfileIsES3) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&last_sampler); } else { last_sampler = 0; }
-#endif
-    GLuint last_array_buffer; glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer);
-#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    // This is part of VAO on OpenGL 3.0+ and OpenGL ES 3.0+.
-    GLint last_element_array_buffer; glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
-    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_pos; last_vtx_attrib_state_pos.GetState(bd->AttribLocationVtxPos);
-    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_uv; last_vtx_attrib_state_uv.GetState(bd->AttribLocationVtxUV);
-    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_color; last_vtx_attrib_state_color.GetState(bd->AttribLocationVtxColor);
-#endif
-#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GLuint last_vertex_array_object; glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&last_vertex_array_object);
-#endif
-#ifdef IMGUI_IMPL_HAS_POLYGON_MODE
-    GLint last_polygon_mode[2]; glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode);
-#endif
-    GLint last_viewport[4]; glGetIntegerv(GL_VIEWPORT, last_viewport);
-    GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
-    GLenum last_blend_src_rgb; glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
-    GLenum last_blend_dst_rgb; glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
-    GLenum last_blend_src_alpha; glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
-    GLenum last_blend_dst_alpha; glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
-    GLenum last_blend_equation_rgb; glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
-    GLenum last_blend_equation_alpha; glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
-    GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
-    GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
-    GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
-    GLboolean last_enable_stencil_test = glIsEnabled(GL_STENCIL_TEST);
-    GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    GLboolean last_enable_primitive_restart = (bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
-#endif
+    // Upload all draw lists at once when supported (may recreate VboHandle/ElementsHandle, so before binding them)
+    GLint stream_vtx_base = 0;
+    GLsizeiptr stream_idx_base = 0;
+    std::chrono::steady_clock::time_point upload_start = std::chrono::steady_clock::now();
+    const bool is_streamed = ImGui_ImplOpenGL3_StreamDrawData(draw_data, &stream_vtx_base, &stream_idx_base);
+    double upload_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - upload_start).count();
 
     // Setup desired GL state
     // Recreate the VAO every time (this is to easily allow multiple GL contexts to be rendered to. VAO are not shared among GL contexts)
     // The renderer would actually work without any VAO bound, but then our VertexAttrib calls would overwrite the default one currently bound.
+    // A shared context keeps one VAO along with its attribute setup, as the application binds its own VAO back in between.
     GLuint vertex_array_object = 0;
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GL_CALL(glGenVertexArrays(1, &vertex_array_object));
+    if (is_shared_context)
+    {
+        if (bd->VertexArrayObject == 0)
+            GL_CALL(glGenVertexArrays(1, &bd->VertexArrayObject));
+        vertex_array_object = bd->VertexArrayObject;
+    }
+    else
+    {
+        GL_CALL(glGenVertexArrays(1, &vertex_array_object));
+    }
 #endif
     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
 
@@ -538,10 +1051,20 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
+    // Skip redundant texture and scissor changes between commands.
+    // With streamed draw data, adjacent commands sharing them are also merged into a single draw call. Commands are never
+    // reordered: overlapping windows and widgets rely on the submission order for blending.
+    const bool use_batching = is_streamed && bd->UseDrawBatching;
+    GLuint bound_texture = (GLuint)-1;
+    GLint bound_scissor[4] = { -1, -1, -1, -1 };
+
     // Render command lists
+    GLint global_vtx_offset = stream_vtx_base;
+    GLsizeiptr global_idx_offset = stream_idx_base;
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        bd->Stats.DrawLists++;
 
         // Upload vertex/index buffers
         // - OpenGL drivers are in a very sorry state nowadays....
@@ -553,7 +1076,12 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         // - See https://github.com/ocornut/imgui/issues/4468 and please report any corruption issues.
         const GLsizeiptr vtx_buffer_size = (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
         const GLsizeiptr idx_buffer_size = (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
-        if (bd->UseBufferSubData)
+        upload_start = std::chrono::steady_clock::now();
+        if (is_streamed)
+        {
+            // Already written along with all other draw lists, see ImGui_ImplOpenGL3_StreamDrawData()
+        }
+        else if (bd->UseBufferSubData)
         {
             if (bd->VertexBufferSize < vtx_buffer_size)
             {
@@ -572,7 +1100,11 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         {
             GL_CALL(glBufferData(GL_ARRAY_BUFFER, vtx_buffer_size, (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW));
             GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx_buffer_size, (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW));
+            bd->Stats.BytesUploaded += (ImU64)(vtx_buffer_size + idx_buffer_size);
+            bd->Stats.BytesAllocated += (ImU64)(vtx_buffer_size + idx_buffer_size);
         }
+        if (!is_streamed)
+            upload_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - upload_start).count();
 
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
@@ -581,10 +1113,16 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
             {
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                ImGui_ImplOpenGL3_FlushDrawBatch();
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
+                    bd->VertexArrayVboHandle = 0; // Full reset, including the attribute setup of a kept VAO
                     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+                }
                 else
                     pcmd->UserCallback(cmd_list, pcmd);
+                bound_texture = (GLuint)-1;
+                bound_scissor[0] = -1;
             }
             else
             {
@@ -594,72 +1132,82 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
                     continue;
 
+                // Submit the pending batch before changing the scissor rectangle or texture
+                bd->Stats.DrawCommands++;
+                const GLint scissor[4] = { (int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y) };
+                const GLuint texture = (GLuint)(intptr_t)pcmd->GetTexID();
+                const bool is_scissor_changed = memcmp(scissor, bound_scissor, sizeof(scissor)) != 0;
+                if (is_scissor_changed || texture != bound_texture)
+                    ImGui_ImplOpenGL3_FlushDrawBatch();
+
                 // Apply scissor/clipping rectangle (Y is inverted in OpenGL)
-                GL_CALL(glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y)));
+                if (is_scissor_changed)
+                {
+                    GL_CALL(glScissor(scissor[0], scissor[1], scissor[2], scissor[3]));
+                    memcpy(bound_scissor, scissor, sizeof(scissor));
+                }
 
                 // Bind texture, Draw
-                GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID()));
+                if (texture != bound_texture)
+                {
+                    GL_CALL(glBindTexture(GL_TEXTURE_2D, texture));
+                    bound_texture = texture;
+                }
+                if (use_batching)
+                {
+                    bd->BatchCounts.push_back((GLsizei)pcmd->ElemCount);
+                    bd->BatchOffsets.push_back((const void*)(intptr_t)(global_idx_offset + pcmd->IdxOffset * sizeof(ImDrawIdx)));
+                    bd->BatchBaseVertices.push_back((GLint)(global_vtx_offset + pcmd->VtxOffset));
+                    continue;
+                }
+                bd->Stats.DrawCalls++;
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                 if (bd->GlVersion >= 320)
-                    GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset));
+                    GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(global_idx_offset + pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)(global_vtx_offset + pcmd->VtxOffset)));
                 else
 #endif
                 GL_CALL(glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx))));
             }
         }
+        if (is_streamed)
+        {
+            global_vtx_offset += cmd_list->VtxBuffer.Size;
+            global_idx_offset += (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
+        }
     }
 
+    ImGui_ImplOpenGL3_FlushDrawBatch();
+
+    // Mark the ring region as in use until the GPU has executed the draws above
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_STREAM_BUFFER
+    if (is_streamed && bd->UploadPath == ImGui_ImplOpenGL3_UploadPath_Persistent)
+        bd->StreamFences[bd->StreamRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#endif
+
     // Destroy the temporary VAO
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
+    if (!is_shared_context)
+        GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
 #endif
 
     // Restore modified GL state
-    // This "glIsProgram()" check is required because if the program is "pending deletion" at the time of binding backup, it will have been deleted by now and will cause an OpenGL error. See #6220.
-    if (last_program == 0 || glIsProgram(last_program)) glUseProgram(last_program);
-    glBindTexture(GL_TEXTURE_2D, last_texture);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    if (bd->GlVersion >= 330 || bd->GlProfileIsES3)
-        glBindSampler(0, last_sampler);
-#endif
-    glActiveTexture(last_active_texture);
+    if (is_shared_context)
+    {
+        // Leave the documented state of a shared context, see ImGui_ImplOpenGL3_SetSharedContext()
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glBindVertexArray(last_vertex_array_object);
-#endif
-    glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
-#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, last_element_array_buffer);
-    last_vtx_attrib_state_pos.SetState(bd->AttribLocationVtxPos);
-    last_vtx_attrib_state_uv.SetState(bd->AttribLocationVtxUV);
-    last_vtx_attrib_state_color.SetState(bd->AttribLocationVtxColor);
-#endif
-    glBlendEquationSeparate(last_blend_equation_rgb, last_blend_equation_alpha);
-    glBlendFuncSeparate(last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha);
-    if (last_enable_blend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
-    if (last_enable_cull_face) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
-    if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
-    if (last_enable_stencil_test) glEnable(GL_STENCIL_TEST); else glDisable(GL_STENCIL_TEST);
-    if (last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    if (bd->GlVersion >= 310) { if (last_enable_primitive_restart) glEnable(GL_PRIMITIVE_RESTART); else glDisable(GL_PRIMITIVE_RESTART); }
+        glBindVertexArray(bd->SharedVertexArrayObject);
 #endif
-
-#ifdef IMGUI_IMPL_HAS_POLYGON_MODE
-    // Desktop OpenGL 3.0 and OpenGL 3.1 had separate polygon draw modes for front-facing and back-facing faces of polygons
-    if (bd->GlVersion <= 310 || bd->GlProfileIsCompat)
-    {
-        glPolygonMode(GL_FRONT, (GLenum)last_polygon_mode[0]);
-        glPolygonMode(GL_BACK, (GLenum)last_polygon_mode[1]);
+        glDisable(GL_BLEND);
+        glDisable(GL_SCISSOR_TEST);
     }
     else
     {
-        glPolygonMode(GL_FRONT_AND_BACK, (GLenum)last_polygon_mode[0]);
+        last_state.Restore(bd);
     }
-#endif // IMGUI_IMPL_HAS_POLYGON_MODE
 
-    glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
-    glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
-    (void)bd; // Not all compilation paths use this
+    bd->Stats.RenderCalls++;
+    bd->Stats.UploadSeconds += upload_seconds;
+    bd->Stats.RenderSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - render_start).count();
 }
 
 bool ImGui_ImplOpenGL3_CreateFontsTexture()
@@ -668,9 +1216,18 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
 
     // Build texture atlas
+    // Load as single channel when texture swizzle can expand it to (1,1,1,A) for the unchanged shader, as most atlases only hold coverage.
+    // Otherwise load as RGBA 32-bit (75% of the memory is wasted) because it is more likely to be compatible with user's existing shaders.
     unsigned char* pixels;
     int width, height;
-    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // Load as RGBA 32-bit (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders. If your ImTextureId represent a higher-level concept than just a GL texture id, consider calling GetTexDataAsAlpha8() instead to save on GPU memory.
+    bool single_channel = false;
+    if (bd->HasTextureSwizzle && bd->UseFontTextureSingleChannel)
+    {
+        io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+        single_channel = !io.Fonts->TexPixelsUseColors;
+    }
+    if (!single_channel)
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
 
     // Upload texture to graphics system
     // (Bilinear sampling is required by default. Set 'io.Fonts->Flags |= ImFontAtlasFlags_NoBakedLines' or 'style.AntiAliasedLinesUseTex = false' to allow point/nearest sampling)
@@ -682,8 +1239,26 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
     GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
 #ifdef GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
     GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+    if (single_channel)
+    {
+        GLint last_unpack_alignment;
+        GL_CALL(glGetIntegerv(GL_UNPACK_ALIGNMENT, &last_unpack_alignment));
+        GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+        GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_ONE));
+        GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_ONE));
+        GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_ONE));
+        GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED));
+        GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, pixels));
+        GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, last_unpack_alignment));
+    }
+    else
 #endif
     GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+    bd->FontTextureWidth = width;
+    bd->FontTextureHeight = height;
+    bd->FontTextureBytesPerPixel = single_channel ? 1 : 4;
 
     // Store our identifier
     io.Fonts->SetTexID((ImTextureID)(intptr_t)bd->FontTexture);
@@ -744,6 +1319,107 @@ static bool CheckProgram(GLuint handle, const char* desc)
     return (GLboolean)status == GL_TRUE;
 }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+// Program binary cache file: header followed by the binary returned by glGetProgramBinary()
+struct ImGui_ImplOpenGL3_ProgramBinaryHeader
+{
+    char            Magic[4];                // "IGPB"
+    unsigned int    Format;
+    unsigned int    Length;
+};
+
+static ImU64 ImGui_ImplOpenGL3_HashString(ImU64 hash, const char* str)
+{
+    // FNV-1a, including the terminating zero as separator
+    if (str == nullptr)
+        str = "";
+    do
+    {
+        hash ^= (unsigned char)*str;
+        hash *= 0x100000001B3ULL;
+    } while (*str++ != 0);
+    return hash;
+}
+
+// Build the cache file path for the shader sources, keyed by the driver and the sources, as binaries are only valid for the same driver.
+static bool ImGui_ImplOpenGL3_GetProgramBinaryPath(const char* vertex_shader, const char* fragment_shader, char* out_path, size_t out_path_size)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    if (!bd->HasProgramBinary || bd->ProgramCacheFolder.empty())
+        return false;
+
+    ImU64 hash = 0xCBF29CE484222325ULL;
+    hash = ImGui_ImplOpenGL3_HashString(hash, (const char*)glGetString(GL_VENDOR));
+    hash = ImGui_ImplOpenGL3_HashString(hash, (const char*)glGetString(GL_RENDERER));
+    hash = ImGui_ImplOpenGL3_HashString(hash, (const char*)glGetString(GL_VERSION));
+    hash = ImGui_ImplOpenGL3_HashString(hash, bd->GlslVersionString);
+    hash = ImGui_ImplOpenGL3_HashString(hash, vertex_shader);
+    hash = ImGui_ImplOpenGL3_HashString(hash, fragment_shader);
+    const int len = snprintf(out_path, out_path_size, "%s/imgui_%08X%08X.bin", bd->ProgramCacheFolder.Data, (unsigned int)(hash >> 32), (unsigned int)hash);
+    return len > 0 && (size_t)len < out_path_size;
+}
+
+// Return the program loaded from the cache file, or 0 if there is no file or the driver rejects the binary (e.g. after a driver update).
+static GLuint ImGui_ImplOpenGL3_LoadProgramBinary(const char* path)
+{
+    FILE* f = fopen(path, "rb");
+    if (f == nullptr)
+        return 0;
+
+    ImGui_ImplOpenGL3_ProgramBinaryHeader header;
+    ImVector<char> binary;
+    bool is_read = fread(&header, sizeof(header), 1, f) == 1 && memcmp(header.Magic, "IGPB", 4) == 0 && header.Length > 0 && header.Length < (1u << 28);
+    if (is_read)
+    {
+        binary.resize((int)header.Length);
+        is_read = fread(binary.Data, 1, (size_t)header.Length, f) == (size_t)header.Length;
+    }
+    fclose(f);
+    if (!is_read)
+        return 0;
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, (GLenum)header.Format, binary.Data, (GLsizei)header.Length);
+    GLint status = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if ((GLboolean)status == GL_FALSE)
+    {
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+// Write the binary of the linked program into the cache file, failures only cost a compilation on next run.
+static void ImGui_ImplOpenGL3_SaveProgramBinary(GLuint program, const char* path)
+{
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    ImGui_ImplOpenGL3_ProgramBinaryHeader header;
+    memcpy(header.Magic, "IGPB", 4);
+    ImVector<char> binary;
+    binary.resize(length);
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.Data);
+    if (written <= 0)
+        return;
+    header.Format = (unsigned int)format;
+    header.Length = (unsigned int)written;
+
+    FILE* f = fopen(path, "wb");
+    if (f == nullptr)
+        return;
+    const bool is_written = fwrite(&header, sizeof(header), 1, f) == 1 && fwrite(binary.Data, 1, (size_t)written, f) == (size_t)written;
+    fclose(f);
+    if (!is_written)
+        remove(path);
+}
+#endif
+
 bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
@@ -885,30 +1561,56 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         fragment_shader = fragment_shader_glsl_130;
     }
 
-    // Create shaders
-    const GLchar* vertex_shader_with_version[2] = { bd->GlslVersionString, vertex_shader };
-    GLuint vert_handle = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vert_handle, 2, vertex_shader_with_version, nullptr);
-    glCompileShader(vert_handle);
-    CheckShader(vert_handle, "vertex shader");
+    // Load the program from the binary cache, if any
+    const auto program_start = std::chrono::steady_clock::now();
+    bd->IsProgramFromCache = false;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+    char cache_path[1024];
+    const bool use_cache = ImGui_ImplOpenGL3_GetProgramBinaryPath(vertex_shader, fragment_shader, cache_path, sizeof(cache_path));
+    if (use_cache)
+        bd->ShaderHandle = ImGui_ImplOpenGL3_LoadProgramBinary(cache_path);
+    bd->IsProgramFromCache = bd->ShaderHandle != 0;
+#endif
 
-    const GLchar* fragment_shader_with_version[2] = { bd->GlslVersionString, fragment_shader };
-    GLuint frag_handle = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(frag_handle, 2, fragment_shader_with_version, nullptr);
-    glCompileShader(frag_handle);
-    CheckShader(frag_handle, "fragment shader");
+    if (!bd->IsProgramFromCache)
+    {
+        // Create shaders
+        const GLchar* vertex_shader_with_version[2] = { bd->GlslVersionString, vertex_shader };
+        GLuint vert_handle = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(vert_handle, 2, vertex_shader_with_version, nullptr);
+        glCompileShader(vert_handle);
+        CheckShader(vert_handle, "vertex shader");
+
+        const GLchar* fragment_shader_with_version[2] = { bd->GlslVersionString, fragment_shader };
+        GLuint frag_handle = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(frag_handle, 2, fragment_shader_with_version, nullptr);
+        glCompileShader(frag_handle);
+        CheckShader(frag_handle, "fragment shader");
+
+        // Link
+        bd->ShaderHandle = glCreateProgram();
+        glAttachShader(bd->ShaderHandle, vert_handle);
+        glAttachShader(bd->ShaderHandle, frag_handle);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+        if (use_cache)
+            glProgramParameteri(bd->ShaderHandle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+        glLinkProgram(bd->ShaderHandle);
+        const bool is_linked = CheckProgram(bd->ShaderHandle, "shader program");
 
-    // Link
-    bd->ShaderHandle = glCreateProgram();
-    glAttachShader(bd->ShaderHandle, vert_handle);
-    glAttachShader(bd->ShaderHandle, frag_handle);
-    glLinkProgram(bd->ShaderHandle);
-    CheckProgram(bd->ShaderHandle, "shader program");
+        glDetachShader(bd->ShaderHandle, vert_handle);
+        glDetachShader(bd->ShaderHandle, frag_handle);
+        glDeleteShader(vert_handle);
+        glDeleteShader(frag_handle);
 
-    glDetachShader(bd->ShaderHandle, vert_handle);
-    glDetachShader(bd->ShaderHandle, frag_handle);
-    glDeleteShader(vert_handle);
-    glDeleteShader(frag_handle);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+        if (use_cache && is_linked)
+            ImGui_ImplOpenGL3_SaveProgramBinary(bd->ShaderHandle, cache_path);
+#else
+        IM_UNUSED(is_linked);
+#endif
+    }
+    bd->ProgramSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - program_start).count();
 
     bd->AttribLocationTex = glGetUniformLocation(bd->ShaderHandle, "Texture");
     bd->AttribLocationProjMtx = glGetUniformLocation(bd->ShaderHandle, "ProjMtx");
@@ -935,8 +1637,11 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
-    if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
-    if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
+    ImGui_ImplOpenGL3_DestroyStreamBuffers();
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+    if (bd->VertexArrayObject) { glDeleteVertexArrays(1, &bd->VertexArrayObject); bd->VertexArrayObject = 0; }
+#endif
+    bd->VertexArrayVboHandle = bd->VertexArrayElementsHandle = 0;
     if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
     ImGui_ImplOpenGL3_DestroyFontsTexture();
 }
@@ -39,6 +39,71 @@ IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyFontsTexture();
 IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_CreateDeviceObjects();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyDeviceObjects();
 
+// (Optional) Upload path of vertex/index data, the best supported one is selected by Init
+// - BufferData: one glBufferData() per draw list, reallocating driver storage each time (original path, any GL/ES version).
+// - Orphaning: one glBufferData(nullptr) + glMapBufferRange() per render call, all draw lists written into the mapping (GL 3.2+).
+// - Persistent: ring of 3 regions in a persistently mapped buffer guarded by fences, no allocation per frame (GL 4.4+ or GL_ARB_buffer_storage).
+typedef int ImGui_ImplOpenGL3_UploadPath;
+enum ImGui_ImplOpenGL3_UploadPath_
+{
+    ImGui_ImplOpenGL3_UploadPath_BufferData = 0,
+    ImGui_ImplOpenGL3_UploadPath_Orphaning  = 1,
+    ImGui_ImplOpenGL3_UploadPath_Persistent = 2,
+};
+
+// Counters accumulated by ImGui_ImplOpenGL3_RenderDrawData(), for comparing upload paths
+struct ImGui_ImplOpenGL3_UploadStats
+{
+    int         RenderCalls;        // Number of ImGui_ImplOpenGL3_RenderDrawData() calls (one per viewport and frame)
+    int         DrawLists;          // Number of uploaded ImDrawList
+    ImU64       BytesUploaded;      // Vertex and index bytes written for the GPU
+    ImU64       BytesAllocated;     // Buffer storage bytes (re)allocated by the driver
+    int         FenceStalls;        // Persistent path: number of times the CPU had to wait for the GPU to release a ring region
+    int         DrawCommands;       // Number of rendered ImDrawCmd, i.e. draw calls without batching
+    int         DrawCalls;          // Number of issued glDrawElements*() / glMultiDrawElementsBaseVertex() calls
+    double      UploadSeconds;      // CPU time spent writing vertex/index data
+    double      RenderSeconds;      // CPU time spent in ImGui_ImplOpenGL3_RenderDrawData() in total
+};
+
+IMGUI_IMPL_API ImGui_ImplOpenGL3_UploadPath ImGui_ImplOpenGL3_GetBestUploadPath();
+IMGUI_IMPL_API ImGui_ImplOpenGL3_UploadPath ImGui_ImplOpenGL3_GetUploadPath();
+IMGUI_IMPL_API ImGui_ImplOpenGL3_UploadPath ImGui_ImplOpenGL3_SetUploadPath(ImGui_ImplOpenGL3_UploadPath path); // Clamped to the best supported path, which is returned. Requires the GL context to be current.
+// (Optional) Shared GL context, for applications rendering with another engine into the same context and tracking GL state on their side.
+// When enabled, RenderDrawData() for the main viewport does not query and restore the ~25 pieces of GL state it modifies, and keeps its VAO
+// across frames. On return the VAO bound when calling SetSharedContext(true) is bound again and GL_BLEND, GL_SCISSOR_TEST are disabled;
+// the ImGui program, texture unit 0, GL_ARRAY_BUFFER, viewport, blend function, polygon mode and cull/depth/stencil tests are left as ImGui set them.
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetSharedContext(bool shared);
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_IsSharedContext();
+
+// (Optional) Merge adjacent draw commands with the same texture and clipping rectangle into one glMultiDrawElementsBaseVertex() call.
+// Enabled by default, only effective with the Orphaning and Persistent upload paths where all draw lists share the same buffers.
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetDrawBatching(bool enabled);
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_GetDrawBatching();
+
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_GetUploadStats(ImGui_ImplOpenGL3_UploadStats* out_stats, bool reset = false);
+
+// (Optional) Font atlas texture format. By default the atlas is uploaded as single channel GL_R8 expanded to (1,1,1,A) by texture swizzle
+// when supported (GL 3.3+, GL ES 3.0+) and when the atlas has no colored glyphs (ImFontAtlas::TexPixelsUseColors), otherwise as GL_RGBA.
+// Changing the format recreates the font texture, which requires the GL context to be current.
+struct ImGui_ImplOpenGL3_FontTextureInfo
+{
+    int         Width;
+    int         Height;
+    int         BytesPerPixel;
+    size_t      Bytes;              // GPU memory of the texture, without mipmaps (none are created)
+    bool        IsSingleChannel;
+};
+
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetFontTextureSingleChannel(bool enabled);
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_GetFontTextureInfo(ImGui_ImplOpenGL3_FontTextureInfo* out_info); // Return false if the font texture is not created yet.
+
+// (Optional) Program binary cache. When a folder is set (after Init() and before the first NewFrame()), the linked shader program is saved there
+// with glGetProgramBinary() and loaded back with glProgramBinary() on next runs (GL 4.1+, GL_ARB_get_program_binary or GL ES 3.0+).
+// Files are keyed by a hash of GL_VENDOR, GL_RENDERER, GL_VERSION and the shader sources; a binary rejected by the driver is compiled again and replaced.
+// The folder should exist, nullptr disables the cache.
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetProgramBinaryCache(const char* folder);
+IMGUI_IMPL_API double   ImGui_ImplOpenGL3_GetProgramBuildTime(bool* out_from_cache = nullptr); // CPU time in seconds spent loading or compiling the shader program by the last CreateDeviceObjects().
+
 // Specific OpenGL ES versions
 //#define IMGUI_IMPL_OPENGL_ES2     // Auto-detected on Emscripten
 //#define IMGUI_IMPL_OPENGL_ES3     // Auto-detected on iOS/Android
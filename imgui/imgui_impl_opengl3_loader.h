@@ -166,12 +166,14 @@ typedef khronos_uint8_t GLubyte;
 #define GL_SCISSOR_BOX                    0x0C10
 #define GL_SCISSOR_TEST                   0x0C11
 #define GL_UNPACK_ROW_LENGTH              0x0CF2
+#define GL_UNPACK_ALIGNMENT               0x0CF5
 #define GL_PACK_ALIGNMENT                 0x0D05
 #define GL_TEXTURE_2D                     0x0DE1
 #define GL_UNSIGNED_BYTE                  0x1401
 #define GL_UNSIGNED_SHORT                 0x1403
 #define GL_UNSIGNED_INT                   0x1405
 #define GL_FLOAT                          0x1406
+#define GL_RED                            0x1903
 #define GL_RGBA                           0x1908
 #define GL_FILL                           0x1B02
 #define GL_VENDOR                         0x1F00
@@ -260,17 +262,20 @@ typedef khronos_intptr_t GLintptr;
 #define GL_ARRAY_BUFFER_BINDING           0x8894
 #define GL_ELEMENT_ARRAY_BUFFER_BINDING   0x8895
 #define GL_STREAM_DRAW                    0x88E0
+#define GL_WRITE_ONLY                     0x88B9
 typedef void (APIENTRYP PFNGLBINDBUFFERPROC) (GLenum target, GLuint buffer);
 typedef void (APIENTRYP PFNGLDELETEBUFFERSPROC) (GLsizei n, const GLuint *buffers);
 typedef void (APIENTRYP PFNGLGENBUFFERSPROC) (GLsizei n, GLuint *buffers);
 typedef void (APIENTRYP PFNGLBUFFERDATAPROC) (GLenum target, GLsizeiptr size, const void *data, GLenum usage);
 typedef void (APIENTRYP PFNGLBUFFERSUBDATAPROC) (GLenum target, GLintptr offset, GLsizeiptr size, const void *data);
+typedef GLboolean (APIENTRYP PFNGLUNMAPBUFFERPROC) (GLenum target);
 #ifdef GL_GLEXT_PROTOTYPES
 GLAPI void APIENTRY glBindBuffer (GLenum target, GLuint buffer);
 GLAPI void APIENTRY glDeleteBuffers (GLsizei n, const GLuint *buffers);
 GLAPI void APIENTRY glGenBuffers (GLsizei n, GLuint *buffers);
 GLAPI void APIENTRY glBufferData (GLenum target, GLsizeiptr size, const void *data, GLenum usage);
 GLAPI void APIENTRY glBufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const void *data);
+GLAPI GLboolean APIENTRY glUnmapBuffer (GLenum target);
 #endif
 #endif /* GL_VERSION_1_5 */
 #ifndef GL_VERSION_2_0
@@ -353,17 +358,24 @@ typedef khronos_uint16_t GLhalf;
 #define GL_NUM_EXTENSIONS                 0x821D
 #define GL_FRAMEBUFFER_SRGB               0x8DB9
 #define GL_VERTEX_ARRAY_BINDING           0x85B5
+#define GL_MAP_WRITE_BIT                  0x0002
+#define GL_MAP_INVALIDATE_BUFFER_BIT      0x0008
+#define GL_MAP_FLUSH_EXPLICIT_BIT         0x0010
+#define GL_MAP_UNSYNCHRONIZED_BIT         0x0020
+#define GL_R8                             0x8229
 typedef void (APIENTRYP PFNGLGETBOOLEANI_VPROC) (GLenum target, GLuint index, GLboolean *data);
 typedef void (APIENTRYP PFNGLGETINTEGERI_VPROC) (GLenum target, GLuint index, GLint *data);
 typedef const GLubyte *(APIENTRYP PFNGLGETSTRINGIPROC) (GLenum name, GLuint index);
 typedef void (APIENTRYP PFNGLBINDVERTEXARRAYPROC) (GLuint array);
 typedef void (APIENTRYP PFNGLDELETEVERTEXARRAYSPROC) (GLsizei n, const GLuint *arrays);
 typedef void (APIENTRYP PFNGLGENVERTEXARRAYSPROC) (GLsizei n, GLuint *arrays);
+typedef void *(APIENTRYP PFNGLMAPBUFFERRANGEPROC) (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
 #ifdef GL_GLEXT_PROTOTYPES
 GLAPI const GLubyte *APIENTRY glGetStringi (GLenum name, GLuint index);
 GLAPI void APIENTRY glBindVertexArray (GLuint array);
 GLAPI void APIENTRY glDeleteVertexArrays (GLsizei n, const GLuint *arrays);
 GLAPI void APIENTRY glGenVertexArrays (GLsizei n, GLuint *arrays);
+GLAPI void *APIENTRY glMapBufferRange (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
 #endif
 #endif /* GL_VERSION_3_0 */
 #ifndef GL_VERSION_3_1
@@ -377,27 +389,66 @@ typedef khronos_uint64_t GLuint64;
 typedef khronos_int64_t GLint64;
 #define GL_CONTEXT_COMPATIBILITY_PROFILE_BIT 0x00000002
 #define GL_CONTEXT_PROFILE_MASK           0x9126
+#define GL_SYNC_GPU_COMMANDS_COMPLETE     0x9117
+#define GL_ALREADY_SIGNALED               0x911A
+#define GL_TIMEOUT_EXPIRED                0x911B
+#define GL_CONDITION_SATISFIED            0x911C
+#define GL_WAIT_FAILED                    0x911D
+#define GL_SYNC_FLUSH_COMMANDS_BIT        0x00000001
 typedef void (APIENTRYP PFNGLDRAWELEMENTSBASEVERTEXPROC) (GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex);
+typedef void (APIENTRYP PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC) (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount, const GLint *basevertex);
+typedef GLsync (APIENTRYP PFNGLFENCESYNCPROC) (GLenum condition, GLbitfield flags);
+typedef void (APIENTRYP PFNGLDELETESYNCPROC) (GLsync sync);
+typedef GLenum (APIENTRYP PFNGLCLIENTWAITSYNCPROC) (GLsync sync, GLbitfield flags, GLuint64 timeout);
 typedef void (APIENTRYP PFNGLGETINTEGER64I_VPROC) (GLenum target, GLuint index, GLint64 *data);
 #ifdef GL_GLEXT_PROTOTYPES
 GLAPI void APIENTRY glDrawElementsBaseVertex (GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex);
+GLAPI void APIENTRY glMultiDrawElementsBaseVertex (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount, const GLint *basevertex);
+GLAPI GLsync APIENTRY glFenceSync (GLenum condition, GLbitfield flags);
+GLAPI void APIENTRY glDeleteSync (GLsync sync);
+GLAPI GLenum APIENTRY glClientWaitSync (GLsync sync, GLbitfield flags, GLuint64 timeout);
 #endif
 #endif /* GL_VERSION_3_2 */
 #ifndef GL_VERSION_3_3
 #define GL_VERSION_3_3 1
 #define GL_SAMPLER_BINDING                0x8919
+#define GL_TEXTURE_SWIZZLE_R              0x8E42
+#define GL_TEXTURE_SWIZZLE_G              0x8E43
+#define GL_TEXTURE_SWIZZLE_B              0x8E44
+#define GL_TEXTURE_SWIZZLE_A              0x8E45
 typedef void (APIENTRYP PFNGLBINDSAMPLERPROC) (GLuint unit, GLuint sampler);
 #ifdef GL_GLEXT_PROTOTYPES
 GLAPI void APIENTRY glBindSampler (GLuint unit, GLuint sampler);
 #endif
 #endif /* GL_VERSION_3_3 */
 #ifndef GL_VERSION_4_1
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH          0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS     0x87FE
+typedef void (APIENTRYP PFNGLGETPROGRAMBINARYPROC) (GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+typedef void (APIENTRYP PFNGLPROGRAMBINARYPROC) (GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+typedef void (APIENTRYP PFNGLPROGRAMPARAMETERIPROC) (GLuint program, GLenum pname, GLint value);
 typedef void (APIENTRYP PFNGLGETFLOATI_VPROC) (GLenum target, GLuint index, GLfloat *data);
 typedef void (APIENTRYP PFNGLGETDOUBLEI_VPROC) (GLenum target, GLuint index, GLdouble *data);
+#ifdef GL_GLEXT_PROTOTYPES
+GLAPI void APIENTRY glGetProgramBinary (GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+GLAPI void APIENTRY glProgramBinary (GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+GLAPI void APIENTRY glProgramParameteri (GLuint program, GLenum pname, GLint value);
+#endif
 #endif /* GL_VERSION_4_1 */
 #ifndef GL_VERSION_4_3
 typedef void (APIENTRY  *GLDEBUGPROC)(GLenum source,GLenum type,GLuint id,GLenum severity,GLsizei length,const GLchar *message,const void *userParam);
 #endif /* GL_VERSION_4_3 */
+#ifndef GL_VERSION_4_4
+#define GL_VERSION_4_4 1
+#define GL_MAP_PERSISTENT_BIT             0x0040
+#define GL_MAP_COHERENT_BIT               0x0080
+#define GL_DYNAMIC_STORAGE_BIT            0x0100
+typedef void (APIENTRYP PFNGLBUFFERSTORAGEPROC) (GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+#ifdef GL_GLEXT_PROTOTYPES
+GLAPI void APIENTRY glBufferStorage (GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+#endif
+#endif /* GL_VERSION_4_4 */
 #ifndef GL_VERSION_4_5
 #define GL_CLIP_ORIGIN                    0x935C
 typedef void (APIENTRYP PFNGLGETTRANSFORMFEEDBACKI_VPROC) (GLuint xfb, GLenum pname, GLuint index, GLint *param);
@@ -468,7 +519,7 @@ GL3W_API GL3WglProc imgl3wGetProcAddress(const char *proc);
 
 /* gl3w internal state */
 union GL3WProcs {
-    GL3WglProc ptr[59];
+    GL3WglProc ptr[69];
     struct {
         PFNGLACTIVETEXTUREPROC            ActiveTexture;
         PFNGLATTACHSHADERPROC             AttachShader;
@@ -480,15 +531,18 @@ union GL3WProcs {
         PFNGLBLENDEQUATIONSEPARATEPROC    BlendEquationSeparate;
         PFNGLBLENDFUNCSEPARATEPROC        BlendFuncSeparate;
         PFNGLBUFFERDATAPROC               BufferData;
+        PFNGLBUFFERSTORAGEPROC            BufferStorage;
         PFNGLBUFFERSUBDATAPROC            BufferSubData;
         PFNGLCLEARPROC                    Clear;
         PFNGLCLEARCOLORPROC               ClearColor;
+        PFNGLCLIENTWAITSYNCPROC           ClientWaitSync;
         PFNGLCOMPILESHADERPROC            CompileShader;
         PFNGLCREATEPROGRAMPROC            CreateProgram;
         PFNGLCREATESHADERPROC             CreateShader;
         PFNGLDELETEBUFFERSPROC            DeleteBuffers;
         PFNGLDELETEPROGRAMPROC            DeleteProgram;
         PFNGLDELETESHADERPROC             DeleteShader;
+        PFNGLDELETESYNCPROC               DeleteSync;
         PFNGLDELETETEXTURESPROC           DeleteTextures;
         PFNGLDELETEVERTEXARRAYSPROC       DeleteVertexArrays;
         PFNGLDETACHSHADERPROC             DetachShader;
@@ -498,6 +552,7 @@ union GL3WProcs {
         PFNGLDRAWELEMENTSBASEVERTEXPROC   DrawElementsBaseVertex;
         PFNGLENABLEPROC                   Enable;
         PFNGLENABLEVERTEXATTRIBARRAYPROC  EnableVertexAttribArray;
+        PFNGLFENCESYNCPROC                FenceSync;
         PFNGLFLUSHPROC                    Flush;
         PFNGLGENBUFFERSPROC               GenBuffers;
         PFNGLGENTEXTURESPROC              GenTextures;
@@ -505,6 +560,7 @@ union GL3WProcs {
         PFNGLGETATTRIBLOCATIONPROC        GetAttribLocation;
         PFNGLGETERRORPROC                 GetError;
         PFNGLGETINTEGERVPROC              GetIntegerv;
+        PFNGLGETPROGRAMBINARYPROC         GetProgramBinary;
         PFNGLGETPROGRAMINFOLOGPROC        GetProgramInfoLog;
         PFNGLGETPROGRAMIVPROC             GetProgramiv;
         PFNGLGETSHADERINFOLOGPROC         GetShaderInfoLog;
@@ -517,8 +573,12 @@ union GL3WProcs {
         PFNGLISENABLEDPROC                IsEnabled;
         PFNGLISPROGRAMPROC                IsProgram;
         PFNGLLINKPROGRAMPROC              LinkProgram;
+        PFNGLMAPBUFFERRANGEPROC           MapBufferRange;
+        PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC MultiDrawElementsBaseVertex;
         PFNGLPIXELSTOREIPROC              PixelStorei;
         PFNGLPOLYGONMODEPROC              PolygonMode;
+        PFNGLPROGRAMBINARYPROC            ProgramBinary;
+        PFNGLPROGRAMPARAMETERIPROC        ProgramParameteri;
         PFNGLREADPIXELSPROC               ReadPixels;
         PFNGLSCISSORPROC                  Scissor;
         PFNGLSHADERSOURCEPROC             ShaderSource;
@@ -526,6 +586,7 @@ union GL3WProcs {
         PFNGLTEXPARAMETERIPROC            TexParameteri;
         PFNGLUNIFORM1IPROC                Uniform1i;
         PFNGLUNIFORMMATRIX4FVPROC         UniformMatrix4fv;
+        PFNGLUNMAPBUFFERPROC              UnmapBuffer;
         PFNGLUSEPROGRAMPROC               UseProgram;
         PFNGLVERTEXATTRIBPOINTERPROC      VertexAttribPointer;
         PFNGLVIEWPORTPROC                 Viewport;
@@ -545,15 +606,18 @@ GL3W_API extern union GL3WProcs imgl3wProcs;
 #define glBlendEquationSeparate           imgl3wProcs.gl.BlendEquationSeparate
 #define glBlendFuncSeparate               imgl3wProcs.gl.BlendFuncSeparate
 #define glBufferData                      imgl3wProcs.gl.BufferData
+#define glBufferStorage                   imgl3wProcs.gl.BufferStorage
 #define glBufferSubData                   imgl3wProcs.gl.BufferSubData
 #define glClear                           imgl3wProcs.gl.Clear
 #define glClearColor                      imgl3wProcs.gl.ClearColor
+#define glClientWaitSync                  imgl3wProcs.gl.ClientWaitSync
 #define glCompileShader                   imgl3wProcs.gl.CompileShader
 #define glCreateProgram                   imgl3wProcs.gl.CreateProgram
 #define glCreateShader                    imgl3wProcs.gl.CreateShader
 #define glDeleteBuffers                   imgl3wProcs.gl.DeleteBuffers
 #define glDeleteProgram                   imgl3wProcs.gl.DeleteProgram
 #define glDeleteShader                    imgl3wProcs.gl.DeleteShader
+#define glDeleteSync                      imgl3wProcs.gl.DeleteSync
 #define glDeleteTextures                  imgl3wProcs.gl.DeleteTextures
 #define glDeleteVertexArrays              imgl3wProcs.gl.DeleteVertexArrays
 #define glDetachShader                    imgl3wProcs.gl.DetachShader
@@ -563,6 +627,7 @@ GL3W_API extern union GL3WProcs imgl3wProcs;
 #define glDrawElementsBaseVertex          imgl3wProcs.gl.DrawElementsBaseVertex
 #define glEnable                          imgl3wProcs.gl.Enable
 #define glEnableVertexAttribArray         imgl3wProcs.gl.EnableVertexAttribArray
+#define glFenceSync                       imgl3wProcs.gl.FenceSync
 #define glFlush                           imgl3wProcs.gl.Flush
 #define glGenBuffers                      imgl3wProcs.gl.GenBuffers
 #define glGenTextures                     imgl3wProcs.gl.GenTextures
@@ -570,6 +635,7 @@ GL3W_API extern union GL3WProcs imgl3wProcs;
 #define glGetAttribLocation               imgl3wProcs.gl.GetAttribLocation
 #define glGetError                        imgl3wProcs.gl.GetError
 #define glGetIntegerv                     imgl3wProcs.gl.GetIntegerv
+#define glGetProgramBinary                imgl3wProcs.gl.GetProgramBinary
 #define glGetProgramInfoLog               imgl3wProcs.gl.GetProgramInfoLog
 #define glGetProgramiv                    imgl3wProcs.gl.GetProgramiv
 #define glGetShaderInfoLog                imgl3wProcs.gl.GetShaderInfoLog
@@ -582,8 +648,12 @@ GL3W_API extern union GL3WProcs imgl3wProcs;
 #define glIsEnabled                       imgl3wProcs.gl.IsEnabled
 #define glIsProgram                       imgl3wProcs.gl.IsProgram
 #define glLinkProgram                     imgl3wProcs.gl.LinkProgram
+#define glMapBufferRange                  imgl3wProcs.gl.MapBufferRange
+#define glMultiDrawElementsBaseVertex     imgl3wProcs.gl.MultiDrawElementsBaseVertex
 #define glPixelStorei                     imgl3wProcs.gl.PixelStorei
 #define glPolygonMode                     imgl3wProcs.gl.PolygonMode
+#define glProgramBinary                   imgl3wProcs.gl.ProgramBinary
+#define glProgramParameteri               imgl3wProcs.gl.ProgramParameteri
 #define glReadPixels                      imgl3wProcs.gl.ReadPixels
 #define glScissor                         imgl3wProcs.gl.Scissor
 #define glShaderSource                    imgl3wProcs.gl.ShaderSource
@@ -591,6 +661,7 @@ GL3W_API extern union GL3WProcs imgl3wProcs;
 #define glTexParameteri                   imgl3wProcs.gl.TexParameteri
 #define glUniform1i                       imgl3wProcs.gl.Uniform1i
 #define glUniformMatrix4fv                imgl3wProcs.gl.UniformMatrix4fv
+#define glUnmapBuffer                     imgl3wProcs.gl.UnmapBuffer
 #define glUseProgram                      imgl3wProcs.gl.UseProgram
 #define glVertexAttribPointer             imgl3wProcs.gl.VertexAttribPointer
 #define glViewport                        imgl3wProcs.gl.Viewport
@@ -743,15 +814,18 @@ static const char *proc_names[] = {
     "glBlendEquationSeparate",
     "glBlendFuncSeparate",
     "glBufferData",
+    "glBufferStorage",
     "glBufferSubData",
     "glClear",
     "glClearColor",
+    "glClientWaitSync",
     "glCompileShader",
     "glCreateProgram",
     "glCreateShader",
     "glDeleteBuffers",
     "glDeleteProgram",
     "glDeleteShader",
+    "glDeleteSync",
     "glDeleteTextures",
     "glDeleteVertexArrays",
     "glDetachShader",
@@ -761,6 +835,7 @@ static const char *proc_names[] = {
     "glDrawElementsBaseVertex",
     "glEnable",
     "glEnableVertexAttribArray",
+    "glFenceSync",
     "glFlush",
     "glGenBuffers",
     "glGenTextures",
@@ -768,6 +843,7 @@ static const char *proc_names[] = {
     "glGetAttribLocation",
     "glGetError",
     "glGetIntegerv",
+    "glGetProgramBinary",
     "glGetProgramInfoLog",
     "glGetProgramiv",
     "glGetShaderInfoLog",
@@ -780,8 +856,12 @@ static const char *proc_names[] = {
     "glIsEnabled",
     "glIsProgram",
     "glLinkProgram",
+    "glMapBufferRange",
+    "glMultiDrawElementsBaseVertex",
     "glPixelStorei",
     "glPolygonMode",
+    "glProgramBinary",
+    "glProgramParameteri",
     "glReadPixels",
     "glScissor",
     "glShaderSource",
@@ -789,6 +869,7 @@ static const char *proc_names[] = {
     "glTexParameteri",
     "glUniform1i",
     "glUniformMatrix4fv",
+    "glUnmapBuffer",
     "glUseProgram",
     "glVertexAttribPointer",
     "glViewport",
@@ -22,13 +22,39 @@
 
 #include "GlfwOcctView.h"
 
-int main(int, char**)
+#include <algorithm>
+#include <cstdlib>
+
+int main(int theNbArgs, char** theArgVec)
 {
     GlfwOcctView anApp;
 
     try
     {
-        anApp.run();
+        // --thumbnails <folder> [size] renders part thumbnails without showing the window
+        if (theNbArgs >= 3
+         && TCollection_AsciiString(theArgVec[1]) == "--thumbnails")
+        {
+            long aSize = 128;
+            if (theNbArgs >= 4)
+            {
+                char* anEnd = NULL;
+                aSize = std::strtol(theArgVec[3], &anEnd, 10);
+                if (anEnd == theArgVec[3] || *anEnd != '\0' || aSize <= 0)
+                {
+                    std::cerr << "Invalid thumbnail size '" << theArgVec[3] << "'" << std::endl;
+                    return EXIT_FAILURE;
+                }
+            }
+            if (!anApp.RunThumbnails(theArgVec[2], (int)std::min(aSize, 4096L)))
+            {
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            anApp.run();
+        }
     }
     catch (const std::runtime_error& theError)
     {
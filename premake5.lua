@@ -24,9 +24,16 @@ project "OcctImgui"
     links
     {
         "TKernel", "TKMath", "TKG2d", "TKG3d", "TKGeomBase", "TKGeomAlgo", "TKBRep", "TKTopAlgo", "TKPrim", "TKMesh", "TKService", "TKOpenGl", "TKV3d", 
+        "TKCDF", "TKLCAF", "TKCAF", "TKVCAF", "TKXCAF", "TKMeshVS", "TKHLR", 
         "glfw3"
     }
 
+    -- Background jobs use std::thread.
+    filter "system:not windows"
+      buildoptions { "-pthread" }
+      linkoptions { "-pthread" }
+    filter {}
+
     filter "configurations:Debug"
       defines { "DEBUG" }
       symbols "On"